@@ -0,0 +1,381 @@
+#include "AssetManager.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "TextureAtlas.h"
+#include <cassert>
+#include <filesystem>
+#include <vector>
+
+using namespace KamataEngine;
+
+AssetManager* AssetManager::GetInstance() {
+	static AssetManager instance;
+	return &instance;
+}
+
+Model* AssetManager::AcquireModel(const std::string& name, bool smoothing) {
+
+	// 平滑化の有無で別モデルとして扱う
+	std::string key = MakeKey(AssetType::kModel, name) + (smoothing ? "#smooth" : "");
+
+	std::unique_lock lock(mutex_);
+	Entry* entry = nullptr;
+	if (!BeginAcquire(lock, key, AssetType::kModel, name, entry)) {
+		// 読み込み済み
+		return entry->model;
+	}
+	lock.unlock();
+
+	Model* model = nullptr;
+	MemoryTagScope memoryTag(MemoryTag::kModel);
+	{
+		// エンジンは解析とバッファ生成を分けられないので、読み込み全体を排他する
+		PROFILE_ZONE("Model::CreateFromOBJ");
+		std::scoped_lock loadLock(loadMutex_);
+		model = Model::CreateFromOBJ(name, smoothing);
+	}
+	assert(model);
+
+	// カリング用の境界ボリューム
+	ModelBounds bounds = CalculateModelBounds(model);
+
+	// テクスチャがアトラスに入っていればuvを付け替える
+	uint32_t atlasTextureHandle = TextureAtlas::GetInstance()->ApplyToModel(model, name);
+
+	lock.lock();
+	entry->model = model;
+	entry->bounds = bounds;
+	entry->atlasTextureHandle = atlasTextureHandle;
+	modelKeys_[model] = key;
+	// エンジンのモデルが読んだテクスチャ（既定の white1x1.png を含む）は登録表から解放しない
+	for (const std::unique_ptr<Mesh>& mesh : model->GetMeshes()) {
+		engineTextureHandles_.insert(mesh->GetMaterial()->GetTextureHadle());
+	}
+	FinishLoad(*entry);
+	return model;
+}
+
+void AssetManager::ReleaseModel(Model* model) {
+
+	std::scoped_lock lock(mutex_);
+
+	if (!model) {
+		return;
+	}
+
+	auto it = modelKeys_.find(model);
+	assert(it != modelKeys_.end());
+	Release(it->second);
+}
+
+const ModelBounds* AssetManager::GetBounds(const Model* model) {
+
+	std::scoped_lock lock(mutex_);
+
+	auto it = modelKeys_.find(model);
+	if (it == modelKeys_.end()) {
+		return nullptr;
+	}
+	return &entries_[it->second].bounds;
+}
+
+uint32_t AssetManager::GetTextureHandle(const Model* model) {
+
+	std::scoped_lock lock(mutex_);
+
+	auto it = modelKeys_.find(model);
+	assert(it != modelKeys_.end());
+
+	const Entry& entry = entries_[it->second];
+	if (entry.atlasTextureHandle != TextureAtlas::kInvalidHandle) {
+		return entry.atlasTextureHandle;
+	}
+	return entry.model->GetMeshes().front()->GetMaterial()->GetTextureHadle();
+}
+
+OptimizedModel* AssetManager::AcquireOptimizedModel(const std::string& name, bool smoothing) {
+
+	std::string key = MakeKey(AssetType::kOptimizedModel, name) + (smoothing ? "#smooth" : "");
+
+	std::unique_lock lock(mutex_);
+	Entry* entry = nullptr;
+	if (!BeginAcquire(lock, key, AssetType::kOptimizedModel, name, entry)) {
+		return entry->optimizedModel;
+	}
+	lock.unlock();
+
+	// エンジンの Model は作らず、OBJ を自前で解析した結果だけから作る（解析と最適化はどのロックも持たない）
+	MemoryTagScope memoryTag(MemoryTag::kMesh);
+	OptimizedModel::Source source;
+	{
+		PROFILE_ZONE("OptimizedModel::Prepare");
+		source = OptimizedModel::Prepare(name, smoothing);
+	}
+
+	// カリング用の境界ボリューム
+	ModelBounds bounds = CalculateModelBounds(source.model);
+
+	// テクスチャの参照は最適化済みモデルが持つ
+	// テクスチャがアトラスに入っていれば、量子化する前にuvを付け替えて全マテリアルでページを使う
+	std::vector<uint32_t> textureHandles;
+	uint32_t atlasTextureHandle = TextureAtlas::GetInstance()->ApplyToModelData(source.model, name);
+	for (const ObjFile::MaterialData& material : source.model.materials) {
+		if (atlasTextureHandle != TextureAtlas::kInvalidHandle) {
+			textureHandles.push_back(AddTextureReference(atlasTextureHandle));
+		} else {
+			textureHandles.push_back(AcquireTexture(material.textureFileName));
+		}
+	}
+
+	OptimizedModel* optimizedModel = nullptr;
+	{
+		std::scoped_lock loadLock(loadMutex_);
+		optimizedModel = OptimizedModel::Create(source, textureHandles);
+	}
+
+	lock.lock();
+	entry->optimizedModel = optimizedModel;
+	entry->bounds = bounds;
+	optimizedModelKeys_[optimizedModel] = key;
+	FinishLoad(*entry);
+	return optimizedModel;
+}
+
+const ModelBounds* AssetManager::GetBounds(const OptimizedModel* model) {
+
+	std::scoped_lock lock(mutex_);
+
+	auto it = optimizedModelKeys_.find(model);
+	if (it == optimizedModelKeys_.end()) {
+		return nullptr;
+	}
+	return &entries_[it->second].bounds;
+}
+
+void AssetManager::ReleaseOptimizedModel(OptimizedModel* model) {
+
+	std::scoped_lock lock(mutex_);
+
+	if (!model) {
+		return;
+	}
+
+	auto it = optimizedModelKeys_.find(model);
+	assert(it != optimizedModelKeys_.end());
+	Release(it->second);
+}
+
+uint32_t AssetManager::AcquireTexture(const std::string& fileName) {
+
+	std::string key = MakeKey(AssetType::kTexture, fileName);
+
+	std::unique_lock lock(mutex_);
+	Entry* entry = nullptr;
+	if (!BeginAcquire(lock, key, AssetType::kTexture, fileName, entry)) {
+		return entry->handle;
+	}
+	lock.unlock();
+
+	std::string loadFileName = ResolveTextureFileName(fileName);
+	uint32_t handle = 0;
+	{
+		PROFILE_ZONE("TextureManager::Load");
+		MemoryTagScope memoryTag(MemoryTag::kTexture);
+		std::scoped_lock loadLock(loadMutex_);
+		handle = TextureManager::Load(loadFileName);
+	}
+
+	lock.lock();
+	entry->handle = handle;
+	textureKeys_[handle] = key;
+	FinishLoad(*entry);
+	return handle;
+}
+
+uint32_t AssetManager::AddTextureReference(uint32_t textureHandle) {
+
+	std::scoped_lock lock(mutex_);
+
+	auto it = textureKeys_.find(textureHandle);
+	assert(it != textureKeys_.end());
+	++entries_[it->second].refCount;
+	return textureHandle;
+}
+
+void AssetManager::ReleaseTexture(uint32_t textureHandle) {
+
+	std::scoped_lock lock(mutex_);
+
+	auto it = textureKeys_.find(textureHandle);
+	if (it == textureKeys_.end()) {
+		return;
+	}
+	Release(it->second);
+}
+
+void AssetManager::SetResident(AssetType type, const std::string& name, bool resident) {
+
+	std::scoped_lock lock(mutex_);
+
+	if (resident) {
+		residentKeys_.insert(MakeKey(type, name));
+	} else {
+		residentKeys_.erase(MakeKey(type, name));
+	}
+}
+
+void AssetManager::CollectGarbage() {
+
+	// 解放も転送処理と重ならないようにする
+	std::scoped_lock lock(mutex_, loadMutex_);
+
+	// 参照0かつ非常駐のものだけ解放する
+	// 最適化済みモデルを解放するとテクスチャの参照が0になるので、解放が無くなるまで繰り返す
+	std::vector<std::string> removeKeys;
+	do {
+		removeKeys.clear();
+
+		for (auto& [key, entry] : entries_) {
+			if (entry.refCount > 0 || residentKeys_.contains(MakeKey(entry.type, entry.name))) {
+				continue;
+			}
+
+			removeKeys.push_back(key);
+		}
+
+		for (const std::string& key : removeKeys) {
+			Destroy(entries_[key]);
+			entries_.erase(key);
+		}
+	} while (!removeKeys.empty());
+}
+
+void AssetManager::Finalize() {
+
+	std::scoped_lock lock(mutex_, loadMutex_);
+
+	// 最適化済みモデルはテクスチャの参照を返すので先に解放する
+	for (auto& [key, entry] : entries_) {
+		if (entry.type == AssetType::kOptimizedModel) {
+			Destroy(entry);
+		}
+	}
+	for (auto& [key, entry] : entries_) {
+		if (entry.type != AssetType::kOptimizedModel) {
+			Destroy(entry);
+		}
+	}
+	entries_.clear();
+	residentKeys_.clear();
+}
+
+std::string AssetManager::MakeKey(AssetType type, const std::string& name) {
+
+	switch (type) {
+	case AssetType::kModel:
+		return "model:" + name;
+	case AssetType::kOptimizedModel:
+		return "optimized:" + name;
+	case AssetType::kTexture:
+	default:
+		return "texture:" + name;
+	}
+}
+
+std::string AssetManager::ResolveTextureFileName(const std::string& fileName) {
+
+	namespace fs = std::filesystem;
+
+	// アトラスのページは焼き込まない（前に焼いた .dds が残っていても、隣の画像が混ざるので使わない）
+	if (fileName.starts_with(TextureAtlas::kDirectoryPath)) {
+		return fileName;
+	}
+
+	fs::path source = fs::path(ConvertStringMultiByteToWide("Resources/" + fileName));
+	fs::path baked = source;
+	baked.replace_extension(L".dds");
+
+	// 焼き込み後に元画像が更新されていたら古いDDSは使わない
+	std::error_code error;
+	fs::file_time_type bakedTime = fs::last_write_time(baked, error);
+	if (error) {
+		return fileName;
+	}
+	fs::file_time_type sourceTime = fs::last_write_time(source, error);
+	if (!error && sourceTime > bakedTime) {
+		return fileName;
+	}
+
+	return fileName.substr(0, fileName.find_last_of('.')) + ".dds";
+}
+
+bool AssetManager::BeginAcquire(std::unique_lock<std::mutex>& lock, const std::string& key, AssetType type, const std::string& name, Entry*& entry) {
+
+	auto it = entries_.find(key);
+	if (it != entries_.end()) {
+		// 先に参照を増やしておけば、待っている間に解放されない
+		entry = &it->second;
+		++entry->refCount;
+		loadedCondition_.wait(lock, [entry]() { return !entry->loading; });
+		return false;
+	}
+
+	// 登録だけ先に済ませ、同じキーの取得は読み込みの完了を待たせる
+	// （unordered_map の要素は他の要素の追加で移動しないので、ロックを外しても参照は有効）
+	entry = &entries_[key];
+	entry->type = type;
+	entry->name = name;
+	entry->refCount = 1;
+	entry->loading = true;
+	return true;
+}
+
+void AssetManager::FinishLoad(Entry& entry) {
+
+	entry.loading = false;
+	loadedCondition_.notify_all();
+}
+
+void AssetManager::Release(const std::string& key) {
+
+	auto it = entries_.find(key);
+	assert(it != entries_.end());
+	assert(it->second.refCount > 0);
+
+	// ここでは解放しない（次のシーンで再利用される可能性があるため）
+	--it->second.refCount;
+}
+
+void AssetManager::Destroy(Entry& entry) {
+
+	switch (entry.type) {
+	case AssetType::kModel:
+		modelKeys_.erase(entry.model);
+		delete entry.model;
+		entry.model = nullptr;
+		break;
+
+	case AssetType::kOptimizedModel: {
+		optimizedModelKeys_.erase(entry.optimizedModel);
+
+		// テクスチャの参照を返す（終了処理中は既に消えていることがある）
+		for (uint32_t textureHandle : entry.optimizedModel->GetTextureHandles()) {
+			auto it = textureKeys_.find(textureHandle);
+			if (it != textureKeys_.end()) {
+				Release(it->second);
+			}
+		}
+		delete entry.optimizedModel;
+		entry.optimizedModel = nullptr;
+		break;
+	}
+
+	case AssetType::kTexture:
+		textureKeys_.erase(entry.handle);
+		// TextureManager は同じ名前に同じハンドルを返すので、エンジン側でも使っているものは残す
+		if (!engineTextureHandles_.contains(entry.handle)) {
+			TextureManager::Unload(entry.handle);
+		}
+		break;
+	}
+}
@@ -0,0 +1,227 @@
+#pragma once
+#include "Culling.h"
+#include "KamataEngine.h"
+#include "OptimizedModel.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// アセットの種類
+/// </summary>
+enum class AssetType {
+	kModel,          // 3Dモデル
+	kOptimizedModel, // 最適化済み3Dモデル
+	kTexture,        // テクスチャ
+};
+
+/// <summary>
+/// シーンで使うアセットの一覧（先読み用）
+/// </summary>
+struct AssetManifest {
+	// モデル名と平滑化フラグ
+	std::vector<std::pair<std::string, bool>> models;
+	// 最適化済みモデル名と平滑化フラグ
+	std::vector<std::pair<std::string, bool>> optimizedModels;
+	// テクスチャファイル名
+	std::vector<std::string> textures;
+};
+
+/// <summary>
+/// シーンをまたいで共有するアセット管理
+/// 名前をキーに参照カウントで管理し、同じアセットは一度しか読み込まない
+/// 取得・解放はワーカースレッドからも呼べる
+/// 登録表のロックは検索と登録の間だけ持ち、ファイルの解析は読み込み用ミューテックスの外で行う
+/// </summary>
+class AssetManager {
+public:
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static AssetManager* GetInstance();
+
+	/// <summary>
+	/// モデルの取得（未読み込みならOBJから生成）
+	/// </summary>
+	/// <param name="name">モデル名</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <returns>共有モデル</returns>
+	KamataEngine::Model* AcquireModel(const std::string& name, bool smoothing = false);
+
+	/// <summary>
+	/// モデルの参照を手放す
+	/// </summary>
+	/// <param name="model">AcquireModelで取得したモデル</param>
+	void ReleaseModel(KamataEngine::Model* model);
+
+	/// <summary>
+	/// 頂点キャッシュ最適化済みモデルの取得（テクスチャは共有される）
+	/// 平滑化は自前のコピーに対して行うので、平滑化するモデルはエンジンの Mesh::smoothData_ を通さないこちらで読む
+	/// テクスチャがアトラスに入っていれば、uvを付け替えてアトラスのページで描く
+	/// </summary>
+	/// <param name="name">モデル名</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <returns>共有モデル</returns>
+	OptimizedModel* AcquireOptimizedModel(const std::string& name, bool smoothing = false);
+
+	/// <summary>
+	/// モデルの境界ボリューム（読み込み時に計算済み、ローカル座標）
+	/// 描画のたびに呼ばず、初期化時に取得して保持しておく
+	/// </summary>
+	/// <param name="model">AcquireModelで取得したモデル</param>
+	/// <returns>境界ボリューム</returns>
+	const ModelBounds* GetBounds(const KamataEngine::Model* model);
+
+	/// <summary>
+	/// 最適化済みモデルの境界ボリューム（読み込み時に計算済み、ローカル座標）
+	/// </summary>
+	/// <param name="model">AcquireOptimizedModelで取得したモデル</param>
+	/// <returns>境界ボリューム</returns>
+	const ModelBounds* GetBounds(const OptimizedModel* model);
+
+	/// <summary>
+	/// モデルの描画に使うテクスチャハンドル
+	/// 読み込み時にアトラスへuvを付け替えたモデルはアトラスのページ、それ以外は1つ目のマテリアルのテクスチャ
+	/// 1テクスチャのモデルを Model::Draw(worldTransform, camera, textureHandle) で描画する時に使う
+	/// </summary>
+	/// <param name="model">AcquireModelで取得したモデル</param>
+	/// <returns>テクスチャハンドル</returns>
+	uint32_t GetTextureHandle(const KamataEngine::Model* model);
+
+	/// <summary>
+	/// 最適化済みモデルの参照を手放す
+	/// </summary>
+	/// <param name="model">AcquireOptimizedModelで取得したモデル</param>
+	void ReleaseOptimizedModel(OptimizedModel* model);
+
+	/// <summary>
+	/// テクスチャの取得（未読み込みならTextureManagerで読み込み）
+	/// TextureBaker で焼き込んだ .dds が元画像と同じ場所にあり、元画像より新しければそちらを読む
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <returns>テクスチャハンドル</returns>
+	uint32_t AcquireTexture(const std::string& fileName);
+
+	/// <summary>
+	/// 読み込み済みのテクスチャの参照を1つ増やす（アトラスのページのように、ハンドルしか分からない時に使う）
+	/// </summary>
+	/// <param name="textureHandle">AcquireTextureで取得したテクスチャハンドル</param>
+	/// <returns>同じテクスチャハンドル</returns>
+	uint32_t AddTextureReference(uint32_t textureHandle);
+
+	/// <summary>
+	/// テクスチャの参照を手放す
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	void ReleaseTexture(uint32_t textureHandle);
+
+	/// <summary>
+	/// 常駐指定（参照が0になっても解放しない）
+	/// </summary>
+	/// <param name="type">種類</param>
+	/// <param name="name">名前（モデルはモデル名、それ以外はファイル名）</param>
+	/// <param name="resident">常駐させるか</param>
+	void SetResident(AssetType type, const std::string& name, bool resident = true);
+
+	/// <summary>
+	/// 参照されていないアセットを解放する
+	/// シーン切り替えで新シーンの初期化が終わった後に呼ぶ
+	/// </summary>
+	void CollectGarbage();
+
+	/// <summary>
+	/// 全アセットの解放（終了時）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 読み込み済みのアセット数
+	/// </summary>
+	size_t GetLoadedCount() const { return entries_.size(); }
+
+	/// <summary>
+	/// 読み込み用ミューテックス
+	/// エンジンの転送処理（DirectXCommon::PostDraw）とGPUへの転送が重ならないようにする
+	/// 持つのはエンジンの読み込み関数とバッファ生成の間だけで、OBJの解析や最適化の間は持たない
+	/// </summary>
+	std::mutex& GetLoadMutex() { return loadMutex_; }
+
+private:
+	AssetManager() = default;
+	~AssetManager() = default;
+	AssetManager(const AssetManager&) = delete;
+	AssetManager& operator=(const AssetManager&) = delete;
+
+	// 登録データ
+	struct Entry {
+		AssetType type = AssetType::kModel;
+		std::string name;
+		KamataEngine::Model* model = nullptr;
+		OptimizedModel* optimizedModel = nullptr;
+		uint32_t handle = 0;
+		uint32_t refCount = 0;
+		ModelBounds bounds;
+		uint32_t atlasTextureHandle = UINT32_MAX;
+		// 別スレッドが読み込み中（登録だけ先に済ませてある）
+		bool loading = false;
+	};
+
+	/// <summary>
+	/// 種類と名前からキーを生成
+	/// </summary>
+	static std::string MakeKey(AssetType type, const std::string& name);
+
+	/// <summary>
+	/// 実際に読み込むテクスチャファイル名（焼き込み済みの .dds があればそちら、アトラスのページは常に元の画像）
+	/// </summary>
+	static std::string ResolveTextureFileName(const std::string& fileName);
+
+	/// <summary>
+	/// 登録済みなら参照を増やして読み込みの完了を待ち、未登録なら読み込み中として登録する（ロック済みで呼ぶ）
+	/// </summary>
+	/// <param name="lock">登録表のロック（完了待ちの間は外れる）</param>
+	/// <param name="key">キー</param>
+	/// <param name="type">種類</param>
+	/// <param name="name">名前</param>
+	/// <param name="entry">登録データ</param>
+	/// <returns>新しく登録したか（true なら呼び出し側がロックを外して読み込み、FinishLoad する）</returns>
+	bool BeginAcquire(std::unique_lock<std::mutex>& lock, const std::string& key, AssetType type, const std::string& name, Entry*& entry);
+
+	/// <summary>
+	/// 読み込みの完了を知らせる（ロック済みで呼ぶ）
+	/// </summary>
+	void FinishLoad(Entry& entry);
+
+	/// <summary>
+	/// キーの参照を1つ減らす
+	/// </summary>
+	void Release(const std::string& key);
+
+	/// <summary>
+	/// 実データの解放
+	/// </summary>
+	void Destroy(Entry& entry);
+
+	// 名前 → 登録データ
+	std::unordered_map<std::string, Entry> entries_;
+	// 逆引き（ポインタ/ハンドル → キー）
+	std::unordered_map<const KamataEngine::Model*, std::string> modelKeys_;
+	std::unordered_map<const OptimizedModel*, std::string> optimizedModelKeys_;
+	std::unordered_map<uint32_t, std::string> textureKeys_;
+	// エンジンのモデルも使っているテクスチャハンドル（Unloadしない）
+	std::unordered_set<uint32_t> engineTextureHandles_;
+	// 常駐キー
+	std::unordered_set<std::string> residentKeys_;
+	// 登録表の排他制御
+	std::mutex mutex_;
+	// 読み込み中のエントリの完了待ち
+	std::condition_variable loadedCondition_;
+	// エンジンの読み込みとGPUへの転送の排他制御
+	std::mutex loadMutex_;
+};
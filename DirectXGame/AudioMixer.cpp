@@ -0,0 +1,621 @@
+#define NOMINMAX
+#include "AudioMixer.h"
+#include "ImaAdpcm.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+namespace {
+
+// 32.32 固定小数点の 1.0
+constexpr uint64_t kFixedOne = uint64_t(1) << 32;
+// 補間の割合は下位32bitの上24bitを使う（float の仮数に収める）
+constexpr float kFractionScale = 1.0f / 16777216.0f;
+
+// 出力WAVのヘッダの大きさ
+constexpr uint32_t kWaveHeaderSize = 44;
+
+float Fraction(uint64_t position) { return static_cast<float>(static_cast<uint32_t>(position) >> 8) * kFractionScale; }
+
+void Write16(std::ofstream& file, uint16_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+void Write32(std::ofstream& file, uint32_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+} // namespace
+
+bool AudioMixer::LoadWave(const std::string& filePath, Sound& sound) {
+
+	std::ifstream file(filePath, std::ios_base::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	WaveFile::Header header;
+	if (!WaveFile::ReadHeader(file, header)) {
+		return false;
+	}
+
+	std::vector<uint8_t> data(header.dataSize);
+	file.read(reinterpret_cast<char*>(data.data()), header.dataSize);
+	// data チャンクの大きさよりファイルが短い時は読めた分だけ使う
+	header.dataSize = static_cast<uint32_t>(file.gcount());
+
+	return ConvertToFloat(header, data.data(), sound);
+}
+
+bool AudioMixer::ConvertToFloat(const WaveFile::Header& header, const uint8_t* data, Sound& sound) {
+
+	const WaveFile::Format& format = header.GetFormat();
+	const uint16_t formatTag = header.GetSampleFormatTag();
+	const uint32_t bytesPerSample = format.bitsPerSample / 8;
+
+	if (format.channels < 1 || format.channels > kOutputChannels || format.blockAlign != format.channels * bytesPerSample) {
+		return false;
+	}
+	if (!(formatTag == WaveFile::kFormatPcm && bytesPerSample >= 1 && bytesPerSample <= 4) && !(formatTag == WaveFile::kFormatFloat && bytesPerSample == 4)) {
+		return false;
+	}
+
+	sound.sampleRate = format.samplesPerSec;
+	sound.channels = format.channels;
+	sound.frameCount = header.dataSize / format.blockAlign;
+
+	const size_t count = size_t(sound.frameCount) * sound.channels;
+	sound.samples.resize(count);
+	float* destination = sound.samples.data();
+
+	if (formatTag == WaveFile::kFormatFloat) {
+		std::memcpy(destination, data, count * sizeof(float));
+		return true;
+	}
+
+	size_t i = 0;
+	switch (bytesPerSample) {
+	case 1:
+		for (; i < count; ++i) {
+			destination[i] = (static_cast<float>(data[i]) - 128.0f) * (1.0f / 128.0f);
+		}
+		break;
+
+	case 2: {
+		// 8サンプルずつ符号拡張して float にする
+		const __m128i* source = reinterpret_cast<const __m128i*>(data);
+		const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+		for (; i + 8 <= count; i += 8) {
+			const __m128i value = _mm_loadu_si128(source + i / 8);
+			const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+			const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+			_mm_storeu_ps(destination + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+			_mm_storeu_ps(destination + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+		}
+		for (; i < count; ++i) {
+			int16_t value = 0;
+			std::memcpy(&value, data + i * 2, sizeof(value));
+			destination[i] = static_cast<float>(value) * (1.0f / 32768.0f);
+		}
+		break;
+	}
+
+	case 3:
+		for (; i < count; ++i) {
+			const uint8_t* sample = data + i * 3;
+			const int32_t value = static_cast<int32_t>(uint32_t(sample[0]) << 8 | uint32_t(sample[1]) << 16 | uint32_t(sample[2]) << 24) >> 8;
+			destination[i] = static_cast<float>(value) * (1.0f / 8388608.0f);
+		}
+		break;
+
+	case 4:
+		for (; i < count; ++i) {
+			int32_t value = 0;
+			std::memcpy(&value, data + i * 4, sizeof(value));
+			destination[i] = static_cast<float>(value) * (1.0f / 2147483648.0f);
+		}
+		break;
+
+	default:
+		return false;
+	}
+	return true;
+}
+
+void AudioMixer::ConvertToInt16(const float* source, int16_t* destination, size_t count) {
+
+	// 先に [-1, 1] に収めてから変換し、packs で飽和させる
+	const __m128 scale = _mm_set1_ps(32767.0f);
+	const __m128 minimum = _mm_set1_ps(-1.0f);
+	const __m128 maximum = _mm_set1_ps(1.0f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m128 low = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), minimum), maximum), scale);
+		const __m128 high = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + 4), minimum), maximum), scale);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high)));
+	}
+	for (; i < count; ++i) {
+		destination[i] = static_cast<int16_t>(std::lround(std::clamp(source[i], -1.0f, 1.0f) * 32767.0f));
+	}
+}
+
+AudioMixer::AudioMixer(uint32_t sampleRate) : sampleRate_(sampleRate) {
+
+	assert(sampleRate_ > 0);
+
+	// 全ての枠を空きリストにつなぐ
+	for (uint32_t i = 0; i < kMaxVoices; ++i) {
+		slots_[i].nextFree.store(i + 1 < kMaxVoices ? i + 1 : kEndOfList, std::memory_order_relaxed);
+	}
+	freeHead_.store(0, std::memory_order_relaxed);
+
+	activeVoices_.reserve(kMaxVoices);
+	decodeBuffer_.resize(size_t(kDecodeFrames) * kOutputChannels);
+}
+
+uint32_t AudioMixer::Play(const Sound* sound, float volume, float pitch, bool loopFlag) {
+
+	if (!sound || sound->frameCount == 0) {
+		return kInvalidVoice;
+	}
+
+	const uint32_t index = PopFreeSlot();
+	if (index == kEndOfList) {
+		return kInvalidVoice;
+	}
+
+	const uint32_t handle = MakeHandle(index, slots_[index].generation.load(std::memory_order_acquire));
+
+	Command command;
+	command.type = CommandType::kPlay;
+	command.voice = handle;
+	command.sound = sound;
+	command.volume = volume;
+	command.pitch = pitch;
+	command.loopFlag = loopFlag;
+	if (!commands_.Push(command)) {
+		PushFreeSlot(index);
+		return kInvalidVoice;
+	}
+	return handle;
+}
+
+void AudioMixer::Stop(uint32_t voice) {
+
+	Command command;
+	command.type = CommandType::kStop;
+	command.voice = voice;
+	commands_.Push(command);
+}
+
+void AudioMixer::StopAll() {
+
+	Command command;
+	command.type = CommandType::kStopAll;
+	commands_.Push(command);
+}
+
+bool AudioMixer::IsPlaying(uint32_t voice) const {
+
+	// 鳴り終わると世代が進むので、ハンドルの世代と一致している間は再生中
+	return voice != kInvalidVoice && GetIndex(voice) < kMaxVoices && slots_[GetIndex(voice)].generation.load(std::memory_order_acquire) == GetGeneration(voice);
+}
+
+void AudioMixer::SetVolume(uint32_t voice, float volume) {
+
+	Command command;
+	command.type = CommandType::kSetVolume;
+	command.voice = voice;
+	command.volume = volume;
+	commands_.Push(command);
+}
+
+void AudioMixer::SetPitch(uint32_t voice, float pitch) {
+
+	Command command;
+	command.type = CommandType::kSetPitch;
+	command.voice = voice;
+	command.pitch = pitch;
+	commands_.Push(command);
+}
+
+void AudioMixer::Mix(float* output, uint32_t frameCount) {
+
+	ExecuteCommands();
+
+	std::fill_n(output, size_t(frameCount) * kOutputChannels, 0.0f);
+
+	// 解放すると末尾が詰められるので後ろから回す
+	for (size_t i = activeVoices_.size(); i-- > 0;) {
+		const uint32_t index = activeVoices_[i];
+		if (!MixVoice(voices_[index], output, frameCount)) {
+			Release(index);
+		}
+	}
+
+	activeVoiceCount_.store(static_cast<uint32_t>(activeVoices_.size()), std::memory_order_relaxed);
+}
+
+void AudioMixer::Render(AudioSink* sink, uint32_t frameCount, uint32_t blockFrames) {
+
+	std::vector<float> block(size_t(blockFrames) * kOutputChannels);
+	for (uint32_t rendered = 0; rendered < frameCount; rendered += blockFrames) {
+		uint32_t count = std::min(blockFrames, frameCount - rendered);
+		Mix(block.data(), count);
+		sink->Write(block.data(), count);
+	}
+}
+
+uint32_t AudioMixer::PopFreeSlot() {
+
+	uint64_t head = freeHead_.load(std::memory_order_acquire);
+	while (true) {
+		const uint32_t index = static_cast<uint32_t>(head);
+		if (index == kEndOfList) {
+			return kEndOfList;
+		}
+		// 通し番号を進めて、間に取られて戻された時（ABA）の CAS を失敗させる
+		const uint32_t next = slots_[index].nextFree.load(std::memory_order_relaxed);
+		const uint64_t newHead = ((head >> 32) + 1) << 32 | next;
+		if (freeHead_.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			return index;
+		}
+	}
+}
+
+void AudioMixer::PushFreeSlot(uint32_t index) {
+
+	uint64_t head = freeHead_.load(std::memory_order_relaxed);
+	while (true) {
+		slots_[index].nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+		const uint64_t newHead = ((head >> 32) + 1) << 32 | index;
+		if (freeHead_.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed)) {
+			return;
+		}
+	}
+}
+
+void AudioMixer::ExecuteCommands() {
+
+	Command command;
+	while (commands_.Pop(command)) {
+		switch (command.type) {
+		case CommandType::kPlay: {
+			const uint32_t index = GetIndex(command.voice);
+			Voice& voice = voices_[index];
+			assert(!voice.active);
+			const float pitch = std::clamp(command.pitch, kMinPitch, kMaxPitch);
+			voice.sound = command.sound;
+			voice.position = 0;
+			voice.step = CalculateStep(command.sound, pitch);
+			voice.volume = command.volume;
+			voice.loopFlag = command.loopFlag;
+			voice.active = true;
+			voice.activeIndex = static_cast<uint32_t>(activeVoices_.size());
+			activeVoices_.push_back(index);
+			if (voice.sound->encoding == Encoding::kImaAdpcm) {
+				voice.decoder.Reset(voice.sound->blocks, voice.sound->channels, voice.sound->blockAlign);
+			}
+			break;
+		}
+
+		case CommandType::kStop: {
+			const uint32_t index = FindActiveVoice(command.voice);
+			if (index != kEndOfList) {
+				Release(index);
+			}
+			break;
+		}
+
+		case CommandType::kStopAll:
+			while (!activeVoices_.empty()) {
+				Release(activeVoices_.back());
+			}
+			break;
+
+		case CommandType::kSetVolume: {
+			const uint32_t index = FindActiveVoice(command.voice);
+			if (index != kEndOfList) {
+				voices_[index].volume = command.volume;
+			}
+			break;
+		}
+
+		case CommandType::kSetPitch: {
+			const uint32_t index = FindActiveVoice(command.voice);
+			if (index != kEndOfList) {
+				voices_[index].step = CalculateStep(voices_[index].sound, std::clamp(command.pitch, kMinPitch, kMaxPitch));
+			}
+			break;
+		}
+		}
+	}
+}
+
+uint32_t AudioMixer::FindActiveVoice(uint32_t handle) const {
+
+	const uint32_t index = GetIndex(handle);
+	if (handle == kInvalidVoice || index >= kMaxVoices) {
+		return kEndOfList;
+	}
+	if (!voices_[index].active || slots_[index].generation.load(std::memory_order_relaxed) != GetGeneration(handle)) {
+		return kEndOfList;
+	}
+	return index;
+}
+
+void AudioMixer::Release(uint32_t index) {
+
+	Voice& voice = voices_[index];
+	assert(voice.active);
+	voice.active = false;
+
+	// 末尾と入れ替えて詰める
+	const uint32_t last = activeVoices_.back();
+	activeVoices_[voice.activeIndex] = last;
+	voices_[last].activeIndex = voice.activeIndex;
+	activeVoices_.pop_back();
+
+	// 世代を進めて古いハンドルを無効にしてから枠を返す
+	Slot& slot = slots_[index];
+	slot.generation.store((slot.generation.load(std::memory_order_relaxed) + 1) % kGenerationCount, std::memory_order_release);
+	PushFreeSlot(index);
+}
+
+uint64_t AudioMixer::CalculateStep(const Sound* sound, float pitch) const {
+
+	const double ratio = static_cast<double>(pitch) * sound->sampleRate / sampleRate_;
+	return std::max<uint64_t>(1, static_cast<uint64_t>(ratio * static_cast<double>(kFixedOne)));
+}
+
+bool AudioMixer::MixVoice(Voice& voice, float* output, uint32_t frameCount) {
+
+	const Sound* sound = voice.sound;
+	if (sound->encoding == Encoding::kImaAdpcm) {
+		return MixAdpcm(voice, output, frameCount);
+	}
+
+	SampleView view;
+	view.samples = sound->samples.data();
+	view.channels = sound->channels;
+	view.frameCount = sound->frameCount;
+	return MixSamples(view, voice, output, frameCount);
+}
+
+bool AudioMixer::MixSamples(const SampleView& view, Voice& voice, float* output, uint32_t frameCount) {
+
+	const float* samples = view.samples;
+	const uint64_t end = uint64_t(view.frameCount) << 32;
+
+	uint32_t mixed = 0;
+	while (mixed < frameCount) {
+
+		// 大半のフレームは SIMD で処理する
+		if (view.channels == 1) {
+			mixed += MixVoiceSimd<1>(view, voice, output + mixed * kOutputChannels, frameCount - mixed);
+		} else {
+			mixed += MixVoiceSimd<2>(view, voice, output + mixed * kOutputChannels, frameCount - mixed);
+		}
+		if (mixed >= frameCount) {
+			break;
+		}
+
+		// 末尾の付近だけ1フレームずつ（ループなら先頭と補間する）
+		if (voice.position >= end) {
+			if (!voice.loopFlag) {
+				return false;
+			}
+			voice.position %= end;
+		}
+
+		const uint32_t index = static_cast<uint32_t>(voice.position >> 32);
+		const uint32_t nextIndex = index + 1 < view.frameCount ? index + 1 : (voice.loopFlag ? 0 : index);
+		const float fraction = Fraction(voice.position);
+
+		float* destination = output + mixed * kOutputChannels;
+		if (view.channels == 1) {
+			const float sample = (samples[index] + (samples[nextIndex] - samples[index]) * fraction) * voice.volume;
+			destination[0] += sample;
+			destination[1] += sample;
+		} else {
+			for (uint32_t channel = 0; channel < kOutputChannels; ++channel) {
+				const float current = samples[index * 2 + channel];
+				const float next = samples[nextIndex * 2 + channel];
+				destination[channel] += (current + (next - current) * fraction) * voice.volume;
+			}
+		}
+
+		voice.position += voice.step;
+		++mixed;
+	}
+
+	// ちょうど末尾まで鳴らした時はここで終える
+	return voice.loopFlag || voice.position < end;
+}
+
+bool AudioMixer::MixAdpcm(Voice& voice, float* output, uint32_t frameCount) {
+
+	const Sound* sound = voice.sound;
+	const uint32_t channels = sound->channels;
+	const uint64_t end = uint64_t(sound->frameCount) << 32;
+	// 補間の相手の1フレームと端数の分を除いて、復号用のバッファに収まる出力フレーム数
+	const uint64_t fitting = (uint64_t(kDecodeFrames - 3) << 32) / voice.step + 1;
+
+	uint32_t mixed = 0;
+	while (mixed < frameCount) {
+
+		if (voice.position >= end) {
+			if (!voice.loopFlag) {
+				return false;
+			}
+			voice.position %= end;
+		}
+
+		// 末尾を越えない範囲で、このまとまりで使うフレームだけを復号する
+		const uint64_t untilEnd = (end - voice.position + voice.step - 1) / voice.step;
+		const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>({frameCount - mixed, untilEnd, fitting}));
+		const uint32_t first = static_cast<uint32_t>(voice.position >> 32);
+		const uint32_t last = static_cast<uint32_t>((voice.position + (count - 1) * voice.step) >> 32);
+
+		// 補間の相手として last の次のフレームまで並べる
+		// 前のまとまりの続きなので、復号器は大抵そのまま先へ読み進めるだけで済む
+		float* decoded = decodeBuffer_.data();
+		const uint32_t viewFrameCount = last - first + 2;
+		const bool hasNext = last + 1 < sound->frameCount;
+		voice.decoder.Seek(first);
+		voice.decoder.Read(decoded, hasNext ? viewFrameCount : viewFrameCount - 1);
+		if (!hasNext) {
+			// 末尾の次はループなら先頭、そうでなければ最後のフレームをもう一度
+			float* tail = decoded + size_t(viewFrameCount - 1) * channels;
+			if (voice.loopFlag) {
+				ImaAdpcm::Decode(sound->blocks, channels, sound->blockAlign, 0, 1, tail);
+			} else {
+				std::copy_n(tail - channels, channels, tail);
+			}
+		}
+
+		// 復号した範囲を先頭とする位置で float の経路に任せる
+		SampleView view;
+		view.samples = decoded;
+		view.channels = channels;
+		view.frameCount = viewFrameCount;
+
+		const uint64_t origin = uint64_t(first) << 32;
+		voice.position -= origin;
+		MixSamples(view, voice, output + mixed * kOutputChannels, count);
+		voice.position += origin;
+
+		mixed += count;
+	}
+
+	return voice.loopFlag || voice.position < end;
+}
+
+template<uint32_t kChannels>
+uint32_t AudioMixer::MixVoiceSimd(const SampleView& view, Voice& voice, float* output, uint32_t frameCount) {
+
+	const float* samples = view.samples;
+
+	// index + 1 が最後のフレーム以下に収まる位置まで
+	const uint64_t limit = uint64_t(view.frameCount - 1) << 32;
+	if (voice.position >= limit) {
+		return 0;
+	}
+	const uint64_t available = (limit - voice.position + voice.step - 1) / voice.step;
+	const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(available, frameCount)) & ~3u;
+
+	const __m128 volume = _mm_set1_ps(voice.volume);
+	uint64_t position = voice.position;
+
+	// ピッチ1・同じレートで位置が整数なら補間せずそのまま読む
+	const bool direct = voice.step == kFixedOne && static_cast<uint32_t>(position) == 0;
+
+	for (uint32_t i = 0; i < count; i += 4) {
+		float* destination = output + i * kOutputChannels;
+
+		if (direct) {
+			const float* source = samples + (position >> 32) * kChannels;
+			if constexpr (kChannels == 1) {
+				const __m128 sample = _mm_mul_ps(_mm_loadu_ps(source), volume);
+				_mm_storeu_ps(destination, _mm_add_ps(_mm_loadu_ps(destination), _mm_unpacklo_ps(sample, sample)));
+				_mm_storeu_ps(destination + 4, _mm_add_ps(_mm_loadu_ps(destination + 4), _mm_unpackhi_ps(sample, sample)));
+			} else {
+				_mm_storeu_ps(destination, _mm_add_ps(_mm_loadu_ps(destination), _mm_mul_ps(_mm_loadu_ps(source), volume)));
+				_mm_storeu_ps(destination + 4, _mm_add_ps(_mm_loadu_ps(destination + 4), _mm_mul_ps(_mm_loadu_ps(source + 4), volume)));
+			}
+			position += kFixedOne * 4;
+			continue;
+		}
+
+		// 4フレーム分の前後のサンプルと補間の割合を集めてからまとめて補間する
+		alignas(16) float current[kChannels][4];
+		alignas(16) float next[kChannels][4];
+		alignas(16) float fraction[4];
+		for (uint32_t lane = 0; lane < 4; ++lane) {
+			const float* source = samples + (position >> 32) * kChannels;
+			for (uint32_t channel = 0; channel < kChannels; ++channel) {
+				current[channel][lane] = source[channel];
+				next[channel][lane] = source[kChannels + channel];
+			}
+			fraction[lane] = Fraction(position);
+			position += voice.step;
+		}
+
+		const __m128 t = _mm_load_ps(fraction);
+		__m128 result[kChannels];
+		for (uint32_t channel = 0; channel < kChannels; ++channel) {
+			const __m128 a = _mm_load_ps(current[channel]);
+			const __m128 b = _mm_load_ps(next[channel]);
+			result[channel] = _mm_mul_ps(_mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)), volume);
+		}
+
+		// モノラルは左右に同じ値、ステレオは左右を交互に並べる
+		const __m128 left = result[0];
+		const __m128 right = result[kChannels - 1];
+		_mm_storeu_ps(destination, _mm_add_ps(_mm_loadu_ps(destination), _mm_unpacklo_ps(left, right)));
+		_mm_storeu_ps(destination + 4, _mm_add_ps(_mm_loadu_ps(destination + 4), _mm_unpackhi_ps(left, right)));
+	}
+
+	voice.position = position;
+	return count;
+}
+
+void NullAudioSink::Write(const float* samples, uint32_t frameCount) {
+
+	frameCount_ += frameCount;
+	for (size_t i = 0; i < size_t(frameCount) * AudioMixer::kOutputChannels; ++i) {
+		peak_ = std::max(peak_, std::abs(samples[i]));
+	}
+}
+
+WaveFileAudioSink::~WaveFileAudioSink() { Close(); }
+
+bool WaveFileAudioSink::Open(const std::string& filePath, uint32_t sampleRate) {
+
+	Close();
+
+	file_.open(filePath, std::ios_base::binary | std::ios_base::trunc);
+	if (!file_.is_open()) {
+		return false;
+	}
+	dataSize_ = 0;
+
+	// 大きさは閉じる時に書き直す
+	const uint16_t blockAlign = AudioMixer::kOutputChannels * sizeof(int16_t);
+	file_.write("RIFF", 4);
+	Write32(file_, 0);
+	file_.write("WAVE", 4);
+	file_.write("fmt ", 4);
+	Write32(file_, 16);
+	Write16(file_, WaveFile::kFormatPcm);
+	Write16(file_, AudioMixer::kOutputChannels);
+	Write32(file_, sampleRate);
+	Write32(file_, sampleRate * blockAlign);
+	Write16(file_, blockAlign);
+	Write16(file_, 16);
+	file_.write("data", 4);
+	Write32(file_, 0);
+	return true;
+}
+
+void WaveFileAudioSink::Close() {
+
+	if (!file_.is_open()) {
+		return;
+	}
+
+	file_.seekp(4);
+	Write32(file_, kWaveHeaderSize - 8 + dataSize_);
+	file_.seekp(kWaveHeaderSize - 4);
+	Write32(file_, dataSize_);
+	file_.close();
+}
+
+void WaveFileAudioSink::Write(const float* samples, uint32_t frameCount) {
+
+	const size_t count = size_t(frameCount) * AudioMixer::kOutputChannels;
+	converted_.resize(count);
+	AudioMixer::ConvertToInt16(samples, converted_.data(), count);
+
+	file_.write(reinterpret_cast<const char*>(converted_.data()), count * sizeof(int16_t));
+	dataSize_ += static_cast<uint32_t>(count * sizeof(int16_t));
+}
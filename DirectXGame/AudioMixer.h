@@ -0,0 +1,352 @@
+#pragma once
+#include "ImaAdpcm.h"
+#include "MpscQueue.h"
+#include "WaveFile.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class AudioSink;
+
+/// <summary>
+/// ソフトウェアミキサー（プラットフォームに依存しない）
+/// 各ボイスを音量・ピッチ付きでリサンプリングし、1本の float ステレオ出力に足し込む
+/// XAudio2 にはミックス済みの1本だけを渡すので、効果音が何本鳴っても出力のボイスは1つで済む
+/// 再生・停止などはロックフリーのキューでミックスするスレッドに渡し、ゲームスレッドは待たない・確保しない
+/// ボイスは固定数のプールから取り、世代付きのハンドルで古いハンドルからの操作を無視する
+/// </summary>
+class AudioMixer {
+public:
+	// 出力のチャンネル数（インターリーブのステレオ）
+	static constexpr uint32_t kOutputChannels = 2;
+	// 同時に鳴らせるボイス数
+	static constexpr uint32_t kMaxVoices = 256;
+	// 無効なボイス
+	static constexpr uint32_t kInvalidVoice = UINT32_MAX;
+	// ミックスの1回の間に溜められる操作の数
+	static constexpr uint32_t kCommandCapacity = 1024;
+	// ピッチの範囲
+	static constexpr float kMinPitch = 1.0f / 8.0f;
+	static constexpr float kMaxPitch = 8.0f;
+
+	// ADPCM を1回に復号するフレーム数の上限
+	static constexpr uint32_t kDecodeFrames = 4096;
+
+	/// <summary>
+	/// 音のデータの持ち方
+	/// </summary>
+	enum class Encoding : uint8_t {
+		// 読み込み時に float に変換したもの
+		kFloat,
+		// IMA-ADPCM のまま持ち、ミックスの時に必要な分だけ復号する
+		kImaAdpcm,
+	};
+
+	/// <summary>
+	/// 鳴らす音
+	/// </summary>
+	struct Sound {
+		uint32_t sampleRate = 0;
+		// 1 か 2
+		uint32_t channels = 0;
+		uint32_t frameCount = 0;
+		Encoding encoding = Encoding::kFloat;
+		// kFloat: インターリーブの float サンプル
+		std::vector<float> samples;
+		// kImaAdpcm: ブロックを並べたもの（サウンドバンクなど持ち主のメモリを指す）
+		const uint8_t* blocks = nullptr;
+		uint32_t blockAlign = 0;
+	};
+
+	/// <summary>
+	/// WAVファイルを読み込んで float に変換する
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="sound">読み込み先</param>
+	/// <returns>対応している形式で読めたか</returns>
+	static bool LoadWave(const std::string& filePath, Sound& sound);
+
+	/// <summary>
+	/// PCM（8/16/24/32bit 整数、32bit float）を float に変換する
+	/// </summary>
+	/// <param name="header">WAVのヘッダ</param>
+	/// <param name="data">data チャンクの中身</param>
+	/// <param name="sound">変換先</param>
+	/// <returns>対応している形式か</returns>
+	static bool ConvertToFloat(const WaveFile::Header& header, const uint8_t* data, Sound& sound);
+
+	/// <summary>
+	/// float を 16bit 整数に変換する（範囲外は飽和）
+	/// </summary>
+	static void ConvertToInt16(const float* source, int16_t* destination, size_t count);
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="sampleRate">出力のサンプリングレート</param>
+	explicit AudioMixer(uint32_t sampleRate = 48000);
+
+	/// <summary>
+	/// 再生
+	/// </summary>
+	/// <param name="sound">鳴らす音（鳴っている間は解放しないこと）</param>
+	/// <param name="volume">ボリューム</param>
+	/// <param name="pitch">ピッチ（1で元の速さ）</param>
+	/// <param name="loopFlag">ループ再生フラグ</param>
+	/// <returns>ボイスのハンドル（空きが無いか操作が溜まりすぎていればkInvalidVoice）</returns>
+	uint32_t Play(const Sound* sound, float volume = 1.0f, float pitch = 1.0f, bool loopFlag = false);
+
+	/// <summary>
+	/// 停止（鳴り終わった・古いハンドルなら何もしない）
+	/// </summary>
+	void Stop(uint32_t voice);
+
+	/// <summary>
+	/// 全て停止
+	/// </summary>
+	void StopAll();
+
+	/// <summary>
+	/// 再生中か（Play 直後、まだミックスされていなくても true）
+	/// </summary>
+	bool IsPlaying(uint32_t voice) const;
+
+	/// <summary>
+	/// 音量設定
+	/// </summary>
+	void SetVolume(uint32_t voice, float volume);
+
+	/// <summary>
+	/// ピッチ設定
+	/// </summary>
+	void SetPitch(uint32_t voice, float pitch);
+
+	/// <summary>
+	/// ミックス（溜まった操作を反映してから足し込む。呼ぶのは1つのスレッドだけ）
+	/// </summary>
+	/// <param name="output">出力先（frameCount × kOutputChannels 個の float、上書きする）</param>
+	/// <param name="frameCount">フレーム数</param>
+	void Mix(float* output, uint32_t frameCount);
+
+	/// <summary>
+	/// ミックスして出力先に書き出す（ヘッドレスでの確認・計測用）
+	/// </summary>
+	/// <param name="sink">出力先</param>
+	/// <param name="frameCount">書き出すフレーム数</param>
+	/// <param name="blockFrames">1回にミックスするフレーム数</param>
+	void Render(AudioSink* sink, uint32_t frameCount, uint32_t blockFrames = 512);
+
+	/// <summary>
+	/// 鳴っているボイス数（直近のミックスの時点）
+	/// </summary>
+	uint32_t GetActiveVoiceCount() const { return activeVoiceCount_.load(std::memory_order_relaxed); }
+
+	/// <summary>
+	/// 鳴っているボイスも溜まった操作も無いか（ミックスするスレッドだけが呼ぶ）
+	/// </summary>
+	bool IsIdle() const { return activeVoices_.empty() && commands_.IsEmpty(); }
+
+	/// <summary>
+	/// 出力のサンプリングレート
+	/// </summary>
+	uint32_t GetSampleRate() const { return sampleRate_; }
+
+private:
+	// ハンドルのうちボイスの番号に使うビット数（残りが世代）
+	static constexpr uint32_t kIndexBits = 8;
+	static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+	// 世代は kInvalidVoice と重ならないように1つ手前で折り返す
+	static constexpr uint32_t kGenerationCount = (UINT32_MAX >> kIndexBits);
+	// 空きリストの終端
+	static constexpr uint32_t kEndOfList = UINT32_MAX;
+
+	static_assert(kMaxVoices <= (1u << kIndexBits), "kMaxVoices must fit in kIndexBits");
+
+	// ミックスするスレッドへの操作
+	enum class CommandType : uint8_t {
+		kPlay,
+		kStop,
+		kStopAll,
+		kSetVolume,
+		kSetPitch,
+	};
+
+	struct Command {
+		CommandType type = CommandType::kStop;
+		bool loopFlag = false;
+		uint32_t voice = kInvalidVoice;
+		const Sound* sound = nullptr;
+		float volume = 1.0f;
+		float pitch = 1.0f;
+	};
+
+	/// <summary>
+	/// ボイス（ミックスするスレッドだけが触る）
+	/// 再生位置は 32.32 の固定小数点（上位が元の音のフレーム、下位が補間の割合）
+	/// </summary>
+	struct Voice {
+		const Sound* sound = nullptr;
+		uint64_t position = 0;
+		uint64_t step = 0;
+		float volume = 1.0f;
+		bool loopFlag = false;
+		bool active = false;
+		// activeVoices_ の中の位置
+		uint32_t activeIndex = 0;
+		// ADPCM の音の続きを読む復号器
+		ImaAdpcm::Decoder decoder;
+	};
+
+	/// <summary>
+	/// ボイスの枠（どのスレッドからも触る部分）
+	/// </summary>
+	struct Slot {
+		// 今のハンドルの世代（解放のたびに進める）
+		std::atomic<uint32_t> generation = 0;
+		// 空きリストの次
+		std::atomic<uint32_t> nextFree = kEndOfList;
+	};
+
+	static uint32_t MakeHandle(uint32_t index, uint32_t generation) { return generation << kIndexBits | index; }
+	static uint32_t GetIndex(uint32_t handle) { return handle & kIndexMask; }
+	static uint32_t GetGeneration(uint32_t handle) { return handle >> kIndexBits; }
+
+	/// <summary>
+	/// 空きリストから枠を取る（ロックフリー）
+	/// </summary>
+	/// <returns>枠の番号（空きが無ければkEndOfList）</returns>
+	uint32_t PopFreeSlot();
+
+	/// <summary>
+	/// 空きリストに枠を返す（ロックフリー）
+	/// </summary>
+	void PushFreeSlot(uint32_t index);
+
+	/// <summary>
+	/// 溜まった操作を反映する
+	/// </summary>
+	void ExecuteCommands();
+
+	/// <summary>
+	/// ハンドルが今の世代のボイスを指していれば番号を返す
+	/// </summary>
+	uint32_t FindActiveVoice(uint32_t handle) const;
+
+	/// <summary>
+	/// 鳴り終わった・止めたボイスを枠ごと解放する
+	/// </summary>
+	void Release(uint32_t index);
+
+	/// <summary>
+	/// ピッチとサンプリングレートから1フレームの進み幅を求める
+	/// </summary>
+	uint64_t CalculateStep(const Sound* sound, float pitch) const;
+
+	/// <summary>
+	/// ミックスに使う float サンプルの範囲
+	/// </summary>
+	struct SampleView {
+		const float* samples = nullptr;
+		uint32_t channels = 0;
+		uint32_t frameCount = 0;
+	};
+
+	/// <summary>
+	/// 1ボイスを出力に足し込む
+	/// </summary>
+	/// <returns>まだ鳴っているか</returns>
+	bool MixVoice(Voice& voice, float* output, uint32_t frameCount);
+
+	/// <summary>
+	/// float サンプルを出力に足し込む
+	/// </summary>
+	/// <returns>まだ鳴っているか</returns>
+	bool MixSamples(const SampleView& view, Voice& voice, float* output, uint32_t frameCount);
+
+	/// <summary>
+	/// IMA-ADPCM の音を、使う範囲だけ復号しながら出力に足し込む
+	/// </summary>
+	/// <returns>まだ鳴っているか</returns>
+	bool MixAdpcm(Voice& voice, float* output, uint32_t frameCount);
+
+	/// <summary>
+	/// 補間に使う次のフレームが範囲内に収まる間だけ、4フレームずつ SIMD で足し込む
+	/// </summary>
+	/// <returns>処理したフレーム数</returns>
+	template<uint32_t kChannels>
+	uint32_t MixVoiceSimd(const SampleView& view, Voice& voice, float* output, uint32_t frameCount);
+
+	uint32_t sampleRate_ = 0;
+
+	std::array<Voice, kMaxVoices> voices_;
+	std::array<Slot, kMaxVoices> slots_;
+	// 鳴っているボイスの番号（詰めて並べ、全枠を見て回らない）
+	std::vector<uint32_t> activeVoices_;
+	std::atomic<uint32_t> activeVoiceCount_ = 0;
+
+	// ADPCM を復号した範囲を置く作業用（ミックスの最中に確保しないよう先に取っておく）
+	std::vector<float> decodeBuffer_;
+
+	// 空きリストの先頭（上位32bitは ABA 対策の通し番号）
+	std::atomic<uint64_t> freeHead_ = 0;
+
+	MpscQueue<Command, kCommandCapacity> commands_;
+};
+
+/// <summary>
+/// ミキサーの出力先
+/// </summary>
+class AudioSink {
+public:
+	virtual ~AudioSink() = default;
+
+	/// <summary>
+	/// ミックス済みのフレームを受け取る
+	/// </summary>
+	/// <param name="samples">インターリーブのステレオ float</param>
+	/// <param name="frameCount">フレーム数</param>
+	virtual void Write(const float* samples, uint32_t frameCount) = 0;
+};
+
+/// <summary>
+/// 何も出さない出力先（フレーム数と最大振幅だけ数える）
+/// </summary>
+class NullAudioSink : public AudioSink {
+public:
+	void Write(const float* samples, uint32_t frameCount) override;
+
+	uint64_t GetFrameCount() const { return frameCount_; }
+	float GetPeak() const { return peak_; }
+
+private:
+	uint64_t frameCount_ = 0;
+	float peak_ = 0.0f;
+};
+
+/// <summary>
+/// 16bit ステレオのWAVファイルに書き出す出力先
+/// </summary>
+class WaveFileAudioSink : public AudioSink {
+public:
+	~WaveFileAudioSink() override;
+
+	/// <summary>
+	/// ファイルを開く
+	/// </summary>
+	bool Open(const std::string& filePath, uint32_t sampleRate);
+
+	/// <summary>
+	/// ヘッダの大きさを書き込んで閉じる
+	/// </summary>
+	void Close();
+
+	void Write(const float* samples, uint32_t frameCount) override;
+
+private:
+	std::ofstream file_;
+	uint32_t dataSize_ = 0;
+	std::vector<int16_t> converted_;
+};
@@ -0,0 +1,180 @@
+#define NOMINMAX
+#include "Culling.h"
+#include "WorldMatrixTransform.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 点をワールド行列で変換する（行ベクトル）
+Vector3 TransformPoint(const Vector3& point, const Matrix4x4& matrix) {
+	return {
+	    point.x * matrix.m[0][0] + point.y * matrix.m[1][0] + point.z * matrix.m[2][0] + matrix.m[3][0],
+	    point.x * matrix.m[0][1] + point.y * matrix.m[1][1] + point.z * matrix.m[2][1] + matrix.m[3][1],
+	    point.x * matrix.m[0][2] + point.y * matrix.m[1][2] + point.z * matrix.m[2][2] + matrix.m[3][2],
+	};
+}
+
+// 頂点の種類（エンジンの Mesh か ObjFile か）によらず pos だけを見る
+template<typename Vertex>
+MeshBounds CalculateBounds(const std::vector<Vertex>& vertices) {
+
+	MeshBounds bounds = {};
+	if (vertices.empty()) {
+		return bounds;
+	}
+
+	// AABB
+	bounds.aabb.min = vertices[0].pos;
+	bounds.aabb.max = vertices[0].pos;
+	for (const Vertex& vertex : vertices) {
+		bounds.aabb.min = {std::min(bounds.aabb.min.x, vertex.pos.x), std::min(bounds.aabb.min.y, vertex.pos.y), std::min(bounds.aabb.min.z, vertex.pos.z)};
+		bounds.aabb.max = {std::max(bounds.aabb.max.x, vertex.pos.x), std::max(bounds.aabb.max.y, vertex.pos.y), std::max(bounds.aabb.max.z, vertex.pos.z)};
+	}
+
+	// 境界球（AABBの中心から最も遠い頂点までを半径にする）
+	bounds.sphere.center = {
+	    (bounds.aabb.min.x + bounds.aabb.max.x) * 0.5f, (bounds.aabb.min.y + bounds.aabb.max.y) * 0.5f, (bounds.aabb.min.z + bounds.aabb.max.z) * 0.5f};
+	float radiusSquared = 0.0f;
+	for (const Vertex& vertex : vertices) {
+		float x = vertex.pos.x - bounds.sphere.center.x;
+		float y = vertex.pos.y - bounds.sphere.center.y;
+		float z = vertex.pos.z - bounds.sphere.center.z;
+		radiusSquared = std::max(radiusSquared, x * x + y * y + z * z);
+	}
+	bounds.sphere.radius = std::sqrt(radiusSquared);
+
+	return bounds;
+}
+
+} // namespace
+
+MeshBounds CalculateMeshBounds(const std::vector<Mesh::VertexPosNormalUv>& vertices) { return CalculateBounds(vertices); }
+
+ModelBounds CalculateModelBounds(Model* model) {
+
+	ModelBounds bounds = {};
+	std::vector<Mesh::VertexPosNormalUv> allVertices;
+
+	for (const std::unique_ptr<Mesh>& mesh : model->GetMeshes()) {
+		const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh->GetVertices();
+		bounds.meshes.push_back(CalculateMeshBounds(vertices));
+		allVertices.insert(allVertices.end(), vertices.begin(), vertices.end());
+	}
+
+	bounds.model = CalculateMeshBounds(allVertices);
+	return bounds;
+}
+
+ModelBounds CalculateModelBounds(const ObjFile::ModelData& model) {
+
+	ModelBounds bounds = {};
+	std::vector<MeshOptimizer::Vertex> allVertices;
+
+	for (const ObjFile::MeshData& mesh : model.meshes) {
+		bounds.meshes.push_back(CalculateBounds(mesh.vertices));
+		allVertices.insert(allVertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+	}
+
+	bounds.model = CalculateBounds(allVertices);
+	return bounds;
+}
+
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& matWorld) {
+
+	// 平行移動から始め、各軸の寄与の小さい方/大きい方を足していく
+	AABB result;
+	result.min = {matWorld.m[3][0], matWorld.m[3][1], matWorld.m[3][2]};
+	result.max = result.min;
+
+	const float localMin[3] = {aabb.min.x, aabb.min.y, aabb.min.z};
+	const float localMax[3] = {aabb.max.x, aabb.max.y, aabb.max.z};
+	float* resultMin[3] = {&result.min.x, &result.min.y, &result.min.z};
+	float* resultMax[3] = {&result.max.x, &result.max.y, &result.max.z};
+
+	for (int row = 0; row < 3; ++row) {
+		for (int column = 0; column < 3; ++column) {
+			float a = matWorld.m[row][column] * localMin[row];
+			float b = matWorld.m[row][column] * localMax[row];
+			*resultMin[column] += std::min(a, b);
+			*resultMax[column] += std::max(a, b);
+		}
+	}
+
+	return result;
+}
+
+BoundingSphere TransformSphere(const BoundingSphere& sphere, const Matrix4x4& matWorld) {
+
+	// 各軸の拡縮の最大値
+	float maxScaleSquared = 0.0f;
+	for (int row = 0; row < 3; ++row) {
+		float scaleSquared = matWorld.m[row][0] * matWorld.m[row][0] + matWorld.m[row][1] * matWorld.m[row][1] + matWorld.m[row][2] * matWorld.m[row][2];
+		maxScaleSquared = std::max(maxScaleSquared, scaleSquared);
+	}
+
+	BoundingSphere result;
+	result.center = TransformPoint(sphere.center, matWorld);
+	result.radius = sphere.radius * std::sqrt(maxScaleSquared);
+	return result;
+}
+
+void Frustum::Initialize(const Camera& camera) {
+
+	Matrix4x4 viewProjection = Multiply(camera.matView, camera.matProjection);
+	const float (*m)[4] = viewProjection.m;
+
+	// 行ベクトル規約なので列から平面を取り出す（Gribb/Hartmann法、Zは0〜1）
+	const float planes[6][4] = {
+	    {m[0][3] + m[0][0], m[1][3] + m[1][0], m[2][3] + m[2][0], m[3][3] + m[3][0]}, // 左
+	    {m[0][3] - m[0][0], m[1][3] - m[1][0], m[2][3] - m[2][0], m[3][3] - m[3][0]}, // 右
+	    {m[0][3] + m[0][1], m[1][3] + m[1][1], m[2][3] + m[2][1], m[3][3] + m[3][1]}, // 下
+	    {m[0][3] - m[0][1], m[1][3] - m[1][1], m[2][3] - m[2][1], m[3][3] - m[3][1]}, // 上
+	    {m[0][2],           m[1][2],           m[2][2],           m[3][2]          }, // 近
+	    {m[0][3] - m[0][2], m[1][3] - m[1][2], m[2][3] - m[2][2], m[3][3] - m[3][2]}, // 遠
+	};
+
+	// 球の判定で距離をそのまま使えるよう正規化しておく
+	for (size_t i = 0; i < planes_.size(); ++i) {
+		float length = std::sqrt(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+		planes_[i].normal = {planes[i][0] / length, planes[i][1] / length, planes[i][2] / length};
+		planes_[i].distance = planes[i][3] / length;
+	}
+}
+
+bool Frustum::IsVisible(const BoundingSphere& sphere) const {
+
+	for (const Plane& plane : planes_) {
+		float distance = plane.normal.x * sphere.center.x + plane.normal.y * sphere.center.y + plane.normal.z * sphere.center.z + plane.distance;
+		if (distance < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Frustum::IsVisible(const AABB& aabb) const {
+
+	for (const Plane& plane : planes_) {
+		// 平面の法線方向に最も進んだ頂点が外側なら全体が外側
+		Vector3 farthest = {
+		    plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x,
+		    plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y,
+		    plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z,
+		};
+		if (plane.normal.x * farthest.x + plane.normal.y * farthest.y + plane.normal.z * farthest.z + plane.distance < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Frustum::IsVisible(const ModelBounds& bounds, const Matrix4x4& matWorld) const {
+
+	if (!IsVisible(TransformSphere(bounds.model.sphere, matWorld))) {
+		return false;
+	}
+	return IsVisible(TransformAABB(bounds.model.aabb, matWorld));
+}
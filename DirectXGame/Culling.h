@@ -0,0 +1,102 @@
+#pragma once
+#include "AABB.h"
+#include "KamataEngine.h"
+#include "ObjFile.h"
+#include <array>
+#include <vector>
+
+/// <summary>
+/// 境界球
+/// </summary>
+struct BoundingSphere {
+	KamataEngine::Vector3 center; // 中心
+	float radius = 0.0f;          // 半径
+};
+
+/// <summary>
+/// メッシュの境界ボリューム（ローカル座標）
+/// </summary>
+struct MeshBounds {
+	AABB aabb;
+	BoundingSphere sphere;
+};
+
+/// <summary>
+/// モデルの境界ボリューム（ローカル座標）
+/// </summary>
+struct ModelBounds {
+	// モデル全体
+	MeshBounds model;
+	// メッシュごと（GetMeshes と同じ順）
+	std::vector<MeshBounds> meshes;
+};
+
+/// <summary>
+/// 頂点配列から境界ボリュームを求める
+/// </summary>
+/// <param name="vertices">頂点配列</param>
+/// <returns>境界ボリューム</returns>
+MeshBounds CalculateMeshBounds(const std::vector<KamataEngine::Mesh::VertexPosNormalUv>& vertices);
+
+/// <summary>
+/// モデルの全メッシュから境界ボリュームを求める（読み込み時に一度だけ呼ぶ）
+/// </summary>
+/// <param name="model">モデル</param>
+/// <returns>境界ボリューム</returns>
+ModelBounds CalculateModelBounds(KamataEngine::Model* model);
+
+/// <summary>
+/// 解析済みOBJの全メッシュから境界ボリュームを求める（最適化済みモデルの読み込み時に一度だけ呼ぶ）
+/// </summary>
+/// <param name="model">ObjFile で読み込んだモデル</param>
+/// <returns>境界ボリューム</returns>
+ModelBounds CalculateModelBounds(const ObjFile::ModelData& model);
+
+/// <summary>
+/// AABBをワールド行列で変換する（変換後も軸に沿った箱で包む）
+/// </summary>
+AABB TransformAABB(const AABB& aabb, const KamataEngine::Matrix4x4& matWorld);
+
+/// <summary>
+/// 境界球をワールド行列で変換する（半径は最大の拡縮で広げる）
+/// </summary>
+BoundingSphere TransformSphere(const BoundingSphere& sphere, const KamataEngine::Matrix4x4& matWorld);
+
+/// <summary>
+/// 視錐台
+/// </summary>
+class Frustum {
+public:
+	/// <summary>
+	/// カメラのビュー・プロジェクション行列から6平面を作る
+	/// </summary>
+	/// <param name="camera">行列更新済みのカメラ</param>
+	void Initialize(const KamataEngine::Camera& camera);
+
+	/// <summary>
+	/// 境界球が視錐台と重なるか
+	/// </summary>
+	bool IsVisible(const BoundingSphere& sphere) const;
+
+	/// <summary>
+	/// AABBが視錐台と重なるか
+	/// </summary>
+	bool IsVisible(const AABB& aabb) const;
+
+	/// <summary>
+	/// ワールド行列で置いたモデルが視錐台と重なるか（境界球で粗く判定してからAABBで判定する）
+	/// </summary>
+	/// <param name="bounds">モデルの境界ボリューム</param>
+	/// <param name="matWorld">ワールド行列</param>
+	bool IsVisible(const ModelBounds& bounds, const KamataEngine::Matrix4x4& matWorld) const;
+
+private:
+	// 平面（法線xyz・距離w、法線側が内側）
+	struct Plane {
+		KamataEngine::Vector3 normal;
+		float distance = 0.0f;
+	};
+
+	// 左・右・下・上・近・遠
+	std::array<Plane, 6> planes_;
+};
@@ -1,9 +1,8 @@
 #include "DeathParticles.h"
 
-void DeathParticles::Initialize(Model* model, Camera* camera, Vector3 position) {
+void DeathParticles::Initialize(OptimizedModel* model, Vector3 position) {
 
 	model_ = model;
-	camera_ = camera;
 
 	// ワールド変換の初期化
 	for (WorldTransform& worldTransform : worldTransforms_) {
@@ -11,7 +10,6 @@ void DeathParticles::Initialize(Model* model, Camera* camera, Vector3 position)
 		worldTransform.translation_ = position;
 	}
 
-	objectColor_.Initialize();
 	color_ = {1, 1, 1, 1};
 }
 
@@ -23,8 +21,6 @@ void DeathParticles::Update() {
 		}
 
 		color_.w = std::clamp(1.0f - counter_ / kDuration, 0.0f, 1.0f);
-		// 色変更オブジェクトに色の数値を設定する
-		objectColor_.SetColor(color_);	
 
 		// 基本となる速度ベクトル
 		Vector3 velocity = {kSpeed, 0, 0};
@@ -55,22 +51,17 @@ void DeathParticles::Update() {
 	}
 }
 
-void DeathParticles::Draw() {
+void DeathParticles::AddToSnapshot(RenderSnapshot& snapshot) const {
 
 	if (isFinished_) {
 		return;
 	}
 
-	// DirectXCommonインスタンスの生成
-	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
-
-	Model::PreDraw(dxCommon->GetCommandList());
-
 	for (const WorldTransform& worldTransform : worldTransforms_) {
-		model_->Draw(worldTransform, *camera_, &objectColor_);
+		RenderSnapshot::ModelDraw& draw = snapshot.AddModel(model_, worldTransform.matWorld_);
+		draw.color = color_;
+		draw.hasColor = true;
 	}
-
-	Model::PostDraw();
 }
 
 Vector3 Transform(const Vector3& vec, const Matrix4x4& mat) {
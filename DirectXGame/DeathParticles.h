@@ -1,5 +1,6 @@
 #pragma once
 #include "KamataEngine.h"
+#include "RenderSnapshot.h"
 #include "WorldMatrixTransform.h"
 #include <algorithm>
 #include <array>
@@ -11,14 +12,14 @@ Vector3 Transform(const Vector3& vec, const Matrix4x4& mat);
 
 class DeathParticles {
 public:
-	void Initialize(Model* model, Camera* camera, Vector3 position);
+	void Initialize(OptimizedModel* model, Vector3 position);
 	void Update();
-	void Draw();
+	// 描画するモデルをスナップショットに積む
+	void AddToSnapshot(RenderSnapshot& snapshot) const;
 	bool IsFinished() const { return isFinished_; }
 
 private:
-	Model* model_ = nullptr;
-	Camera* camera_ = nullptr;
+	OptimizedModel* model_ = nullptr;
 
 	static inline const uint32_t kNumParticles = 8;
 	std::array<WorldTransform, kNumParticles> worldTransforms_;
@@ -33,8 +34,6 @@ private:
 	// 経過時間カウント
 	float counter_ = 0.0f;
 
-	// 色変更オブジェクト
-	ObjectColor objectColor_;
-	// 色の数値
+	// 色の数値（描画側の色変更オブジェクトに写す）
 	Vector4 color_;
 };
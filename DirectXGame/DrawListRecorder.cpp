@@ -0,0 +1,128 @@
+#include "DrawListRecorder.h"
+#include "Profiler.h"
+#include <array>
+#include <cassert>
+#include <thread>
+
+void DrawListRecorder::SetMaxDrawsPerList(uint32_t maxDrawsPerList) { maxDrawsPerList_ = maxDrawsPerList > 0 ? maxDrawsPerList : 1; }
+
+void DrawListRecorder::Partition(std::span<const RenderPass> passes, std::span<const uint8_t> pipelines) {
+
+	PROFILE_ZONE("DrawListRecorder::Partition");
+
+	assert(pipelines.empty() || pipelines.size() == passes.size());
+
+	constexpr size_t kPassCount = static_cast<size_t>(RenderPass::kCount);
+
+	// 種類ごとの数を数えて、種類ごとの書き込み位置を決める（同じ種類の中は描画の順のまま）
+	std::array<uint32_t, kPassCount> counts = {};
+	for (RenderPass pass : passes) {
+		assert(pass < RenderPass::kCount);
+		++counts[static_cast<size_t>(pass)];
+	}
+
+	std::array<uint32_t, kPassCount> offsets = {};
+	uint32_t offset = 0;
+	for (size_t pass = 0; pass < kPassCount; ++pass) {
+		offsets[pass] = offset;
+		offset += counts[pass];
+	}
+
+	order_.resize(passes.size());
+	for (uint32_t i = 0; i < passes.size(); ++i) {
+		order_[offsets[static_cast<size_t>(passes[i])]++] = i;
+	}
+
+	// 種類ごとに、パイプラインが変わるところと上限の数で区切ってリストにする
+	auto pipelineAt = [&](uint32_t position) -> uint8_t { return pipelines.empty() ? 0 : pipelines[order_[position]]; };
+
+	lists_.clear();
+	uint32_t begin = 0;
+	for (size_t pass = 0; pass < kPassCount; ++pass) {
+		const uint32_t end = begin + counts[pass];
+		while (begin < end) {
+			const uint8_t pipeline = pipelineAt(begin);
+			uint32_t count = 1;
+			while (begin + count < end && count < maxDrawsPerList_ && pipelineAt(begin + count) == pipeline) {
+				++count;
+			}
+
+			DrawList& list = lists_.emplace_back();
+			list.pass = static_cast<RenderPass>(pass);
+			list.pipeline = pipeline;
+			list.begin = begin;
+			list.count = count;
+			begin += count;
+		}
+	}
+}
+
+void DrawListRecorder::Kick(std::span<const RenderPass> passes, DrawListBackend* backend, std::span<const uint8_t> pipelines) {
+
+	PROFILE_ZONE("DrawListRecorder::Kick");
+
+	assert(counter_.IsDone() && "previous lists must be submitted first");
+
+	Partition(passes, pipelines);
+
+	backend_ = backend;
+	backend_->BeginLists(static_cast<uint32_t>(lists_.size()));
+
+	// ワーカーがいない時はその場で記録する（誰もジョブを取らないので、描画スレッドが待ち続けてしまう）
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	if (jobSystem->GetThreadCount() <= 1 || JobSystem::GetThreadIndex() == JobSystem::kNotWorker) {
+		for (uint32_t i = 0; i < lists_.size(); ++i) {
+			backend_->RecordList(i, lists_[i].pass, GetDrawIndices(lists_[i]));
+		}
+		return;
+	}
+
+	for (uint32_t i = 0; i < lists_.size(); ++i) {
+		jobSystem->Run(
+		    [this, i]() {
+			    PROFILE_ZONE("DrawListRecorder::Record");
+			    backend_->RecordList(i, lists_[i].pass, GetDrawIndices(lists_[i]));
+		    },
+		    &counter_);
+	}
+}
+
+void DrawListRecorder::Wait() {
+
+	if (JobSystem::GetThreadIndex() == JobSystem::kNotWorker) {
+		return;
+	}
+	PROFILE_ZONE("DrawListRecorder::Wait");
+	JobSystem::GetInstance()->Wait(&counter_);
+}
+
+void DrawListRecorder::Submit() {
+
+	PROFILE_ZONE("DrawListRecorder::Submit");
+
+	// ワーカーのスレッドならジョブを手伝い、それ以外のスレッドは終わるのを待つだけ
+	Wait();
+	while (!counter_.IsDone()) {
+		std::this_thread::yield();
+	}
+
+	for (uint32_t i = 0; i < lists_.size(); ++i) {
+		backend_->SubmitList(i);
+	}
+}
+
+void NullDrawListBackend::BeginLists(uint32_t listCount) {
+
+	lists_.resize(listCount);
+	submitted_.clear();
+}
+
+void NullDrawListBackend::RecordList(uint32_t listIndex, RenderPass pass, std::span<const uint32_t> drawIndices) {
+
+	RecordedList& list = lists_[listIndex];
+	list.pass = pass;
+	list.drawIndices.assign(drawIndices.begin(), drawIndices.end());
+	list.threadIndex = JobSystem::GetThreadIndex();
+}
+
+void NullDrawListBackend::SubmitList(uint32_t listIndex) { submitted_.push_back(listIndex); }
@@ -0,0 +1,149 @@
+#pragma once
+#include "JobSystem.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// 描画の種類（この順にリストを提出する）
+/// </summary>
+enum class RenderPass : uint8_t {
+	kBlocks,     // ブロックと背景
+	kCharacters, // プレイヤーと敵
+	kEffects,    // エフェクト
+	kUI,         // UI
+	kCount,
+};
+
+class DrawListBackend;
+
+/// <summary>
+/// 描画を種類ごとのリストに分け、ジョブで並列に記録して、決まった順に提出する
+/// 同じ種類の描画は追加した順のまま、多ければ maxDrawsPerList ずつの複数のリストに分ける
+/// パイプラインの番号が変わるところでもリストを分けるので、1本のリストは1つのパイプラインだけで記録できる
+/// リストは種類の順、同じ種類の中は描画の順に並ぶので、並列に記録しても提出した結果は1本に記録した時と同じ順になる
+/// </summary>
+class DrawListRecorder {
+public:
+	/// <summary>
+	/// 1本のリストに記録する描画（GetDrawIndices で描画の番号を引く）
+	/// </summary>
+	struct DrawList {
+		RenderPass pass = RenderPass::kBlocks;
+		// 記録に使うパイプラインの番号（記録先が決める）
+		uint8_t pipeline = 0;
+		uint32_t begin = 0;
+		uint32_t count = 0;
+	};
+
+	// 1本のリストに記録する描画の数の既定値
+	static constexpr uint32_t kDefaultMaxDrawsPerList = 512;
+
+	/// <summary>
+	/// 1本のリストに記録する描画の数の上限を設定する
+	/// </summary>
+	void SetMaxDrawsPerList(uint32_t maxDrawsPerList);
+
+	/// <summary>
+	/// 描画をリストに分ける（記録はしない）
+	/// </summary>
+	/// <param name="passes">描画ごとの種類（描画の順）</param>
+	/// <param name="pipelines">描画ごとのパイプラインの番号（空なら全て0）</param>
+	void Partition(std::span<const RenderPass> passes, std::span<const uint8_t> pipelines = {});
+
+	/// <summary>
+	/// 描画をリストに分け、リストごとに記録するジョブを積む（ワーカーのスレッドから呼ぶ、ワーカーがいなければその場で記録する）
+	/// </summary>
+	/// <param name="passes">描画ごとの種類（描画の順、呼び出しの間だけ生きていればよい）</param>
+	/// <param name="backend">記録先（Submit が返るまで生きていること）</param>
+	/// <param name="pipelines">描画ごとのパイプラインの番号（空なら全て0、呼び出しの間だけ生きていればよい）</param>
+	void Kick(std::span<const RenderPass> passes, DrawListBackend* backend, std::span<const uint8_t> pipelines = {});
+
+	/// <summary>
+	/// 記録が終わるまで、他のジョブを実行しながら待つ（Kick したスレッドから呼ぶ）
+	/// </summary>
+	void Wait();
+
+	/// <summary>
+	/// 記録したリストを順に提出する（どのスレッドからでもよい、記録が終わっていなければ終わるまで待つ）
+	/// </summary>
+	void Submit();
+
+	/// <summary>
+	/// 分けたリスト（提出する順）
+	/// </summary>
+	const std::vector<DrawList>& GetLists() const { return lists_; }
+
+	/// <summary>
+	/// リストに記録する描画の番号（描画の順）
+	/// </summary>
+	std::span<const uint32_t> GetDrawIndices(const DrawList& list) const { return std::span<const uint32_t>(order_).subspan(list.begin, list.count); }
+
+private:
+	// 種類ごとに並べ替えた描画の番号
+	std::vector<uint32_t> order_;
+	// 提出する順のリスト
+	std::vector<DrawList> lists_;
+	uint32_t maxDrawsPerList_ = kDefaultMaxDrawsPerList;
+
+	// Kick した記録先と、記録するジョブの完了
+	DrawListBackend* backend_ = nullptr;
+	JobCounter counter_;
+};
+
+/// <summary>
+/// 描画リストの記録先
+/// </summary>
+class DrawListBackend {
+public:
+	virtual ~DrawListBackend() = default;
+
+	/// <summary>
+	/// 記録の前に、リストの数だけ記録先を用意する（Kick したスレッドから呼ばれる、リストの中身は GetLists で引ける）
+	/// </summary>
+	virtual void BeginLists(uint32_t listCount) = 0;
+
+	/// <summary>
+	/// 1本のリストを記録する（リストごとに別のジョブから並列に呼ばれる）
+	/// </summary>
+	/// <param name="listIndex">リストの番号（提出する順）</param>
+	/// <param name="pass">描画の種類</param>
+	/// <param name="drawIndices">記録する描画の番号（描画の順）</param>
+	virtual void RecordList(uint32_t listIndex, RenderPass pass, std::span<const uint32_t> drawIndices) = 0;
+
+	/// <summary>
+	/// 記録したリストを提出する（Submit から番号の順に呼ばれる）
+	/// </summary>
+	virtual void SubmitList(uint32_t listIndex) = 0;
+};
+
+/// <summary>
+/// 何も描かない記録先（リストごとに記録した描画と、提出された順だけ残す）
+/// </summary>
+class NullDrawListBackend : public DrawListBackend {
+public:
+	/// <summary>
+	/// 記録されたリスト
+	/// </summary>
+	struct RecordedList {
+		RenderPass pass = RenderPass::kBlocks;
+		std::vector<uint32_t> drawIndices;
+		// 記録したワーカーの番号
+		uint32_t threadIndex = JobSystem::kNotWorker;
+	};
+
+	void BeginLists(uint32_t listCount) override;
+	void RecordList(uint32_t listIndex, RenderPass pass, std::span<const uint32_t> drawIndices) override;
+	void SubmitList(uint32_t listIndex) override;
+
+	const std::vector<RecordedList>& GetLists() const { return lists_; }
+
+	/// <summary>
+	/// 提出されたリストの番号（提出された順）
+	/// </summary>
+	const std::vector<uint32_t>& GetSubmitted() const { return submitted_; }
+
+private:
+	std::vector<RecordedList> lists_;
+	std::vector<uint32_t> submitted_;
+};
@@ -1,24 +1,36 @@
 #include "Enemy.h"
-#include "GameScene.h"
+#include "AssetManager.h"
 #include "Player.h"
 
-void Enemy::Initialize(Model* model, Camera* camera, const Vector3& position) {
+void Enemy::Initialize(OptimizedModel* model, const Vector3& position) {
 	model_ = model;
-	camera_ = camera;
-	worldTransform_.Initialize();
+	bounds_ = AssetManager::GetInstance()->GetBounds(model);
+
+	// プールから使い回すので、状態は全て最初に戻す
+	behavior_ = Behavior::kWalk;
+	behaviorRequest_ = Behavior::kUnknown;
+	isDead_ = false;
+	deadTimer_ = 0.0f;
+	isCollisionDisabled_ = false;
+	walkers_ = nullptr;
+	walkLane_ = 0;
 
 	// 初期座標
+	worldTransform_.scale_ = {1.0f, 1.0f, 1.0f};
+	worldTransform_.rotation_ = {};
 	worldTransform_.translation_ = position;
 
 	// 自キャラと逆向き（例：左を向く）
 	worldTransform_.rotation_.y = -std::numbers::pi_v<float> /*/ 2.0f*/;
 
-	velocity_ = {-kWalkSpeed, 0, 0};
+	velocity_ = {-EnemyWalkBatch::kWalkSpeed, 0, 0};
 
 	walkTimer_ = 0.0f;
+
+	UpdateMatrix();
 }
 
-void Enemy::Update() {
+void Enemy::Update(uint32_t ticks) {
 
 	if (behaviorRequest_ != Behavior::kUnknown) {
 
@@ -28,16 +40,12 @@ void Enemy::Update() {
 
 		case Behavior::kWalk:
 		default:
-
-			BehaviorWalkInitialize();
-			BehaviorWalkUpdate();
-
 			break;
 
 		case Behavior::kDead:
 
 			BehaviorDeadInitialize();
-			BehaviorDeadUpdate();
+			BehaviorDeadUpdate(ticks);
 
 			break;
 		}
@@ -49,28 +57,26 @@ void Enemy::Update() {
 	case Behavior::kWalk:
 	default:
 
-		BehaviorWalkUpdate();
-
+		// 歩いている間は EnemyWalkBatch のレーンで進める（EnemyActivation は歩いている敵をここへは回さない）
 		break;
 
 	case Behavior::kDead:
 
-		BehaviorDeadUpdate();
+		BehaviorDeadUpdate(ticks);
 
 		break;
 	}
 }
 
-void Enemy::Draw() {
-
-	// DirectXCommonインスタンスの生成
-	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+void Enemy::AddToSnapshot(RenderSnapshot& snapshot, const Frustum& frustum) const {
 
-	Model::PreDraw(dxCommon->GetCommandList());
-
-	model_->Draw(worldTransform_, *camera_);
+	// 画面外なら描画しない
+	const Matrix4x4 matWorld = GetWorldMatrix();
+	if (bounds_ && !frustum.IsVisible(*bounds_, matWorld)) {
+		return;
+	}
 
-	Model::PostDraw();
+	snapshot.AddModel(model_, matWorld);
 }
 
 void Enemy::OnCollision(const Player* player) {
@@ -82,88 +88,96 @@ void Enemy::OnCollision(const Player* player) {
 	}
 
 	if (player->IsAttack()) {
+		// デス演出は1体ずつ更新する
+		LeaveWalkLane();
+
 		// 敵のふるまいをデス演出に変更
 		behaviorRequest_ = Behavior::kDead;
 
 		// 敵と自キャラの中間位置にエフェクトを生成
 		Vector3 effectPos = (worldTransform_.translation_ + player->GetWorldPosition()) / 2.0f;
-		gameScene_->CreateHitEffect(effectPos);
+		commandBuffer_->CreateHitEffect(effectPos);
 
 		isCollisionDisabled_ = true;
 	}
 }
 
 AABB Enemy::GetAABB() {
-	Vector3 worldPos = worldTransform_.translation_;
+	Vector3 worldPos = GetWorldPosition();
 
 	AABB aabb;
 
+	constexpr float kWidth = EnemyWalkBatch::kWidth;
+	constexpr float kHeight = EnemyWalkBatch::kHeight;
 	aabb.min = {worldPos.x - kWidth / 2.0f, worldPos.y - kHeight / 2.0f, worldPos.z - kWidth / 2.0f};
 	aabb.max = {worldPos.x + kWidth / 2.0f, worldPos.y + kHeight / 2.0f, worldPos.z + kWidth / 2.0f};
 
 	return aabb;
 }
 
-void Enemy::BehaviorWalkInitialize() {}
+Vector3 Enemy::GetWorldPosition() const {
 
-void Enemy::BehaviorWalkUpdate() {
+	if (!IsInWalkLane()) {
+		return worldTransform_.translation_;
+	}
 
-	int steps = std::max(1, (int)std::ceil(std::abs(velocity_.x) / kMaxStep));
-	float dx = velocity_.x / (float)steps;
+	const EnemyWalkBatch::Walker walker = walkers_->Get(walkLane_);
+	return {walker.x, walker.y, worldTransform_.translation_.z};
+}
 
-	constexpr float kYawRight = -std::numbers::pi_v<float> * 2.0f; // 右向き
-	constexpr float kYawLeft = std::numbers::pi_v<float>;
+Matrix4x4 Enemy::GetWorldMatrix() const {
 
-	for (int i = 0; i < steps; ++i) {
-		if (dx != 0.0f) {
-			float dir = (dx > 0.0f) ? 1.0f : -1.0f;
-			Vector3 next = worldTransform_.translation_;
-			next.x += dx;
+	if (!IsInWalkLane()) {
+		return worldTransform_.matWorld_;
+	}
 
-			// 進行方向側の2点（胸/足）で壁ヒットを検出
-			Vector3 p1 = {next.x + dir * (kWidth * 0.5f + kEPS), worldTransform_.translation_.y + kHeight * 0.25f, next.z};
-			Vector3 p2 = {next.x + dir * (kWidth * 0.5f + kEPS), worldTransform_.translation_.y - kHeight * 0.25f, next.z};
+	const EnemyWalkBatch::Walker walker = walkers_->Get(walkLane_);
+	return MakeAffineMatrix(worldTransform_.scale_, {walker.rotationX, walker.rotationY, worldTransform_.rotation_.z}, {walker.x, walker.y, worldTransform_.translation_.z});
+}
 
-			if (map_ && (IsSolidAt(p1) || IsSolidAt(p2))) {
-				auto r = TileRectAt((IsSolidAt(p1) ? p1 : p2));
-				float boundary = (dir > 0.0f) ? r.left : r.right;
-				worldTransform_.translation_.x = boundary - dir * (kWidth * 0.5f + kEPS);
+EnemyWalkBatch::Walker Enemy::GetWalker() const {
 
-				velocity_.x *= -1.0f;
-				worldTransform_.rotation_.y = (velocity_.x > 0.0f) ? kYawRight : kYawLeft;
-				dx = 0.0f;
-			} else {
-				worldTransform_.translation_.x = next.x;
-			}
-		}
-	}
+	EnemyWalkBatch::Walker walker;
+	walker.x = worldTransform_.translation_.x;
+	walker.y = worldTransform_.translation_.y;
+	walker.velocityX = velocity_.x;
+	walker.walkTimer = walkTimer_;
+	walker.rotationX = worldTransform_.rotation_.x;
+	walker.rotationY = worldTransform_.rotation_.y;
+	return walker;
+}
 
-	// タイマー加算（1フレームに1/60秒ずつ）
-	walkTimer_ += 1.0f / 60.0f;
+void Enemy::LeaveWalkLane() {
 
-	// 回転アニメーション
-	float param = std::sin((2.0f * std::numbers::pi_v<float>)*walkTimer_ / kWalkMotionTime);
+	if (!IsInWalkLane()) {
+		return;
+	}
 
-	float degree = kWalkMotionAngleStart + (kWalkMotionAngleEnd - kWalkMotionAngleStart) * (param + 1.0f) / 2.0f;
-	worldTransform_.rotation_.x = degree * (3.14159265f / 180.0f); // 度をラジアンに変換
+	const EnemyWalkBatch::Walker walker = walkers_->Get(walkLane_);
+	worldTransform_.translation_.x = walker.x;
+	worldTransform_.translation_.y = walker.y;
+	velocity_.x = walker.velocityX;
+	walkTimer_ = walker.walkTimer;
+	worldTransform_.rotation_.x = walker.rotationX;
+	worldTransform_.rotation_.y = walker.rotationY;
+	walkers_->SetWalking(walkLane_, false);
 
-	// 行列更新
-	WorldTransformUpdate(worldTransform_);
+	UpdateMatrix();
 }
 
 void Enemy::BehaviorDeadInitialize() {}
 
-void Enemy::BehaviorDeadUpdate() {
+void Enemy::BehaviorDeadUpdate(uint32_t ticks) {
 
 	// タイマー加算（1フレームに1/60秒ずつ）
-	deadTimer_ += 1.0f / 60.0f;
+	deadTimer_ += static_cast<float>(ticks) / 60.0f;
 
 	// 死亡時アニメーション
 	float t = std::clamp(deadTimer_ / 1.0f, 0.0f, 1.0f);
 	float e = 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t);
 
 	// Y軸
-	worldTransform_.rotation_.y += (2.0f * std::numbers::pi_v<float>)*6.0f * (1.0f / 60.0f) * (1.0f - 0.8f * e);
+	worldTransform_.rotation_.y += (2.0f * std::numbers::pi_v<float>)*6.0f * (static_cast<float>(ticks) / 60.0f) * (1.0f - 0.8f * e);
 
 	// X軸
 	worldTransform_.rotation_.x = (-110.0f * std::numbers::pi_v<float> / 180.0f) * e;
@@ -172,21 +186,15 @@ void Enemy::BehaviorDeadUpdate() {
 	float s = 1.0f - e;
 	worldTransform_.scale_ = {s, s, s};
 
-	if (deadTimer_ >= 60.0f) {
+	if (deadTimer_ >= 60.0f && !isDead_) {
 		isDead_ = true;
+
+		// 自分の削除はシーンが並列の更新を終えてから行う
+		commandBuffer_->Destroy(this);
 	}
 
 	// 行列更新
-	WorldTransformUpdate(worldTransform_);
-}
-
-bool Enemy::IsSolidAt(const Vector3& p) const {
-	auto idx = map_->GetMapChipIndexSetByPosition(p);
-	auto type = map_->GetMapChipTypeByIndex(idx.xIndex, idx.yIndex);
-	return type == MapChipType::kBlock;
+	UpdateMatrix();
 }
 
-MapChipField::Rect Enemy::TileRectAt(const Vector3& p) const {
-	auto idx = map_->GetMapChipIndexSetByPosition(p);
-	return map_->GetRectByIndex(idx.xIndex, idx.yIndex);
-}
\ No newline at end of file
+void Enemy::UpdateMatrix() { worldTransform_.matWorld_ = MakeAffineMatrix(worldTransform_.scale_, worldTransform_.rotation_, worldTransform_.translation_); }
@@ -1,8 +1,11 @@
 #pragma once
 #define NOMINMAX
 #include "AABB.h"
+#include "Culling.h"
+#include "EnemyCommandBuffer.h"
+#include "EnemyWalkBatch.h"
 #include "KamataEngine.h"
-#include "MapChipField.h"
+#include "RenderSnapshot.h"
 #include "WorldMatrixTransform.h"
 #include <Windows.h>
 #include <algorithm>
@@ -12,19 +15,27 @@ using namespace KamataEngine;
 
 class Player;
 
-class GameScene;
-
 /// <summary>
 /// 敵
+/// 更新は他の敵と並列に呼ばれるので、マップは読むだけにして書き換えるのは自分の状態だけにする
+/// シーンへの操作（エフェクトの生成や自分の削除）はコマンドバッファに積む
+/// 歩いている間の状態は EnemyActivation の区画の EnemyWalkBatch のレーンにあり、まとめて更新される（Update はそれ以外の時だけ呼ばれる）
 /// </summary>
 class Enemy {
 
 public:
-	void Initialize(Model* model, Camera* camera, const Vector3& position);
+	void Initialize(OptimizedModel* model, const Vector3& position);
 
-	void Update();
+	/// <summary>
+	/// 更新
+	/// </summary>
+	/// <param name="ticks">進めるティック数（遠くて間引いて更新する時はまとめて進める）</param>
+	void Update(uint32_t ticks = 1);
 
-	void Draw();
+	/// <summary>
+	/// 描画するモデルをスナップショットに積む（視錐台の外なら何もしない）
+	/// </summary>
+	void AddToSnapshot(RenderSnapshot& snapshot, const Frustum& frustum) const;
 
 	// 衝突応答
 	void OnCollision(const Player* player);
@@ -37,19 +48,43 @@ public:
 
 	bool GetIsDead() { return isDead_; }
 
-	void BehaviorWalkInitialize();
+	Vector3 GetWorldPosition() const;
 
-	void BehaviorWalkUpdate();
+	/// <summary>
+	/// ワールド行列（歩いている間はレーンの状態から作る）
+	/// </summary>
+	Matrix4x4 GetWorldMatrix() const;
+
+	/// <summary>
+	/// 歩いているか（レーンでまとめて更新できるか）
+	/// </summary>
+	bool IsWalking() const { return behavior_ == Behavior::kWalk && behaviorRequest_ == Behavior::kUnknown; }
+
+	/// <summary>
+	/// レーンに入れる歩く状態
+	/// </summary>
+	EnemyWalkBatch::Walker GetWalker() const;
+
+	/// <summary>
+	/// 歩く状態を持つレーンを設定する（EnemyActivation から呼ぶ、nullptr で外す）
+	/// </summary>
+	void AttachWalkLane(EnemyWalkBatch* walkers, uint32_t lane) {
+		walkers_ = walkers;
+		walkLane_ = lane;
+	}
+
+	/// <summary>
+	/// レーンの状態を自分に写して、以降は1体ずつ更新する
+	/// </summary>
+	void LeaveWalkLane();
 
 	void BehaviorDeadInitialize();
 
-	void BehaviorDeadUpdate();
+	void BehaviorDeadUpdate(uint32_t ticks = 1);
 
 	bool IsCollisionDisabled() const { return isCollisionDisabled_; }
 
-	void SetGameScene(GameScene* gameScene) { gameScene_ = gameScene; }
-
-	void SetMapChipField(MapChipField* m) { map_ = m; }
+	void SetCommandBuffer(EnemyCommandBuffer* commandBuffer) { commandBuffer_ = commandBuffer; }
 
 private:
 	enum class Behavior {
@@ -62,34 +97,21 @@ private:
 
 	Behavior behaviorRequest_ = Behavior::kUnknown;
 
-	// ワールド変換データ
+	// ワールド変換データ（描画は SceneRenderer の定数バッファに写すので、行列だけ計算して GPU のバッファは作らない）
 	WorldTransform worldTransform_;
 
 	// 3Dモデル
-	Model* model_ = nullptr;
-
-	// カメラ
-	Camera* camera_ = nullptr;
+	OptimizedModel* model_ = nullptr;
 
-	// 歩行の速さ
-	static inline const float kWalkSpeed = 0.05f;
+	// モデルの境界ボリューム
+	const ModelBounds* bounds_ = nullptr;
 
 	// 速度
 	Vector3 velocity_ = {};
 
-	// アニメーション用角度（度数法）
-	static inline const float kWalkMotionAngleStart = -10.0f; // 少し下を向く
-	static inline const float kWalkMotionAngleEnd = 10.0f;    // 少し上を向く
-
-	// アニメーションの周期（秒）
-	static inline const float kWalkMotionTime = 1.0f;
-
 	// 経過時間（アニメーション用）
 	float walkTimer_ = 0.0f;
 
-	static inline const float kWidth = 0.8f;
-	static inline const float kHeight = 0.8f;
-
 	// デスフラグ
 	bool isDead_ = false;
 
@@ -98,13 +120,21 @@ private:
 
 	bool isCollisionDisabled_ = false;
 
-	GameScene* gameScene_ = nullptr;
+	// シーンへの操作を積む先
+	EnemyCommandBuffer* commandBuffer_ = nullptr;
 
-	MapChipField* map_ = nullptr;
+	// 歩く状態を持つレーン
+	EnemyWalkBatch* walkers_ = nullptr;
+	uint32_t walkLane_ = 0;
 
-	static inline constexpr float kEPS = 0.001f;
-	static inline constexpr float kMaxStep = 0.3f;
+	/// <summary>
+	/// 歩く状態がレーンにあるか
+	/// </summary>
+	bool IsInWalkLane() const { return walkers_ && walkers_->IsWalking(walkLane_); }
+
+	/// <summary>
+	/// 行列の計算（定数バッファへの転送はしない）
+	/// </summary>
+	void UpdateMatrix();
 
-	bool IsSolidAt(const Vector3& p) const;
-	MapChipField::Rect TileRectAt(const Vector3& p) const;
 };
@@ -0,0 +1,122 @@
+#define NOMINMAX
+#include "EnemyActivation.h"
+#include "Enemy.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void EnemyActivation::Initialize(float worldWidth, const EnemyWalkBatch::TileGrid* tiles) {
+
+	const uint32_t cellCount = std::max(1u, static_cast<uint32_t>(std::ceil(worldWidth / kCellWidth)));
+	cells_.assign(cellCount, {});
+	for (Cell& cell : cells_) {
+		cell.walkers.SetTiles(tiles);
+	}
+	updates_.clear();
+	cellUpdates_.clear();
+	cameraCell_ = 0;
+	tick_ = 0;
+	enemyCount_ = 0;
+}
+
+void EnemyActivation::Add(Enemy* enemy) {
+
+	Insert(cells_[CellOf(enemy->GetWorldPosition().x)], enemy, enemy->GetWalker(), enemy->IsWalking());
+	++enemyCount_;
+}
+
+void EnemyActivation::Remove(Enemy* enemy) {
+
+	Cell& cell = cells_[CellOf(enemy->GetWorldPosition().x)];
+	auto it = std::find(cell.enemies.begin(), cell.enemies.end(), enemy);
+	assert(it != cell.enemies.end());
+
+	// レーンの状態を敵に戻してから外す
+	enemy->LeaveWalkLane();
+	RemoveAt(cell, static_cast<uint32_t>(it - cell.enemies.begin()));
+	enemy->AttachWalkLane(nullptr, 0);
+	--enemyCount_;
+}
+
+void EnemyActivation::Gather(float cameraX) {
+
+	SetCameraX(cameraX);
+	++tick_;
+
+	updates_.clear();
+	cellUpdates_.clear();
+	const uint32_t first = cameraCell_ > kReducedCellRadius ? cameraCell_ - kReducedCellRadius : 0;
+	const uint32_t last = std::min(cameraCell_ + kReducedCellRadius, static_cast<uint32_t>(cells_.size()) - 1);
+	for (uint32_t cell = first; cell <= last; ++cell) {
+
+		const uint32_t distance = cell > cameraCell_ ? cell - cameraCell_ : cameraCell_ - cell;
+		uint32_t ticks = 1;
+		if (distance > kActiveCellRadius) {
+			// 区画ごとに順番をずらして、同じティックに集まらないようにする
+			if ((tick_ + cell) % kReducedTickInterval != 0) {
+				continue;
+			}
+			ticks = kReducedTickInterval;
+		}
+
+		const Cell& current = cells_[cell];
+		if (current.enemies.empty()) {
+			continue;
+		}
+		cellUpdates_.push_back({&cells_[cell].walkers, cell, ticks});
+
+		// 歩いていない敵だけを1体ずつ更新する
+		for (uint32_t i = 0; i < current.enemies.size(); ++i) {
+			if (!current.walkers.IsWalking(i)) {
+				updates_.push_back({current.enemies[i], ticks});
+			}
+		}
+	}
+}
+
+void EnemyActivation::Relocate() {
+
+	for (const CellUpdate& update : cellUpdates_) {
+		// 後ろから見るので、外した所に移ってくる末尾の敵は見終わっている
+		Cell& from = cells_[update.cell];
+		for (uint32_t i = static_cast<uint32_t>(from.enemies.size()); i-- > 0;) {
+			Enemy* enemy = from.enemies[i];
+			const uint32_t cell = CellOf(enemy->GetWorldPosition().x);
+			if (cell == update.cell) {
+				continue;
+			}
+
+			const EnemyWalkBatch::Walker walker = from.walkers.Get(i);
+			const bool walking = from.walkers.IsWalking(i);
+			RemoveAt(from, i);
+			Insert(cells_[cell], enemy, walker, walking);
+		}
+	}
+}
+
+void EnemyActivation::Insert(Cell& cell, Enemy* enemy, const EnemyWalkBatch::Walker& walker, bool walking) {
+
+	const uint32_t lane = cell.walkers.Add(walker);
+	cell.walkers.SetWalking(lane, walking);
+	cell.enemies.push_back(enemy);
+	enemy->AttachWalkLane(&cell.walkers, lane);
+}
+
+void EnemyActivation::RemoveAt(Cell& cell, uint32_t index) {
+
+	// 区画の中の順番は意味を持たないので、末尾と入れ替えて外す（レーンも同じように入れ替わる）
+	cell.walkers.Remove(index);
+	cell.enemies[index] = cell.enemies.back();
+	cell.enemies.pop_back();
+	if (index < cell.enemies.size()) {
+		cell.enemies[index]->AttachWalkLane(&cell.walkers, index);
+	}
+}
+
+uint32_t EnemyActivation::CellOf(float x) const {
+
+	if (x <= 0.0f) {
+		return 0;
+	}
+	return std::min(static_cast<uint32_t>(x / kCellWidth), static_cast<uint32_t>(cells_.size()) - 1);
+}
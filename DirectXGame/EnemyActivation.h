@@ -0,0 +1,153 @@
+#pragma once
+#include "EnemyWalkBatch.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Enemy;
+
+/// <summary>
+/// 敵の起こし方をカメラからの距離で決める
+/// 敵をX方向の区画ごとに分けて持ち、カメラに近い区画は毎ティック、少し離れた区画は数ティックおきにまとめて更新する
+/// それより遠い区画の敵は眠らせたままにし、どの処理からも触らない（敵の総数ではなく、カメラの近くにいる数だけ手間が掛かる）
+/// 歩いている敵は区画ごとの EnemyWalkBatch でまとめて更新し、やられ演出などの敵だけを1体ずつ更新する
+/// </summary>
+class EnemyActivation {
+public:
+	/// <summary>
+	/// このティックで1体ずつ更新する敵（歩いていない敵）
+	/// </summary>
+	struct Update {
+		Enemy* enemy;
+		// 進めるティック数
+		uint32_t ticks;
+	};
+
+	/// <summary>
+	/// このティックでまとめて更新する区画の歩いている敵
+	/// </summary>
+	struct CellUpdate {
+		EnemyWalkBatch* walkers;
+		uint32_t cell;
+		// 進めるティック数
+		uint32_t ticks;
+	};
+
+	// 区画の幅
+	static constexpr float kCellWidth = 8.0f;
+	// 毎ティック更新する区画（カメラのいる区画から左右にいくつまでか）
+	static constexpr uint32_t kActiveCellRadius = 3;
+	// 間引いて更新する区画（これより遠い区画は眠らせる、画面の端より外にすること）
+	static constexpr uint32_t kReducedCellRadius = 6;
+	// 間引いて更新する区画を何ティックおきに更新するか
+	static constexpr uint32_t kReducedTickInterval = 4;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="worldWidth">敵が動ける範囲の幅（0 からこの幅までを区画に分ける）</param>
+	/// <param name="tiles">歩いている敵が折り返す壁のマス</param>
+	void Initialize(float worldWidth, const EnemyWalkBatch::TileGrid* tiles);
+
+	/// <summary>
+	/// 敵を今いる位置の区画に入れる
+	/// </summary>
+	void Add(Enemy* enemy);
+
+	/// <summary>
+	/// 敵を区画から外す
+	/// </summary>
+	void Remove(Enemy* enemy);
+
+	/// <summary>
+	/// 起こす区画の中心になるカメラの位置を設定する
+	/// </summary>
+	void SetCameraX(float cameraX) { cameraCell_ = CellOf(cameraX); }
+
+	/// <summary>
+	/// カメラの位置から、このティックで更新する敵を集める
+	/// </summary>
+	void Gather(float cameraX);
+
+	/// <summary>
+	/// Gather で集めた、1体ずつ更新する敵
+	/// </summary>
+	std::span<const Update> GetUpdates() const { return updates_; }
+
+	/// <summary>
+	/// Gather で集めた、歩いている敵をまとめて更新する区画
+	/// </summary>
+	std::span<const CellUpdate> GetCellUpdates() const { return cellUpdates_; }
+
+	/// <summary>
+	/// 更新で区画をまたいだ敵を入れ直す（並列の更新が終わってから呼ぶ）
+	/// </summary>
+	void Relocate();
+
+	/// <summary>
+	/// 毎ティック更新する区画の敵を処理する（当たり判定など）
+	/// </summary>
+	template<typename Function>
+	void ForEachActive(const Function& function) const {
+		ForEachInRadius(kActiveCellRadius, function);
+	}
+
+	/// <summary>
+	/// 眠っていない区画の敵を処理する（描画など）
+	/// </summary>
+	template<typename Function>
+	void ForEachAwake(const Function& function) const {
+		ForEachInRadius(kReducedCellRadius, function);
+	}
+
+	/// <summary>
+	/// 区画に入っている敵の数
+	/// </summary>
+	uint32_t GetEnemyCount() const { return enemyCount_; }
+
+private:
+	/// <summary>
+	/// 区画の敵（enemies[i] の歩く状態は walkers のレーン i）
+	/// </summary>
+	struct Cell {
+		std::vector<Enemy*> enemies;
+		EnemyWalkBatch walkers;
+	};
+
+	/// <summary>
+	/// X座標の区画
+	/// </summary>
+	uint32_t CellOf(float x) const;
+
+	/// <summary>
+	/// 敵を区画の末尾に入れる
+	/// </summary>
+	void Insert(Cell& cell, Enemy* enemy, const EnemyWalkBatch::Walker& walker, bool walking);
+
+	/// <summary>
+	/// 区画の i 番目の敵を外す（末尾の敵がこの番号に移る）
+	/// </summary>
+	void RemoveAt(Cell& cell, uint32_t index);
+
+	template<typename Function>
+	void ForEachInRadius(uint32_t radius, const Function& function) const {
+		const uint32_t first = cameraCell_ > radius ? cameraCell_ - radius : 0;
+		const uint32_t last = cameraCell_ + radius < cells_.size() ? cameraCell_ + radius : static_cast<uint32_t>(cells_.size()) - 1;
+		for (uint32_t cell = first; cell <= last && cell < cells_.size(); ++cell) {
+			for (Enemy* enemy : cells_[cell].enemies) {
+				function(enemy);
+			}
+		}
+	}
+
+	// 区画ごとの敵
+	std::vector<Cell> cells_;
+	// このティックで更新する敵
+	std::vector<Update> updates_;
+	std::vector<CellUpdate> cellUpdates_;
+	// カメラのいる区画
+	uint32_t cameraCell_ = 0;
+	// 間引いて更新する区画を、区画ごとにずらして順番に回すためのティック数
+	uint32_t tick_ = 0;
+	uint32_t enemyCount_ = 0;
+};
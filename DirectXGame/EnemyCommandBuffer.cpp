@@ -0,0 +1,25 @@
+#include "EnemyCommandBuffer.h"
+#include "JobSystem.h"
+#include <cassert>
+
+void EnemyCommandBuffer::Initialize() {
+
+	// ジョブシステムを使わない時も0番の列に積めるようにする
+	const uint32_t threadCount = JobSystem::GetInstance()->GetThreadCount();
+	threads_.clear();
+	threads_.resize(threadCount > 0 ? threadCount : 1);
+}
+
+void EnemyCommandBuffer::CreateHitEffect(const KamataEngine::Vector3& position) { Push({Type::kCreateHitEffect, nullptr, position}); }
+
+void EnemyCommandBuffer::Destroy(Enemy* enemy) { Push({Type::kDestroy, enemy, {}}); }
+
+void EnemyCommandBuffer::Push(const Command& command) {
+
+	uint32_t threadIndex = JobSystem::GetThreadIndex();
+	if (threadIndex == JobSystem::kNotWorker) {
+		threadIndex = 0;
+	}
+	assert(threadIndex < threads_.size());
+	threads_[threadIndex].commands.push_back(command);
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "KamataEngine.h"
+#include <cstdint>
+#include <vector>
+
+class Enemy;
+
+/// <summary>
+/// 敵の更新中に出た、シーンの構造を変える操作（エフェクトの生成や敵の削除）を後回しにするバッファ
+/// 敵の更新は並列に行うので、シーンには直接触らずにスレッドごとの列に積み、並列の処理が終わってからまとめて反映する
+/// </summary>
+class EnemyCommandBuffer {
+public:
+	/// <summary>
+	/// 操作の種類
+	/// </summary>
+	enum class Type {
+		kCreateHitEffect, // position にヒットエフェクトを出す
+		kDestroy,         // enemy をシーンから外して解放する
+	};
+
+	/// <summary>
+	/// 1つの操作
+	/// </summary>
+	struct Command {
+		Type type;
+		Enemy* enemy;
+		KamataEngine::Vector3 position;
+	};
+
+	/// <summary>
+	/// 初期化（ジョブシステムのスレッド数だけ列を用意する）
+	/// </summary>
+	void Initialize();
+
+	/// <summary>
+	/// ヒットエフェクトの生成を積む
+	/// </summary>
+	void CreateHitEffect(const KamataEngine::Vector3& position);
+
+	/// <summary>
+	/// 敵の削除を積む
+	/// </summary>
+	void Destroy(Enemy* enemy);
+
+	/// <summary>
+	/// 積んだ操作をスレッドの番号順に取り出して空にする（並列の処理が終わってから呼ぶ）
+	/// </summary>
+	/// <param name="apply">apply(command) で1つの操作を反映する</param>
+	template<typename Function>
+	void Flush(const Function& apply);
+
+private:
+	/// <summary>
+	/// 呼んだスレッドの列に積む
+	/// </summary>
+	void Push(const Command& command);
+
+	// スレッドごとの列（隣のスレッドと同じキャッシュラインを書き換えないように離す）
+	// 離すための詰め物は意図したものなので C4324 は出さない
+#pragma warning(push)
+#pragma warning(disable : 4324)
+	struct alignas(64) ThreadCommands {
+		std::vector<Command> commands;
+	};
+#pragma warning(pop)
+
+	std::vector<ThreadCommands> threads_;
+};
+
+template<typename Function>
+void EnemyCommandBuffer::Flush(const Function& apply) {
+
+	for (ThreadCommands& thread : threads_) {
+		for (const Command& command : thread.commands) {
+			apply(command);
+		}
+		// 容量は残して次のフレームで使い回す
+		thread.commands.clear();
+	}
+}
@@ -0,0 +1,263 @@
+#define NOMINMAX
+#include "EnemyWalkBatch.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <emmintrin.h>
+#include <numbers>
+
+namespace {
+
+constexpr float kYawRight = -std::numbers::pi_v<float> * 2.0f; // 右向き
+constexpr float kYawLeft = std::numbers::pi_v<float>;
+
+/// <summary>
+/// 0 方向への切り捨て（floor ではなく、MapChipField の整数への変換と同じ）
+/// </summary>
+__m128 Truncate(__m128 value) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(value)); }
+
+/// <summary>
+/// mask の立っているレーンは a、それ以外は b
+/// </summary>
+__m128 Select(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+/// <summary>
+/// sin(2π * turns)（1周期を [-π/2, π/2] に畳んでから11次の多項式で近似する）
+/// </summary>
+__m128 SinTurns(__m128 turns) {
+
+	const __m128 pi = _mm_set1_ps(std::numbers::pi_v<float>);
+	const __m128 halfPi = _mm_set1_ps(std::numbers::pi_v<float> * 0.5f);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	// [-π, π] へ
+	const __m128 fraction = _mm_sub_ps(turns, _mm_cvtepi32_ps(_mm_cvtps_epi32(turns)));
+	__m128 angle = _mm_mul_ps(fraction, _mm_set1_ps(2.0f * std::numbers::pi_v<float>));
+
+	// sin(x) = sin(±π - x) で [-π/2, π/2] へ
+	const __m128 sign = _mm_and_ps(angle, signMask);
+	const __m128 magnitude = _mm_andnot_ps(signMask, angle);
+	const __m128 folded = Select(_mm_cmpgt_ps(magnitude, halfPi), _mm_sub_ps(pi, magnitude), magnitude);
+	angle = _mm_or_ps(folded, sign);
+
+	const __m128 square = _mm_mul_ps(angle, angle);
+	__m128 result = _mm_set1_ps(-1.0f / 39916800.0f);
+	result = _mm_add_ps(_mm_mul_ps(result, square), _mm_set1_ps(1.0f / 362880.0f));
+	result = _mm_add_ps(_mm_mul_ps(result, square), _mm_set1_ps(-1.0f / 5040.0f));
+	result = _mm_add_ps(_mm_mul_ps(result, square), _mm_set1_ps(1.0f / 120.0f));
+	result = _mm_add_ps(_mm_mul_ps(result, square), _mm_set1_ps(-1.0f / 6.0f));
+	result = _mm_add_ps(_mm_mul_ps(result, square), _mm_set1_ps(1.0f));
+	return _mm_mul_ps(result, angle);
+}
+
+/// <summary>
+/// 4レーン分のマスが壁か（番号はまとめて計算し、SSE2 には gather がないので引くのだけ1つずつ行う）
+/// </summary>
+__m128 SolidAt(const EnemyWalkBatch::TileGrid* tiles, __m128 column, __m128 row) {
+
+	if (!tiles) {
+		return _mm_setzero_ps();
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 width = _mm_set1_ps(static_cast<float>(tiles->width));
+	const __m128 height = _mm_set1_ps(static_cast<float>(tiles->height));
+
+	// マップの外は壁ではない
+	const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(column, zero), _mm_cmplt_ps(column, width)), _mm_and_ps(_mm_cmpge_ps(row, zero), _mm_cmplt_ps(row, height)));
+	const __m128 index = _mm_and_ps(_mm_add_ps(_mm_mul_ps(row, width), column), inside);
+
+	alignas(16) int32_t indices[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_cvttps_epi32(index));
+	const uint8_t* solid = tiles->solid.data();
+	const __m128i gathered = _mm_setr_epi32(solid[indices[0]], solid[indices[1]], solid[indices[2]], solid[indices[3]]);
+
+	return _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(gathered, _mm_setzero_si128())), inside);
+}
+
+/// <summary>
+/// マスが壁か（MapChipField::GetMapChipIndexSetByPosition と GetMapChipTypeByIndex と同じ引き方）
+/// </summary>
+bool IsSolidAt(const EnemyWalkBatch::TileGrid* tiles, float x, float y) {
+
+	if (!tiles || x + 0.5f < 0.0f || y + 0.5f < 0.0f) {
+		return false;
+	}
+	const uint32_t xIndex = static_cast<uint32_t>(x + 0.5f);
+	const uint32_t yIndex = tiles->height - 1 - static_cast<uint32_t>(y + 0.5f);
+	if (xIndex >= tiles->width || yIndex >= tiles->height) {
+		return false;
+	}
+	return tiles->solid[size_t(yIndex) * tiles->width + xIndex] != 0;
+}
+
+/// <summary>
+/// 4レーン分を進める（EnemyWalkBatch::UpdateWalker と同じ手順）
+/// </summary>
+void UpdateLanes(const EnemyWalkBatch::TileGrid* tiles, float* x, const float* y, float* velocityX, float* walkTimer, float* rotationX, float* rotationY, const int32_t* walking, uint32_t ticks,
+    uint32_t steps) {
+
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 probeOffset = _mm_set1_ps(EnemyWalkBatch::kWidth * 0.5f + EnemyWalkBatch::kEPS);
+	const __m128 chestOffset = _mm_set1_ps(EnemyWalkBatch::kHeight * 0.25f);
+	const __m128 tickCount = _mm_set1_ps(static_cast<float>(ticks));
+	const __m128 stepCount = _mm_set1_ps(static_cast<float>(steps));
+
+	const __m128 isWalking = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(walking)));
+	__m128 positionX = _mm_loadu_ps(x);
+	const __m128 positionY = _mm_loadu_ps(y);
+	__m128 velocity = _mm_loadu_ps(velocityX);
+	__m128 yaw = _mm_loadu_ps(rotationY);
+
+	// 胸と足の行は歩いている間は変わらない
+	const __m128 top = _mm_set1_ps(tiles ? static_cast<float>(tiles->height) - 1.0f : 0.0f);
+	const __m128 chestRow = _mm_sub_ps(top, Truncate(_mm_add_ps(_mm_add_ps(positionY, chestOffset), half)));
+	const __m128 feetRow = _mm_sub_ps(top, Truncate(_mm_add_ps(_mm_sub_ps(positionY, chestOffset), half)));
+
+	// 壁に当たったレーンは残りの歩数を動かない
+	__m128 moving = isWalking;
+	const __m128 dx = _mm_div_ps(_mm_mul_ps(velocity, tickCount), stepCount);
+	for (uint32_t i = 0; i < steps; ++i) {
+		const __m128 direction = _mm_or_ps(_mm_and_ps(dx, signMask), one);
+		const __m128 nextX = _mm_add_ps(positionX, dx);
+
+		// 進行方向側の2点（胸/足）で壁ヒットを検出
+		const __m128 probeX = _mm_add_ps(nextX, _mm_mul_ps(direction, probeOffset));
+		const __m128 column = Truncate(_mm_add_ps(probeX, half));
+		const __m128 hit = _mm_and_ps(_mm_or_ps(SolidAt(tiles, column, chestRow), SolidAt(tiles, column, feetRow)), moving);
+
+		// 当たったらマスの手前の辺に合わせて折り返す
+		const __m128 boundary = _mm_sub_ps(column, _mm_mul_ps(direction, half));
+		const __m128 bouncedX = _mm_sub_ps(boundary, _mm_mul_ps(direction, probeOffset));
+		positionX = Select(hit, bouncedX, Select(moving, nextX, positionX));
+
+		velocity = Select(hit, _mm_xor_ps(velocity, signMask), velocity);
+		const __m128 bouncedYaw = Select(_mm_cmpgt_ps(velocity, _mm_setzero_ps()), _mm_set1_ps(kYawRight), _mm_set1_ps(kYawLeft));
+		yaw = Select(hit, bouncedYaw, yaw);
+		moving = _mm_andnot_ps(hit, moving);
+	}
+
+	// タイマー加算（1フレームに1/60秒ずつ）と回転アニメーション
+	const __m128 timer = Select(isWalking, _mm_add_ps(_mm_loadu_ps(walkTimer), _mm_div_ps(tickCount, _mm_set1_ps(60.0f))), _mm_loadu_ps(walkTimer));
+	const __m128 param = SinTurns(_mm_mul_ps(timer, _mm_set1_ps(1.0f / EnemyWalkBatch::kWalkMotionTime)));
+	const __m128 degree = _mm_add_ps(_mm_set1_ps(EnemyWalkBatch::kWalkMotionAngleStart),
+	    _mm_mul_ps(_mm_set1_ps((EnemyWalkBatch::kWalkMotionAngleEnd - EnemyWalkBatch::kWalkMotionAngleStart) * 0.5f), _mm_add_ps(param, one)));
+	const __m128 pitch = _mm_mul_ps(degree, _mm_set1_ps(3.14159265f / 180.0f));
+
+	_mm_storeu_ps(x, positionX);
+	_mm_storeu_ps(velocityX, velocity);
+	_mm_storeu_ps(rotationY, yaw);
+	_mm_storeu_ps(walkTimer, timer);
+	_mm_storeu_ps(rotationX, Select(isWalking, pitch, _mm_loadu_ps(rotationX)));
+}
+
+} // namespace
+
+uint32_t EnemyWalkBatch::Add(const Walker& walker) {
+
+	const uint32_t lane = size_++;
+	Resize(size_);
+
+	x_[lane] = walker.x;
+	y_[lane] = walker.y;
+	velocityX_[lane] = walker.velocityX;
+	walkTimer_[lane] = walker.walkTimer;
+	rotationX_[lane] = walker.rotationX;
+	rotationY_[lane] = walker.rotationY;
+	walking_[lane] = -1;
+	return lane;
+}
+
+void EnemyWalkBatch::Remove(uint32_t lane) {
+
+	assert(lane < size_);
+	const uint32_t last = --size_;
+	x_[lane] = x_[last];
+	y_[lane] = y_[last];
+	velocityX_[lane] = velocityX_[last];
+	walkTimer_[lane] = walkTimer_[last];
+	rotationX_[lane] = rotationX_[last];
+	rotationY_[lane] = rotationY_[last];
+	walking_[lane] = walking_[last];
+
+	// 空いたレーンは飛ばされるようにしておく
+	walking_[last] = 0;
+}
+
+EnemyWalkBatch::Walker EnemyWalkBatch::Get(uint32_t lane) const {
+
+	assert(lane < size_);
+	return {x_[lane], y_[lane], velocityX_[lane], walkTimer_[lane], rotationX_[lane], rotationY_[lane]};
+}
+
+void EnemyWalkBatch::Update(uint32_t ticks) {
+
+	// 速さは全員 kWalkSpeed なので、1歩が kMaxStep を超えないように分ける数も全員同じ
+	const uint32_t steps = std::max(1u, static_cast<uint32_t>(std::ceil(kWalkSpeed * static_cast<float>(ticks) / kMaxStep)));
+
+	for (uint32_t i = 0; i < size_; i += kLaneCount) {
+		// 8体とも歩いていなければ飛ばす
+		const __m128i walking = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&walking_[i])), _mm_loadu_si128(reinterpret_cast<const __m128i*>(&walking_[i + 4])));
+		if (_mm_movemask_epi8(walking) == 0) {
+			continue;
+		}
+
+		for (uint32_t j = i; j < i + kLaneCount; j += 4) {
+			UpdateLanes(tiles_, &x_[j], &y_[j], &velocityX_[j], &walkTimer_[j], &rotationX_[j], &rotationY_[j], &walking_[j], ticks, steps);
+		}
+	}
+}
+
+void EnemyWalkBatch::UpdateWalker(const TileGrid* tiles, Walker& walker, uint32_t ticks) {
+
+	// まとめて進める時も1歩が kMaxStep を超えないように分ける
+	const float moveX = walker.velocityX * static_cast<float>(ticks);
+	const int steps = std::max(1, static_cast<int>(std::ceil(std::abs(moveX) / kMaxStep)));
+	float dx = moveX / static_cast<float>(steps);
+
+	for (int i = 0; i < steps && dx != 0.0f; ++i) {
+		const float dir = (dx > 0.0f) ? 1.0f : -1.0f;
+		const float nextX = walker.x + dx;
+
+		// 進行方向側の2点（胸/足）で壁ヒットを検出
+		const float probeX = nextX + dir * (kWidth * 0.5f + kEPS);
+		if (IsSolidAt(tiles, probeX, walker.y + kHeight * 0.25f) || IsSolidAt(tiles, probeX, walker.y - kHeight * 0.25f)) {
+			// 当たったらマスの手前の辺に合わせて折り返す
+			const float center = static_cast<float>(static_cast<uint32_t>(probeX + 0.5f));
+			const float boundary = (dir > 0.0f) ? center - 0.5f : center + 0.5f;
+			walker.x = boundary - dir * (kWidth * 0.5f + kEPS);
+
+			walker.velocityX *= -1.0f;
+			walker.rotationY = (walker.velocityX > 0.0f) ? kYawRight : kYawLeft;
+			dx = 0.0f;
+		} else {
+			walker.x = nextX;
+		}
+	}
+
+	// タイマー加算（1フレームに1/60秒ずつ）
+	walker.walkTimer += static_cast<float>(ticks) / 60.0f;
+
+	// 回転アニメーション
+	const float param = std::sin((2.0f * std::numbers::pi_v<float>)*walker.walkTimer / kWalkMotionTime);
+	const float degree = kWalkMotionAngleStart + (kWalkMotionAngleEnd - kWalkMotionAngleStart) * (param + 1.0f) / 2.0f;
+	walker.rotationX = degree * (3.14159265f / 180.0f); // 度をラジアンに変換
+}
+
+void EnemyWalkBatch::Resize(uint32_t size) {
+
+	const uint32_t capacity = (size + kLaneCount - 1) / kLaneCount * kLaneCount;
+	if (capacity <= x_.size()) {
+		return;
+	}
+
+	x_.resize(capacity, 0.0f);
+	y_.resize(capacity, 0.0f);
+	velocityX_.resize(capacity, 0.0f);
+	walkTimer_.resize(capacity, 0.0f);
+	rotationX_.resize(capacity, 0.0f);
+	rotationY_.resize(capacity, 0.0f);
+	walking_.resize(capacity, 0);
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 歩いている敵をまとめて更新する（動きは UpdateWalker の1体ずつの更新と同じ）
+/// 座標・速度・タイマー・向きを要素ごとの配列（SoA）で持ち、SSE2 で8体ずつ更新する
+/// 壁の判定もマスの番号をまとめて計算してから引く
+/// 歩いていない敵（やられ演出など）のレーンは飛ばすので、その間は敵のオブジェクト側で更新する
+/// </summary>
+class EnemyWalkBatch {
+public:
+	/// <summary>
+	/// 1体分の状態
+	/// </summary>
+	struct Walker {
+		float x = 0.0f;
+		float y = 0.0f;
+		float velocityX = 0.0f;
+		float walkTimer = 0.0f;
+		float rotationX = 0.0f;
+		float rotationY = 0.0f;
+	};
+
+	/// <summary>
+	/// 壁のマス（MapChipField と同じく大きさ 1 のマスで、0行目が一番上、マスの中心が (列, 高さ - 1 - 行)）
+	/// </summary>
+	struct TileGrid {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		// width * height 個、壁なら 1
+		std::vector<uint8_t> solid;
+	};
+
+	// 一度に更新する数
+	static constexpr uint32_t kLaneCount = 8;
+
+	// 敵の大きさと動き（Enemy もこの値を使う）
+	static constexpr float kWalkSpeed = 0.05f;
+	static constexpr float kWidth = 0.8f;
+	static constexpr float kHeight = 0.8f;
+	static constexpr float kEPS = 0.001f;
+	static constexpr float kMaxStep = 0.3f;
+	static constexpr float kWalkMotionTime = 1.0f;
+	static constexpr float kWalkMotionAngleStart = -10.0f;
+	static constexpr float kWalkMotionAngleEnd = 10.0f;
+
+	/// <summary>
+	/// 壁のマスを設定する（更新の間は生きていること）
+	/// </summary>
+	void SetTiles(const TileGrid* tiles) { tiles_ = tiles; }
+
+	/// <summary>
+	/// 歩いている敵を追加する
+	/// </summary>
+	/// <returns>レーンの番号</returns>
+	uint32_t Add(const Walker& walker);
+
+	/// <summary>
+	/// レーンを外す（最後のレーンがこの番号に移る）
+	/// </summary>
+	void Remove(uint32_t lane);
+
+	/// <summary>
+	/// レーンの状態
+	/// </summary>
+	Walker Get(uint32_t lane) const;
+
+	/// <summary>
+	/// 歩いているか（歩いていないレーンは Update で飛ばす）
+	/// </summary>
+	void SetWalking(uint32_t lane, bool walking) { walking_[lane] = walking ? -1 : 0; }
+	bool IsWalking(uint32_t lane) const { return walking_[lane] != 0; }
+
+	/// <summary>
+	/// レーンの数
+	/// </summary>
+	uint32_t GetSize() const { return size_; }
+
+	/// <summary>
+	/// 歩いているレーンを進める
+	/// </summary>
+	/// <param name="ticks">進めるティック数</param>
+	void Update(uint32_t ticks = 1);
+
+	/// <summary>
+	/// 1体だけ進める（まとめた更新が合わせる基準の動きで、ベンチマークでの比較に使う）
+	/// </summary>
+	/// <param name="tiles">壁のマス（nullptr なら壁なし）</param>
+	/// <param name="walker">進める状態</param>
+	/// <param name="ticks">進めるティック数</param>
+	static void UpdateWalker(const TileGrid* tiles, Walker& walker, uint32_t ticks = 1);
+
+private:
+	/// <summary>
+	/// 8の倍数の長さにそろえる（増えたレーンは歩いていない扱い）
+	/// </summary>
+	void Resize(uint32_t size);
+
+	const TileGrid* tiles_ = nullptr;
+	uint32_t size_ = 0;
+
+	// レーンごとの状態（長さは8の倍数）
+	std::vector<float> x_;
+	std::vector<float> y_;
+	std::vector<float> velocityX_;
+	std::vector<float> walkTimer_;
+	std::vector<float> rotationX_;
+	std::vector<float> rotationY_;
+	// 歩いていれば全ビット 1（そのままマスクに使う）
+	std::vector<int32_t> walking_;
+};
@@ -1,11 +1,10 @@
 #include "Fade.h"
+#include "TextureAtlas.h"
 
 void Fade::Initialize() {
 
-	textureHandle = TextureManager::Load("black1x1.png");
-
-	// スプライト生成
-	sprite_ = Sprite::Create(textureHandle, {0.0f, 0.0f});
+	// スプライト生成（UIアトラスから切り出す）
+	sprite_ = TextureAtlas::GetInstance()->CreateSprite("black1x1.png", {0.0f, 0.0f});
 
 	// 画面サイズに合わせてスプライトの大きさを設定（仮に1280x720とする）
 	sprite_->SetSize(Vector2(1280, 720));
@@ -16,8 +15,6 @@ void Fade::Initialize() {
 
 void Fade::Update() {
 
-	float alpha = 0.0f;
-
 	switch (status_) {
 	case Status::None:
 		// 何もしない
@@ -32,8 +29,7 @@ void Fade::Update() {
 			status_ = Status::None; // フェードイン完了
 		}
 
-		alpha = 1.0f - std::clamp(counter_ / duration_, 0.0f, 1.0f);
-		sprite_->SetColor(Vector4(0, 0, 0, alpha));
+		alpha_ = 1.0f - std::clamp(counter_ / duration_, 0.0f, 1.0f);
 
 		break;
 
@@ -46,8 +42,7 @@ void Fade::Update() {
 		counter_ = std::min(counter_, duration_);
 
 		// アルファ値を 0.0f 〜 1.0f に変化させる
-		alpha = std::clamp(counter_ / duration_, 0.0f, 1.0f);
-		sprite_->SetColor(Vector4(0, 0, 0, alpha));
+		alpha_ = std::clamp(counter_ / duration_, 0.0f, 1.0f);
 
 		break;
 	}
@@ -59,6 +54,13 @@ void Fade::Draw() {
 		return;
 	}
 
+	Draw(alpha_);
+}
+
+void Fade::Draw(float alpha) {
+
+	sprite_->SetColor(Vector4(0, 0, 0, alpha));
+
 	Sprite::PreDraw(DirectXCommon::GetInstance()->GetCommandList());
 	sprite_->Draw();
 	Sprite::PostDraw();
@@ -80,4 +82,8 @@ bool Fade::IsFinished() const {
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+Fade::~Fade() {
+	delete sprite_;
+}
@@ -22,6 +22,17 @@ public:
 
 	void Draw();
 
+	/// <summary>
+	/// アルファを指定して描画（描画スレッドからはスナップショットの値で描く）
+	/// </summary>
+	void Draw(float alpha);
+
+	// 描画するか（フェードが無い時は描かない）
+	bool IsVisible() const { return status_ != Status::None; }
+
+	// 今のアルファ
+	float GetAlpha() const { return alpha_; }
+
 	void Start(Status status, float duration);
 
 	void Stop();
@@ -29,15 +40,19 @@ public:
 	// フェード終了判定
 	bool IsFinished() const;
 
+	~Fade();
+
 private:
 	Status status_ = Status::None;
 
 	Sprite* sprite_ = nullptr;
-	uint32_t textureHandle = 0;
 
 	// フェードの持続時間
 	float duration_ = 0.0f;
 
 	// 経過時間カウンター
 	float counter_ = 0.0f;
+
+	// アルファ（スプライトには描く時に設定する）
+	float alpha_ = 1.0f;
 };
@@ -0,0 +1,98 @@
+#define NOMINMAX
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <cassert>
+
+FrameArena* FrameArena::GetInstance() {
+	static FrameArena instance;
+	return &instance;
+}
+
+void FrameArena::Initialize(size_t capacity) {
+
+	Finalize();
+
+	MemoryTagScope memoryTag(MemoryTag::kFrameArena);
+	capacity_ = capacity;
+	block_ = static_cast<std::byte*>(::operator new(capacity_, std::align_val_t(kBlockAlignment)));
+	offset_.store(0, std::memory_order_relaxed);
+	// 溢れの記録はフレームの途中で伸びないように先に取っておく
+	overflows_.reserve(64);
+}
+
+void FrameArena::Finalize() {
+
+	ReleaseOverflow();
+	std::vector<Overflow>().swap(overflows_);
+	if (block_) {
+		::operator delete(block_, std::align_val_t(kBlockAlignment));
+		block_ = nullptr;
+	}
+	capacity_ = 0;
+	offset_.store(0, std::memory_order_relaxed);
+}
+
+void FrameArena::Reset() {
+
+	const size_t used = GetUsedBytes();
+	peakBytes_ = std::max(peakBytes_, used);
+
+	// 溢れたら次のフレームからは入るようにブロックを広げる（一度きりの確保で、定常状態では起きない）
+	const bool overflowed = overflowBytes_ > 0;
+	ReleaseOverflow();
+	if (overflowed) {
+		size_t capacity = std::max<size_t>(capacity_, 1);
+		while (capacity < used) {
+			capacity *= 2;
+		}
+		Initialize(capacity * 2);
+		return;
+	}
+
+	offset_.store(0, std::memory_order_relaxed);
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+
+	// ブロックの先頭より大きい揃えは位置をずらしても満たせない
+	if (alignment > kBlockAlignment) {
+		return AllocateOverflow(bytes, alignment);
+	}
+
+	// 先頭からの位置を揃えて切り出す（ブロックの先頭は kBlockAlignment に揃っている）
+	size_t offset = offset_.load(std::memory_order_relaxed);
+	while (true) {
+		const size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+		if (!block_ || aligned + bytes > capacity_) {
+			return AllocateOverflow(bytes, alignment);
+		}
+		if (offset_.compare_exchange_weak(offset, aligned + bytes, std::memory_order_relaxed)) {
+			return block_ + aligned;
+		}
+	}
+}
+
+void* FrameArena::AllocateOverflow(size_t bytes, size_t alignment) {
+
+	MemoryTagScope memoryTag(MemoryTag::kFrameArena);
+	void* pointer = ::operator new(bytes, std::align_val_t(alignment));
+
+	std::scoped_lock lock(overflowMutex_);
+	overflows_.push_back({pointer, bytes, alignment});
+	// 揃えで溢れた分はブロックを広げても入らないので、広げる量には数えない
+	if (alignment <= kBlockAlignment) {
+		overflowBytes_ += bytes;
+	}
+	return pointer;
+}
+
+void FrameArena::ReleaseOverflow() {
+
+	std::scoped_lock lock(overflowMutex_);
+	for (const Overflow& overflow : overflows_) {
+		::operator delete(overflow.pointer, std::align_val_t(overflow.alignment));
+	}
+	overflows_.clear();
+	overflowBytes_ = 0;
+}
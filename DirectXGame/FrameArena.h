@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/// <summary>
+/// 1フレームだけ使う一時データの置き場（std::pmr のメモリリソース）
+/// 先に確保した1つのブロックを先頭から切り出すだけで、個別の解放はせずフレームの区切りの Reset でまとめて捨てる
+/// 切り出しは atomic で行うのでジョブのスレッドからも使える
+/// ブロックに入りきらなかった分は上流から確保して Reset で返し、次の Reset でその分ブロックを広げる
+/// </summary>
+class FrameArena : public std::pmr::memory_resource {
+public:
+	// 最初のブロックの大きさ
+	static constexpr size_t kDefaultCapacity = 1 << 20;
+	// ブロックの先頭の揃え（これより大きい揃えは上流から確保する）
+	static constexpr size_t kBlockAlignment = 64;
+
+	static FrameArena* GetInstance();
+
+	/// <summary>
+	/// 初期化（ブロックを確保する）
+	/// </summary>
+	/// <param name="capacity">ブロックの大きさ</param>
+	void Initialize(size_t capacity = kDefaultCapacity);
+
+	/// <summary>
+	/// 終了処理（このアリーナのメモリを持つコンテナは全て先に捨てておく）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// フレームの区切り（切り出した分を全て捨てる）
+	/// 前のフレームのデータを持つコンテナが残っていない所で呼ぶ
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 今のフレームで使った大きさ（溢れた分を含む）
+	/// </summary>
+	size_t GetUsedBytes() const { return offset_.load(std::memory_order_relaxed) + overflowBytes_; }
+
+	/// <summary>
+	/// 1フレームで使った大きさの最大
+	/// </summary>
+	size_t GetPeakBytes() const { return peakBytes_; }
+
+	/// <summary>
+	/// ブロックの大きさ
+	/// </summary>
+	size_t GetCapacity() const { return capacity_; }
+
+private:
+	FrameArena() = default;
+	~FrameArena() override { Finalize(); }
+	FrameArena(const FrameArena&) = delete;
+	const FrameArena& operator=(const FrameArena&) = delete;
+
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+	/// <summary>
+	/// ブロックに入らなかった分を上流から確保する
+	/// </summary>
+	void* AllocateOverflow(size_t bytes, size_t alignment);
+
+	/// <summary>
+	/// 溢れた分を上流に返す
+	/// </summary>
+	void ReleaseOverflow();
+
+	// 溢れた分の記録
+	struct Overflow {
+		void* pointer;
+		size_t bytes;
+		size_t alignment;
+	};
+
+	std::byte* block_ = nullptr;
+	size_t capacity_ = 0;
+	// 次に切り出す位置
+	std::atomic<size_t> offset_ = 0;
+
+	std::mutex overflowMutex_;
+	std::vector<Overflow> overflows_;
+	size_t overflowBytes_ = 0;
+
+	size_t peakBytes_ = 0;
+};
@@ -0,0 +1,174 @@
+#define NOMINMAX
+#include "FrameStats.h"
+#include "FrameArena.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
+
+namespace {
+
+float ToMilliseconds(std::chrono::steady_clock::duration duration) { return std::chrono::duration<float, std::milli>(duration).count(); }
+
+// 最近傍順位の百分位（values は並べ替えられる）
+double Percentile(std::pmr::vector<float>& values, double percent) {
+
+	if (values.empty()) {
+		return 0.0;
+	}
+	const size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(values.size())));
+	const size_t index = std::clamp<size_t>(rank, 1, values.size()) - 1;
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
+
+const char* GetPhaseName(FrameStats::Phase phase) {
+	switch (phase) {
+	case FrameStats::Phase::kUpdate:
+		return "update";
+	case FrameStats::Phase::kDraw:
+		return "draw";
+	case FrameStats::Phase::kPresent:
+		return "present";
+	default:
+		return "frame";
+	}
+}
+
+} // namespace
+
+FrameStats* FrameStats::GetInstance() {
+	static FrameStats instance;
+	return &instance;
+}
+
+void FrameStats::BeginFrame() {
+
+	const auto now = std::chrono::steady_clock::now();
+
+	// 前のフレームを確定する（フレームの長さは始まりから次の始まりまで）
+	if (started_) {
+		current_.frame = sampleCount_;
+		current_.frameMilliseconds = ToMilliseconds(now - frameStart_);
+		if (current_.frameMilliseconds > kHitchMilliseconds) {
+			++totalHitchCount_;
+		}
+		samples_[sampleCount_ % kCapacity] = current_;
+		++sampleCount_;
+	}
+
+	current_ = Sample();
+	frameStart_ = now;
+	phaseStart_ = now;
+	started_ = true;
+}
+
+void FrameStats::EndPhase(Phase phase) {
+
+	const auto now = std::chrono::steady_clock::now();
+	current_.phaseMilliseconds[static_cast<size_t>(phase)] += ToMilliseconds(now - phaseStart_);
+	phaseStart_ = now;
+}
+
+void FrameStats::AddMarker(const char* marker) {
+
+	// 1フレームに複数あれば最初のものを残す
+	if (!current_.marker) {
+		current_.marker = marker;
+	}
+}
+
+void FrameStats::CollectRecent(Phase phase, std::pmr::vector<float>& values) const {
+
+	const uint64_t count = std::min<uint64_t>(sampleCount_, kWindowFrames);
+	values.clear();
+	values.reserve(count);
+	for (uint64_t i = sampleCount_ - count; i < sampleCount_; ++i) {
+		const Sample& sample = samples_[i % kCapacity];
+		values.push_back(phase == Phase::kCount ? sample.frameMilliseconds : sample.phaseMilliseconds[static_cast<size_t>(phase)]);
+	}
+}
+
+FrameStats::Summary FrameStats::GetSummary(Phase phase) const {
+
+	// 毎フレームの表示で呼ばれるので一時的な列は FrameArena に置く
+	std::pmr::vector<float> values(FrameArena::GetInstance());
+	CollectRecent(phase, values);
+
+	Summary summary;
+	if (values.empty()) {
+		return summary;
+	}
+	summary.max = *std::max_element(values.begin(), values.end());
+	summary.p50 = Percentile(values, 50.0);
+	summary.p95 = Percentile(values, 95.0);
+	summary.p99 = Percentile(values, 99.0);
+	return summary;
+}
+
+uint32_t FrameStats::GetRecentHitchCount() const {
+
+	// 毎フレームの表示で呼ばれるので一時的な列は FrameArena に置く
+	std::pmr::vector<float> values(FrameArena::GetInstance());
+	CollectRecent(Phase::kCount, values);
+	return static_cast<uint32_t>(std::count_if(values.begin(), values.end(), [](float milliseconds) { return milliseconds > kHitchMilliseconds; }));
+}
+
+bool FrameStats::WriteCsv(const std::string& filePath) const {
+
+	std::ofstream file(filePath, std::ios_base::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	file << "frame";
+	for (size_t i = 0; i <= static_cast<size_t>(Phase::kCount); ++i) {
+		file << ',' << GetPhaseName(static_cast<Phase>(i)) << "_ms";
+	}
+	file << ",hitch,marker\n";
+
+	char line[160];
+	const uint64_t count = std::min<uint64_t>(sampleCount_, kCapacity);
+	for (uint64_t i = sampleCount_ - count; i < sampleCount_; ++i) {
+		const Sample& sample = samples_[i % kCapacity];
+		std::snprintf(line, sizeof(line), "%llu,%.3f,%.3f,%.3f,%.3f,%d,%s\n", static_cast<unsigned long long>(sample.frame), sample.phaseMilliseconds[0], sample.phaseMilliseconds[1],
+		              sample.phaseMilliseconds[2], sample.frameMilliseconds, sample.frameMilliseconds > kHitchMilliseconds ? 1 : 0, sample.marker ? sample.marker : "");
+		file << line;
+	}
+	return static_cast<bool>(file);
+}
+
+void FrameStats::DrawOverlay() const {
+#ifdef USE_IMGUI
+
+	ImGui::Begin("Frame Stats");
+	ImGui::Text("last %u frames, hitch > %.1f ms", static_cast<uint32_t>(std::min<uint64_t>(sampleCount_, kWindowFrames)), kHitchMilliseconds);
+	ImGui::Text("hitches: %u recent, %llu total", GetRecentHitchCount(), static_cast<unsigned long long>(totalHitchCount_));
+
+	if (ImGui::BeginTable("frameStats", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+		ImGui::TableSetupColumn("ms");
+		ImGui::TableSetupColumn("p50");
+		ImGui::TableSetupColumn("p95");
+		ImGui::TableSetupColumn("p99");
+		ImGui::TableSetupColumn("max");
+		ImGui::TableHeadersRow();
+		for (size_t i = 0; i <= static_cast<size_t>(Phase::kCount); ++i) {
+			const Phase phase = static_cast<Phase>(i);
+			const Summary summary = GetSummary(phase);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(GetPhaseName(phase));
+			for (double value : {summary.p50, summary.p95, summary.p99, summary.max}) {
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", value);
+			}
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+#endif
+}
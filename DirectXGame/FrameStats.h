@@ -0,0 +1,122 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// フレーム時間の記録
+/// 更新・描画・表示（PostDraw）にかかった時間をフレームごとに固定長のリングへ残し、
+/// 直近のフレームの中央値・p95・p99・最大とヒッチ（長すぎたフレーム）の数を出す
+/// 平均の FPS では隠れてしまう、シーン切り替えなどで1フレームだけ詰まるのを見つけるためのもの
+/// </summary>
+class FrameStats {
+public:
+	/// <summary>
+	/// フレームの中の区間
+	/// </summary>
+	enum class Phase {
+		kUpdate,  // エンジンの更新、シーンの切り替えと更新
+		kDraw,    // 描画のコマンド作り（ゲームシーンでは更新と重ねた後に描画スレッドを待つ時間）
+		kPresent, // PostDraw（GPU と垂直同期の待ちを含む）
+		kCount,
+	};
+
+	// リングに残すフレーム数（60fps で約4分半）
+	static constexpr uint32_t kCapacity = 1 << 14;
+	// 集計する直近のフレーム数
+	static constexpr uint32_t kWindowFrames = 600;
+	// これより長いフレームをヒッチとする（60fps の2フレーム分）
+	static constexpr double kHitchMilliseconds = 1000.0 / 60.0 * 2.0;
+
+	/// <summary>
+	/// 1フレーム分の記録
+	/// </summary>
+	struct Sample {
+		uint64_t frame = 0;
+		float phaseMilliseconds[static_cast<size_t>(Phase::kCount)] = {};
+		float frameMilliseconds = 0.0f;
+		// そのフレームに起きたこと（文字列リテラル、無ければ nullptr）
+		const char* marker = nullptr;
+	};
+
+	/// <summary>
+	/// 区間ごとの集計
+	/// </summary>
+	struct Summary {
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		double max = 0.0;
+	};
+
+	static FrameStats* GetInstance();
+
+	/// <summary>
+	/// フレームの始まり（前のフレームを確定する）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 前の区切りからここまでを phase の時間として足す
+	/// </summary>
+	void EndPhase(Phase phase);
+
+	/// <summary>
+	/// 今のフレームに印を付ける（シーンの切り替えなど、ヒッチの原因を CSV で追えるように）
+	/// </summary>
+	/// <param name="marker">文字列リテラル</param>
+	void AddMarker(const char* marker);
+
+	/// <summary>
+	/// 直近 kWindowFrames フレームの集計
+	/// </summary>
+	/// <param name="phase">区間（kCount ならフレーム全体）</param>
+	Summary GetSummary(Phase phase) const;
+
+	/// <summary>
+	/// 直近 kWindowFrames フレームのヒッチの数
+	/// </summary>
+	uint32_t GetRecentHitchCount() const;
+
+	/// <summary>
+	/// 記録を始めてからのヒッチの数
+	/// </summary>
+	uint64_t GetTotalHitchCount() const { return totalHitchCount_; }
+
+	/// <summary>
+	/// リングに残っているフレームを CSV で書き出す
+	/// </summary>
+	/// <param name="filePath">出力先</param>
+	/// <returns>書き出せたか</returns>
+	bool WriteCsv(const std::string& filePath) const;
+
+	/// <summary>
+	/// 集計を ImGui で表示する（USE_IMGUI の時だけ）
+	/// </summary>
+	void DrawOverlay() const;
+
+private:
+	FrameStats() = default;
+	~FrameStats() = default;
+	FrameStats(const FrameStats&) = delete;
+	const FrameStats& operator=(const FrameStats&) = delete;
+
+	/// <summary>
+	/// 直近のフレームの値を集める
+	/// </summary>
+	void CollectRecent(Phase phase, std::pmr::vector<float>& values) const;
+
+	std::vector<Sample> samples_ = std::vector<Sample>(kCapacity);
+	// 確定したフレームの数
+	uint64_t sampleCount_ = 0;
+
+	// 記録中のフレーム
+	Sample current_;
+	std::chrono::steady_clock::time_point frameStart_;
+	std::chrono::steady_clock::time_point phaseStart_;
+	bool started_ = false;
+
+	uint64_t totalHitchCount_ = 0;
+};
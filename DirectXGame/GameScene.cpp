@@ -1,11 +1,24 @@
 #include "GameScene.h"
+#include "AssetManager.h"
+#include "FrameArena.h"
+#include "FrameStats.h"
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "StreamingAudio.h"
+#include <algorithm>
+#include <cassert>
 
 using namespace KamataEngine;
 
 void GameScene::Initialize() {
 
+	MemoryTagScope memoryTag(MemoryTag::kGameScene);
+	AssetManager* assetManager = AssetManager::GetInstance();
+
 	// 3Dモデルデータの生成
-	model_ = Model::CreateFromOBJ("cube", true);
+	model_ = assetManager->AcquireOptimizedModel("cube", true);
+	blockBounds_ = assetManager->GetBounds(model_);
 
 	// デバックカメラの生成
 	debugCamera_ = new DebugCamera(1280, 720);
@@ -15,18 +28,19 @@ void GameScene::Initialize() {
 	camera_.Initialize();
 
 	// 天球の生成と初期化
-	modelSkydome_ = Model::CreateFromOBJ("skydome", true);
+	modelSkydome_ = assetManager->AcquireOptimizedModel("skydome", true);
 	skydome_ = new Skydome();
 	skydome_->Initialize(modelSkydome_);
 
 	// マップチップフィールド
 	mapChipField_ = new MapChipField;
 	mapChipField_->LoadMapChipCsv("Resources/AL3_mapchip_stage1_wire.csv");
+	mapChipField_->LoadSpawnCsv("Resources/AL3_mapchip_stage1_spawn.csv");
 
 	// プレイヤーの初期化
-	modelSlimeInner_ = Model::CreateFromOBJ("slime_inner", true);
-	modelSlimeOuter_ = Model::CreateFromOBJ("slime_outer", true);
-	attackPlayer_ = Model::CreateFromOBJ("attackEffect", true);
+	modelSlimeInner_ = assetManager->AcquireOptimizedModel("slime_inner", true);
+	modelSlimeOuter_ = assetManager->AcquireOptimizedModel("slime_outer", true);
+	attackPlayer_ = assetManager->AcquireOptimizedModel("attackEffect", true);
 
 	Vector3 playerPosition = mapChipField_->GetMatChipPositionByIndex(1, 18);
 
@@ -45,33 +59,37 @@ void GameScene::Initialize() {
 	cameraController_->SetMovableArea({11.0f, 88.0f, 6.5f, 100.0f});
 	cameraController_->Reset();
 
-	// Enemy モデルの生成
-	modelEnemy_ = Model::CreateFromOBJ("enemy", true);
+	// 敵の操作はジョブシステムのスレッドごとに積む
+	enemyCommands_.Initialize();
 
-	auto spawnEnemy = [&](const KamataEngine::Vector3& enemyPosition) {
-		Enemy* newEnemy = new Enemy();
+	hitEffects_.reserve(kHitEffectCapacity);
 
-		newEnemy->Initialize(modelEnemy_, &camera_, enemyPosition);
-		newEnemy->SetGameScene(this);
-		newEnemy->SetMapChipField(mapChipField_);
+	// 歩いている敵が折り返す壁のマス（マップは書き換わらないので最初に写しておく）
+	enemyWalkTiles_.width = mapChipField_->GetNumBlockHorizontal();
+	enemyWalkTiles_.height = mapChipField_->GetNumBlockVirtical();
+	enemyWalkTiles_.solid.assign(size_t(enemyWalkTiles_.width) * enemyWalkTiles_.height, 0);
+	for (uint32_t i = 0; i < enemyWalkTiles_.height; ++i) {
+		for (uint32_t j = 0; j < enemyWalkTiles_.width; ++j) {
+			enemyWalkTiles_.solid[size_t(i) * enemyWalkTiles_.width + j] = mapChipField_->GetMapChipTypeByIndex(j, i) == MapChipType::kBlock ? 1 : 0;
+		}
+	}
 
-		enemies_.push_back(newEnemy);
-	};
+	// 敵はマップの幅を区画に分けて持つ
+	enemyActivation_.Initialize(mapChipField_->GetMatChipPositionByIndex(mapChipField_->GetNumBlockHorizontal() - 1, 0).x, &enemyWalkTiles_);
 
-	maxEnemyCount_ = 6;
+	// Enemy モデルの生成
+	modelEnemy_ = assetManager->AcquireOptimizedModel("enemy", true);
 
-	spawnEnemy({14.0f, 1.0f, 0.0f});
-	spawnEnemy({22.0f, 1.0f, 0.0f});
-	spawnEnemy({35.0f, 1.0f, 0.0f});
-	spawnEnemy({44.0f, 3.0f, 0.0f});
-	spawnEnemy({56.0f, 1.0f, 0.0f});
-	spawnEnemy({64.0f, 1.0f, 0.0f});
+	// 敵は出現レイヤーから、カメラが近づいた列の分だけ出す
+	spawnedColumnBegin_ = 0;
+	spawnedColumnEnd_ = 0;
+	SpawnEnemies();
 
 	// DeathParticles モデルの生成
-	modelDeathParticles = Model::CreateFromOBJ("deathParticle", true);
+	modelDeathParticles = assetManager->AcquireOptimizedModel("deathParticle", true);
 
 	deathParticles_ = new DeathParticles();
-	deathParticles_->Initialize(modelDeathParticles, &camera_, player_->GetWorldPosition());
+	deathParticles_->Initialize(modelDeathParticles, player_->GetWorldPosition());
 
 	phase_ = Phase::kFadeIn; // フェーズ初期化
 
@@ -80,16 +98,15 @@ void GameScene::Initialize() {
 	fade_->Start(Fade::Status::FadeIn, kFadeDuration);
 
 	// ヒットエフェクト
-	modelHitEffect_ = Model::CreateFromOBJ("hitEffect", true);
+	modelHitEffect_ = assetManager->AcquireOptimizedModel("hitEffect", true);
 	HitEffect::SetModel(modelHitEffect_);
-	HitEffect::SetCamera(&camera_);
 
 	// ゴール
-	goalModel_ = Model::CreateFromOBJ("goal", true);
+	goalModel_ = assetManager->AcquireOptimizedModel("goal", true);
 	goalPos_ = mapChipField_->GetMatChipPositionByIndex(82, 18);
 	goal_.Initialize(goalPos_);
 
-	clearTextModel_ = Model::CreateFromOBJ("clear", true);
+	clearTextModel_ = assetManager->AcquireOptimizedModel("clear", true);
 	clearTextWT.Initialize();
 	clearTextWT.translation_ = goalPos_;
 	clearTextWT.translation_.x += 10.0f;
@@ -98,17 +115,25 @@ void GameScene::Initialize() {
 	clearTextWT.scale_ *= 2.0f;
 	WorldTransformUpdate(clearTextWT);
 
-	textureHandle_ = TextureManager::Load("operator.png");
+	// 操作方法はUIアトラスから切り出す
+	TextureAtlas* textureAtlas = TextureAtlas::GetInstance();
+	operatorSprite_ = textureAtlas->CreateSprite("operator.png", {0.0f, 0.0f});
+	operatorRegion_ = textureAtlas->Find("operator.png");
 
-	operatorSprite_ = Sprite::Create(textureHandle_, {0.0f, 0.0f});
+	// BGMは全て読み込まずにストリーミング再生する
+	bgmHandle_ = StreamingAudio::GetInstance()->Play("sounds/bgm.wav", true, 0.5f);
 
-	bgmHandle_ = Audio::GetInstance()->LoadWave("sounds/bgm.wav");
-
-	Audio::GetInstance()->PlayWave(bgmHandle_, true, 0.5f);
+	// 最初のフレームの描画に使うスナップショット
+	enemyActivation_.SetCameraX(camera_.translation_.x);
+	renderer_.Initialize();
+	PublishSnapshot();
 }
 
 void GameScene::Update() {
 
+	PROFILE_ZONE("GameScene::Update");
+	MemoryTagScope memoryTag(MemoryTag::kGameScene);
+
 	switch (phase_) {
 	case Phase::kFadeIn:
 		fade_->Update();
@@ -120,24 +145,13 @@ void GameScene::Update() {
 		player_->Update();
 
 		// 敵
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
+		UpdateEnemies();
 
 		cameraController_->Update();
 		camera_.UpdateMatrix();
 
 		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-				if (!worldTransformBlock) {
-					continue;
-				}
-
-				WorldTransformUpdate(*worldTransformBlock);
-			}
-		}
+		UpdateBlocks();
 
 		if (fade_->IsFinished()) {
 			phase_ = Phase::kPlay;
@@ -158,18 +172,7 @@ void GameScene::Update() {
 		player_->Update();
 
 		// 敵
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
-
-		enemies_.remove_if([](Enemy* enemy) {
-			if (enemy->GetIsDead()) {
-				delete enemy;
-				return true;
-			}
-
-			return false;
-		});
+		UpdateEnemies();
 
 		// カメラコントローラーの初期化
 		cameraController_->Update();
@@ -200,23 +203,14 @@ void GameScene::Update() {
 		}
 
 		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-				if (!worldTransformBlock) {
-					continue;
-				}
-
-				WorldTransformUpdate(*worldTransformBlock);
-			}
-		}
+		UpdateBlocks();
 
 		// ヒットエフェクト
 		for (HitEffect* hitEffect : hitEffects_) {
 			hitEffect->Update();
 		}
 
-		hitEffects_.remove_if([](HitEffect* hitEffect) {
+		std::erase_if(hitEffects_, [](HitEffect* hitEffect) {
 			if (hitEffect->isDead()) {
 				delete hitEffect;
 				return true;
@@ -226,6 +220,7 @@ void GameScene::Update() {
 
 		// 全ての当たり判定を行う
 		CheckAllCollisions();
+		ApplyEnemyCommands();
 
 		ChangePhase();
 
@@ -236,9 +231,7 @@ void GameScene::Update() {
 		skydome_->Update();
 
 		// 敵
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
+		UpdateEnemies();
 
 		// デスパーティクルの更新
 		if (deathParticles_) {
@@ -259,16 +252,7 @@ void GameScene::Update() {
 		}
 
 		// ブロックの更新
-		for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-				if (!worldTransformBlock) {
-					continue;
-				}
-
-				WorldTransformUpdate(*worldTransformBlock);
-			}
-		}
+		UpdateBlocks();
 
 		if (deathParticles_ && deathParticles_->IsFinished()) {
 			fade_->Start(Fade::Status::FadeOut, kFadeDuration);
@@ -341,19 +325,70 @@ void GameScene::Update() {
 
 		break;
 	}
+
+	PublishSnapshot();
+}
+
+void GameScene::KickDraw() {
+
+	PROFILE_ZONE("GameScene::KickDraw");
+	MemoryTagScope memoryTag(MemoryTag::kGameScene);
+
+	// 最後に出来上がったスナップショット（まだ次が無ければ前と同じものを描く）
+	snapshots_.Acquire();
+	renderer_.Kick(snapshots_.GetReadBuffer());
 }
 
 void GameScene::Draw() {
 
+	PROFILE_ZONE("GameScene::Draw");
+	MemoryTagScope memoryTag(MemoryTag::kGameScene);
+
+	const RenderSnapshot& snapshot = snapshots_.GetReadBuffer();
+
 	// DirectXCommonインスタンスの生成
 	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
 
 	Model::PreDraw(dxCommon->GetCommandList());
 
+	// ブロック・キャラクター・エフェクト・3DのUIの順にバンドルを実行する
+	renderer_.Draw();
+
+	if (snapshot.fadeVisible) {
+		fade_->Draw(snapshot.fadeAlpha);
+	}
+
+	Model::PostDraw();
+
+	// UIはまとめて描画する
+	SpriteBatch* spriteBatch = SpriteBatch::GetInstance();
+	spriteBatch->PreDraw(dxCommon->GetCommandList());
+
+	spriteBatch->Draw(*operatorSprite_, *operatorRegion_);
+
+	spriteBatch->PostDraw();
+}
+
+void GameScene::PublishSnapshot() {
+
+	PROFILE_ZONE("GameScene::PublishSnapshot");
+
+	RenderSnapshot& snapshot = snapshots_.GetWriteBuffer();
+	snapshot.Clear();
+	snapshot.SetCamera(camera_);
+
+	// 視錐台カリング
+	Frustum frustum;
+	frustum.Initialize(camera_);
+
+	// クリアの文字は UI のリストに積む
 	if (player_->GetIsClear()) {
-		clearTextModel_->Draw(clearTextWT, camera_);
+		snapshot.SetPass(RenderPass::kUI);
+		snapshot.AddModel(clearTextModel_, clearTextWT.matWorld_);
 	}
-	// ブロックの描画
+
+	// ブロック
+	snapshot.SetPass(RenderPass::kBlocks);
 	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
 		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
 
@@ -361,56 +396,60 @@ void GameScene::Draw() {
 				continue;
 			}
 
-			model_->Draw(*worldTransformBlock, camera_);
+			// 画面外のブロックは描画しない
+			if (!frustum.IsVisible(*blockBounds_, worldTransformBlock->matWorld_)) {
+				continue;
+			}
+
+			snapshot.AddModel(model_, worldTransformBlock->matWorld_);
 		}
 	}
 
-	// 天球の描画処理
-	skydome_->Draw(camera_);
+	// 天球
+	skydome_->AddToSnapshot(snapshot, frustum);
 
 	// ゴール
-	goal_.Draw(&camera_, goalModel_);
+	goal_.AddToSnapshot(snapshot, goalModel_);
 
-	// プレイヤーの描画
+	// プレイヤー
+	snapshot.SetPass(RenderPass::kCharacters);
 	if (phase_ == Phase::kFadeIn || phase_ == Phase::kPlay) {
-		player_->Draw(camera_);
+		player_->AddToSnapshot(snapshot);
 	}
 
-	// 敵
-	for (Enemy* enemy : enemies_) {
-		enemy->Draw();
-	}
+	// 敵（眠っている敵は画面の外）
+	enemyActivation_.ForEachAwake([&snapshot, &frustum](const Enemy* enemy) { enemy->AddToSnapshot(snapshot, frustum); });
 
+	snapshot.SetPass(RenderPass::kEffects);
 	if (deathParticles_) {
-		deathParticles_->Draw();
+		deathParticles_->AddToSnapshot(snapshot);
 	}
 
-	fade_->Draw();
-
 	// ヒットエフェクト
 	for (HitEffect* hitEffect : hitEffects_) {
-		hitEffect->Draw();
+		hitEffect->AddToSnapshot(snapshot, frustum);
 	}
 
-	Model::PostDraw();
-
-	Sprite::PreDraw(dxCommon->GetCommandList());
+	// フェード
+	snapshot.fadeVisible = fade_->IsVisible();
+	snapshot.fadeAlpha = fade_->GetAlpha();
 
-	operatorSprite_->Draw();
-
-	Sprite::PostDraw();
+	snapshots_.Publish();
 }
 
 GameScene::~GameScene() {
 
-	// モデルデータの解放
-	delete model_;
-
 	// デバックカメラの解放
 	delete debugCamera_;
 
-	// 3Dモデルの解放
-	delete modelSkydome_;
+	// 天球の解放
+	delete skydome_;
+
+	// プレイヤーの解放
+	delete player_;
+
+	// カメラコントローラーの解放
+	delete cameraController_;
 
 	// マップチップフィールドの解放
 	delete mapChipField_;
@@ -422,11 +461,14 @@ GameScene::~GameScene() {
 		}
 	}
 
-	delete modelEnemy_;
 	for (Enemy* enemy : enemies_) {
 		delete enemy;
 	}
 	enemies_.clear();
+	for (Enemy* enemy : enemyPool_) {
+		delete enemy;
+	}
+	enemyPool_.clear();
 
 	worldTransformBlocks_.clear();
 
@@ -434,16 +476,50 @@ GameScene::~GameScene() {
 	delete deathParticles_;
 	deathParticles_ = nullptr;
 
-	// ヒットエフェクトモデルの解放
-	delete modelHitEffect_;
+	// ヒットエフェクトの解放
 	for (HitEffect* hitEffect : hitEffects_) {
 		delete hitEffect;
 	}
 	hitEffects_.clear();
 
-	delete goalModel_;
+	delete fade_;
 
 	delete operatorSprite_;
+
+	// アセットの参照を返す（次のシーンでも使うものはAssetManagerに残る）
+	AssetManager* assetManager = AssetManager::GetInstance();
+	assetManager->ReleaseOptimizedModel(model_);
+	assetManager->ReleaseOptimizedModel(modelSkydome_);
+	assetManager->ReleaseOptimizedModel(modelSlimeInner_);
+	assetManager->ReleaseOptimizedModel(modelSlimeOuter_);
+	assetManager->ReleaseOptimizedModel(attackPlayer_);
+	assetManager->ReleaseOptimizedModel(modelEnemy_);
+	assetManager->ReleaseOptimizedModel(modelDeathParticles);
+	assetManager->ReleaseOptimizedModel(modelHitEffect_);
+	assetManager->ReleaseOptimizedModel(goalModel_);
+	assetManager->ReleaseOptimizedModel(clearTextModel_);
+
+	StreamingAudio::GetInstance()->Stop(bgmHandle_);
+}
+
+AssetManifest GameScene::GetAssetManifest() {
+
+	// Initializeで取得するアセットと揃えること
+	AssetManifest manifest;
+	// 平滑化するモデルはエンジンの平滑化（Mesh::smoothData_）を通さないよう、全て最適化済みモデルで読む
+	manifest.optimizedModels = {
+	    {"cube",          true},
+	    {"skydome",       true},
+	    {"slime_inner",   true},
+	    {"slime_outer",   true},
+	    {"attackEffect",  true},
+	    {"enemy",         true},
+	    {"deathParticle", true},
+	    {"hitEffect",     true},
+	    {"goal",          true},
+	    {"clear",         true},
+	};
+	return manifest;
 }
 
 void GameScene::GenerateBlocks() {
@@ -477,31 +553,155 @@ void GameScene::GenerateBlocks() {
 	}
 }
 
+void GameScene::UpdateEnemies() {
+
+	PROFILE_ZONE("GameScene::UpdateEnemies");
+
+	SpawnEnemies();
+
+	// カメラの近くの敵だけを起こす
+	enemyActivation_.Gather(camera_.translation_.x);
+
+	// 敵同士は互いに触らないので、歩いている敵は区画ごと、それ以外の敵は数体ずつジョブに分ける
+	constexpr uint32_t kCellsPerJob = 2;
+	constexpr uint32_t kEnemiesPerJob = 16;
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->ParallelForEach(enemyActivation_.GetCellUpdates(), kCellsPerJob, [](const EnemyActivation::CellUpdate& update) { update.walkers->Update(update.ticks); });
+	jobSystem->ParallelForEach(enemyActivation_.GetUpdates(), kEnemiesPerJob, [](const EnemyActivation::Update& update) { update.enemy->Update(update.ticks); });
+
+	enemyActivation_.Relocate();
+	ApplyEnemyCommands();
+}
+
+void GameScene::ApplyEnemyCommands() {
+
+	enemyCommands_.Flush([this](const EnemyCommandBuffer::Command& command) {
+		switch (command.type) {
+		case EnemyCommandBuffer::Type::kCreateHitEffect:
+			CreateHitEffect(command.position);
+			break;
+
+		case EnemyCommandBuffer::Type::kDestroy: {
+			// 破棄は死亡演出の終わりに1度だけ積まれる（Enemy 側で isDead_ を見ている）
+			auto it = std::find(enemies_.begin(), enemies_.end(), command.enemy);
+			assert(it != enemies_.end());
+			enemyActivation_.Remove(command.enemy);
+			enemies_.erase(it);
+			enemyPool_.push_back(command.enemy);
+			break;
+		}
+		}
+	});
+}
+
+void GameScene::SpawnEnemies() {
+
+	// カメラから左右に一定の距離までの列
+	const float left = std::max(camera_.translation_.x - kEnemySpawnDistance, 0.0f);
+	const float right = std::max(camera_.translation_.x + kEnemySpawnDistance, 0.0f);
+	const uint32_t first = mapChipField_->GetMapChipIndexSetByPosition({left, 0.0f, 0.0f}).xIndex;
+	const uint32_t last = std::min(mapChipField_->GetMapChipIndexSetByPosition({right, 0.0f, 0.0f}).xIndex, mapChipField_->GetNumBlockHorizontal() - 1);
+
+	auto spawnColumns = [this](uint32_t begin, uint32_t end) {
+		if (begin >= end) {
+			return;
+		}
+		for (const SpawnPoint& spawnPoint : mapChipField_->GetSpawnPointsByColumns(begin, end - 1)) {
+			switch (spawnPoint.type) {
+			case SpawnType::kEnemy:
+				SpawnEnemy(mapChipField_->GetMatChipPositionByIndex(spawnPoint.xIndex, spawnPoint.yIndex));
+				break;
+
+			default:
+				break;
+			}
+		}
+	};
+
+	// まだ出していない列だけを出す（出し終えた範囲の外側に広げていく）
+	if (spawnedColumnBegin_ == spawnedColumnEnd_) {
+		spawnedColumnBegin_ = first;
+		spawnedColumnEnd_ = first;
+	}
+	if (first < spawnedColumnBegin_) {
+		spawnColumns(first, spawnedColumnBegin_);
+		spawnedColumnBegin_ = first;
+	}
+	if (last + 1 > spawnedColumnEnd_) {
+		spawnColumns(spawnedColumnEnd_, last + 1);
+		spawnedColumnEnd_ = last + 1;
+	}
+}
+
+void GameScene::SpawnEnemy(const Vector3& position) {
+
+	Enemy* enemy = nullptr;
+	if (!enemyPool_.empty()) {
+		enemy = enemyPool_.back();
+		enemyPool_.pop_back();
+	} else {
+		enemy = new Enemy();
+		enemy->SetCommandBuffer(&enemyCommands_);
+	}
+
+	enemy->Initialize(modelEnemy_, position);
+
+	enemies_.push_back(enemy);
+	enemyActivation_.Add(enemy);
+}
+
+void GameScene::UpdateBlocks() {
+
+	PROFILE_ZONE("GameScene::UpdateBlocks");
+
+	// 行列の計算と転送はブロックごとに独立しているので、数行ずつジョブに分ける
+	constexpr uint32_t kRowsPerJob = 4;
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(worldTransformBlocks_.size()), kRowsPerJob, [this](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			for (WorldTransform* worldTransformBlock : worldTransformBlocks_[i]) {
+
+				if (!worldTransformBlock) {
+					continue;
+				}
+
+				WorldTransformUpdate(*worldTransformBlock);
+			}
+		}
+	});
+}
+
 void GameScene::CheckAllCollisions() {
 
+	PROFILE_ZONE("GameScene::CheckAllCollisions");
+
 	// 判定対象1と2の座標
 	AABB aabb1, aabb2;
 
 	// 自キャラの座標
 	aabb1 = player_->GetAABB();
 
-	// 自キャラと敵弾全ての当たり判定
-	for (Enemy* enemy : enemies_) {
-
+	// 自キャラと敵弾全ての当たり判定（当たった敵を集めてから衝突時関数を呼ぶ。一時的な列なので FrameArena に置く）
+	// 自キャラはカメラの近くにいるので、毎ティック更新している区画の敵だけを調べる
+	std::pmr::vector<Enemy*> hitEnemies(FrameArena::GetInstance());
+	enemyActivation_.ForEachActive([&](Enemy* enemy) {
 		if (enemy->IsCollisionDisabled())
-			continue; // コリジョン無効の敵はスキップ
+			return; // コリジョン無効の敵はスキップ
 
 		// 敵弾の座標
 		aabb2 = enemy->GetAABB();
 
 		// AABB同士の交差判定
 		if (IsCollision(aabb1, aabb2)) {
-			// 自キャラの衝突時関数を呼び出す
-			player_->OnCollision(enemy);
-
-			// 敵の衝突時関数を呼び出す
-			enemy->OnCollision(player_);
+			hitEnemies.push_back(enemy);
 		}
+	});
+
+	for (Enemy* enemy : hitEnemies) {
+		// 自キャラの衝突時関数を呼び出す
+		player_->OnCollision(enemy);
+
+		// 敵の衝突時関数を呼び出す
+		enemy->OnCollision(player_);
 	}
 
 	// 自キャラとゴールの当たり判定
@@ -527,14 +727,16 @@ void GameScene::ChangePhase() {
 			const Vector3 deathParticlesPosition = player_->GetWorldPosition();
 
 			// デスパーティクルの生成と初期化
+			FrameStats::GetInstance()->AddMarker("DeathParticles");
 			deathParticles_ = new DeathParticles();
-			deathParticles_->Initialize(modelDeathParticles, &camera_, deathParticlesPosition);
+			deathParticles_->Initialize(modelDeathParticles, deathParticlesPosition);
 		}
 
 		if (player_->GetIsClear()) {
 
 			phase_ = Phase::kClear;
 			clearTimer_ = 0.0f;
+			StreamingAudio::GetInstance()->PlaySoundEffect("fanfare.wav");
 		}
 
 		break;
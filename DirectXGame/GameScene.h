@@ -1,16 +1,23 @@
 #pragma once
 
 #define NOMINMAX
+#include "AssetManager.h"
 #include "CameraController.h"
 #include "DeathParticles.h"
 #include "Enemy.h"
+#include "EnemyActivation.h"
 #include "Fade.h"
 #include "Goal.h"
 #include "HitEffect.h"
 #include "KamataEngine.h"
 #include "MapChipField.h"
 #include "Player.h"
+#include "RenderSnapshot.h"
+#include "SceneRenderer.h"
 #include "Skydome.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+#include "TripleBuffer.h"
 #include "WorldMatrixTransform.h"
 #include <Windows.h>
 #include <vector>
@@ -21,10 +28,23 @@ public:
 	// 初期化
 	void Initialize();
 
-	// 更新
+	// 更新（終わりに描画用のスナップショットを出す）
 	void Update();
 
-	// 描画
+	/// <summary>
+	/// 最後に出来上がったスナップショットのモデルを、ジョブで並列に記録し始める（メインスレッドから、描画スレッドに Draw を渡す前に呼ぶ）
+	/// </summary>
+	void KickDraw();
+
+	/// <summary>
+	/// KickDraw で始めた記録を手伝いながら待つ（メインスレッドから呼ぶ）
+	/// </summary>
+	void WaitDraw() { renderer_.Wait(); }
+
+	/// <summary>
+	/// 描画（描画スレッドから、次の Update と並んで呼ばれる）
+	/// KickDraw で取ったスナップショットだけを読み、更新中のオブジェクトには触らない
+	/// </summary>
 	void Draw();
 
 	/// <summary>
@@ -41,8 +61,46 @@ public:
 
 	void ChangePhase();
 
+	/// <summary>
+	/// 敵の更新（ジョブで並列に行い、終わってから積まれた操作を反映する）
+	/// </summary>
+	void UpdateEnemies();
+
+	/// <summary>
+	/// カメラが近づいた列の出現位置から敵を出す（どの列も1度だけ）
+	/// </summary>
+	void SpawnEnemies();
+
+	/// <summary>
+	/// 敵をプールから取り出して出す
+	/// </summary>
+	void SpawnEnemy(const KamataEngine::Vector3& position);
+
+	/// <summary>
+	/// 敵が積んだ操作（ヒットエフェクトの生成と削除）を反映する
+	/// </summary>
+	void ApplyEnemyCommands();
+
+	/// <summary>
+	/// ブロックの行列更新（行ごとにジョブで並列に行う）
+	/// </summary>
+	void UpdateBlocks();
+
+	/// <summary>
+	/// 描画に要る状態をスナップショットに写して描画側に渡す（視錐台カリングもここで行う）
+	/// </summary>
+	void PublishSnapshot();
+
 	bool IsFinished() const { return finished_; }
 
+	// フェードアウト中か（次シーンの先読み開始に使う）
+	bool IsFadingOut() const { return phase_ == Phase::kFadeOut; }
+
+	/// <summary>
+	/// このシーンで使うアセット一覧
+	/// </summary>
+	static AssetManifest GetAssetManifest();
+
 	void CreateHitEffect(const Vector3& origin);
 
 private:
@@ -60,7 +118,9 @@ private:
 	Phase phase_ = Phase::kFadeIn;
 
 	// モデルデータ
-	KamataEngine::Model* model_ = nullptr;
+	OptimizedModel* model_ = nullptr;
+	// ブロックモデルの境界ボリューム
+	const ModelBounds* blockBounds_ = nullptr;
 
 	// ブロック用ワールドトランスフォーム
 	std::vector<std::vector<KamataEngine::WorldTransform*>> worldTransformBlocks_;
@@ -76,13 +136,13 @@ private:
 
 	// 天球
 	Skydome* skydome_ = nullptr;
-	KamataEngine::Model* modelSkydome_ = nullptr;
+	OptimizedModel* modelSkydome_ = nullptr;
 
 	// プレイヤー
 	Player* player_ = nullptr;
-	KamataEngine::Model* modelSlimeOuter_ = nullptr;
-	KamataEngine::Model* modelSlimeInner_ = nullptr;
-	KamataEngine::Model* attackPlayer_ = nullptr;
+	OptimizedModel* modelSlimeOuter_ = nullptr;
+	OptimizedModel* modelSlimeInner_ = nullptr;
+	OptimizedModel* attackPlayer_ = nullptr;
 
 	// マップチップフィールド
 	MapChipField* mapChipField_;
@@ -91,11 +151,23 @@ private:
 	CameraController* cameraController_ = nullptr;
 
 	// Enemy
-	uint32_t maxEnemyCount_;
-	std::list<Enemy*> enemies_;
-	KamataEngine::Model* modelEnemy_ = nullptr;
-
-	KamataEngine::Model* modelDeathParticles = nullptr;
+	std::vector<Enemy*> enemies_;
+	// 倒された敵を次に出すまで取っておく
+	std::vector<Enemy*> enemyPool_;
+	// 敵を出し終えた列の範囲 [begin, end)（カメラの動いた範囲なので1続きになる）
+	uint32_t spawnedColumnBegin_ = 0;
+	uint32_t spawnedColumnEnd_ = 0;
+	// カメラからこの距離までの列の敵を出す（眠らせる距離と揃えて、画面の外で出す）
+	static inline const float kEnemySpawnDistance = EnemyActivation::kCellWidth * EnemyActivation::kReducedCellRadius;
+	// 敵の更新中に出たシーンへの操作
+	EnemyCommandBuffer enemyCommands_;
+	// カメラからの距離で決める敵の起こし方（遠くの敵は更新も判定も描画もしない）
+	EnemyActivation enemyActivation_;
+	// 歩いている敵をまとめて更新する時に引く壁のマス
+	EnemyWalkBatch::TileGrid enemyWalkTiles_;
+	OptimizedModel* modelEnemy_ = nullptr;
+
+	OptimizedModel* modelDeathParticles = nullptr;
 	DeathParticles* deathParticles_ = nullptr;
 
 	bool finished_ = false;
@@ -103,24 +175,30 @@ private:
 	Fade* fade_ = nullptr;
 	const float kFadeDuration = 1.0f;
 
-	// ヒットエフェクト
-	std::list<HitEffect*> hitEffects_;
-	KamataEngine::Model* modelHitEffect_ = nullptr;
+	// ヒットエフェクト（毎フレームの追加と削除でノードを確保しないよう配列で持ち、容量は先に取っておく）
+	std::vector<HitEffect*> hitEffects_;
+	const size_t kHitEffectCapacity = 32;
+	OptimizedModel* modelHitEffect_ = nullptr;
 
 	// ゴール
 	Goal goal_;
-	KamataEngine::Model* goalModel_ = nullptr;
+	OptimizedModel* goalModel_ = nullptr;
 	KamataEngine::Vector3 goalPos_{};
 	float clearTimer_ = 0.0f;
 	const float clearMaxTime_ = 0.5f;
 
-	KamataEngine::Model* clearTextModel_ = nullptr;
+	OptimizedModel* clearTextModel_ = nullptr;
 	KamataEngine::WorldTransform clearTextWT;
 
 	// 操作方法
 	KamataEngine::Sprite* operatorSprite_ = nullptr;
-	uint32_t textureHandle_ = 0;
+	const TextureAtlas::Region* operatorRegion_ = nullptr;
 
 	// BGM
 	uint32_t bgmHandle_ = 0;
+
+	// 更新側から描画スレッドへのスナップショットの受け渡し
+	TripleBuffer<RenderSnapshot> snapshots_;
+	// スナップショットのモデルの描画（記録はジョブ、実行は描画スレッドが行う）
+	SceneRenderer renderer_;
 };
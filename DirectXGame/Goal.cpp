@@ -37,15 +37,4 @@ Vector3 Goal::GetWorldPosition() const {
 
 void Goal::Update() { WorldTransformUpdate(worldTransform_); }
 
-void Goal::Draw(Camera* camera, Model* model) {
-
-	// DirectXCommonインスタンスの生成
-	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
-
-	Model::PreDraw(dxCommon->GetCommandList());
-
-	// 3Dモデル描画
-	model->Draw(worldTransform_, *camera);
-
-	Model::PostDraw();
-}
+void Goal::AddToSnapshot(RenderSnapshot& snapshot, OptimizedModel* model) const { snapshot.AddModel(model, worldTransform_.matWorld_); }
@@ -1,5 +1,6 @@
 #pragma once
 #include "AABB.h"
+#include "RenderSnapshot.h"
 #include "WorldMatrixTransform.h"
 #include <KamataEngine.h>
 
@@ -16,7 +17,8 @@ public:
 
 	void Update();
 
-	void Draw(Camera* camera, Model* model);
+	// 描画するモデルをスナップショットに積む
+	void AddToSnapshot(RenderSnapshot& snapshot, OptimizedModel* model) const;
 
 	void SetScale(const Vector3& scale) { worldTransform_.scale_ = scale; }
 
@@ -1,12 +1,13 @@
 #include "HitEffect.h"
+#include "AssetManager.h"
 #include <algorithm>
 #include <numbers>
 #include <random>
 #include<cassert>
 
 // 静的メンバ変数の実体
-Model* HitEffect::model_ = nullptr;
-Camera* HitEffect::camera_ = nullptr;
+OptimizedModel* HitEffect::model_ = nullptr;
+const ModelBounds* HitEffect::bounds_ = nullptr;
 
 namespace {
 inline float EaseOutCubic(float t) {
@@ -16,6 +17,11 @@ inline float EaseOutCubic(float t) {
 }
 } // namespace
 
+void HitEffect::SetModel(OptimizedModel* model) {
+	model_ = model;
+	bounds_ = AssetManager::GetInstance()->GetBounds(model);
+}
+
 void HitEffect::Initialize(const Vector3& origin) {
 
 	// 円形
@@ -96,22 +102,25 @@ void HitEffect::Update() {
 	}
 }
 
-void HitEffect::Draw() {
-
-	// DirectXCommonインスタンスの生成
-	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
-
-	Model::PreDraw(dxCommon->GetCommandList());
-
-	model_->SetAlpha(opacity_);
+void HitEffect::AddToSnapshot(RenderSnapshot& snapshot, const Frustum& frustum) const {
 
-	for (WorldTransform& worldTransform : ellipseWorldTransforms_) {
-		model_->Draw(worldTransform, *camera_);
+	// 画面外なら描画しない
+	if (bounds_) {
+		bool isVisible = frustum.IsVisible(*bounds_, circleWorldTransform_.matWorld_);
+		for (const WorldTransform& worldTransform : ellipseWorldTransforms_) {
+			isVisible = isVisible || frustum.IsVisible(*bounds_, worldTransform.matWorld_);
+		}
+		if (!isVisible) {
+			return;
+		}
 	}
 
-	model_->Draw(circleWorldTransform_, *camera_);
+	// アルファはモデルに設定するので、描画側で描く直前に設定する
+	for (const WorldTransform& worldTransform : ellipseWorldTransforms_) {
+		snapshot.AddModel(model_, worldTransform.matWorld_).modelAlpha = opacity_;
+	}
 
-	Model::PostDraw();
+	snapshot.AddModel(model_, circleWorldTransform_.matWorld_).modelAlpha = opacity_;
 }
 
 HitEffect* HitEffect::Create(const Vector3& origin) {
@@ -1,4 +1,6 @@
 #pragma once
+#include "Culling.h"
+#include "RenderSnapshot.h"
 #include "WorldMatrixTransform.h"
 #include <KamataEngine.h>
 
@@ -11,11 +13,12 @@ public:
 
 	void Update();
 
-	void Draw();
+	/// <summary>
+	/// 描画するモデルをスナップショットに積む（どの部分も視錐台の外なら何もしない）
+	/// </summary>
+	void AddToSnapshot(RenderSnapshot& snapshot, const Frustum& frustum) const;
 
-	static void SetModel(Model* model) { model_ = model; }
-
-	static void SetCamera(Camera* camera) { camera_ = camera; }
+	static void SetModel(OptimizedModel* model);
 
 	static HitEffect* Create(const Vector3& origin);
 
@@ -36,10 +39,10 @@ private:
 	float opacity_ = 1.0f;
 
 	// モデル(借りてくる用)
-	static Model* model_;
+	static OptimizedModel* model_;
 
-	// カメラ(借りてくる用)
-	static Camera* camera_;
+	// モデルの境界ボリューム
+	static const ModelBounds* bounds_;
 
 	// 円形エフェクト
 	WorldTransform circleWorldTransform_;
@@ -0,0 +1,236 @@
+#define NOMINMAX
+#include "ImaAdpcm.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// 量子化の幅
+constexpr int16_t kStepTable[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,    31,    34,    37,    41,    45,    50,    55,    60,
+    66,    73,    80,    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,   544,
+    598,   658,   724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,
+    5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+// 符号ごとのステップ番号の増減
+constexpr int8_t kIndexTable[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+// チャンネルあたりのヘッダの大きさ
+constexpr uint32_t kHeaderSize = 4;
+// データはチャンネルごとに8サンプル（4バイト）ずつ交互に並ぶ
+constexpr uint32_t kSamplesPerWord = 8;
+constexpr uint32_t kBytesPerWord = 4;
+
+/// <summary>
+/// 1チャンネル分の符号化・復号の状態
+/// </summary>
+struct State {
+	int32_t predictor = 0;
+	int32_t stepIndex = 0;
+};
+
+int16_t DecodeNibble(State& state, uint8_t nibble) {
+
+	const int32_t step = kStepTable[state.stepIndex];
+	int32_t difference = step >> 3;
+	if (nibble & 4) {
+		difference += step;
+	}
+	if (nibble & 2) {
+		difference += step >> 1;
+	}
+	if (nibble & 1) {
+		difference += step >> 2;
+	}
+	state.predictor = std::clamp(nibble & 8 ? state.predictor - difference : state.predictor + difference, -32768, 32767);
+	state.stepIndex = std::clamp(state.stepIndex + kIndexTable[nibble], 0, 88);
+	return static_cast<int16_t>(state.predictor);
+}
+
+uint8_t EncodeSample(State& state, int32_t sample) {
+
+	const int32_t step = kStepTable[state.stepIndex];
+	int32_t difference = sample - state.predictor;
+	uint8_t nibble = 0;
+	if (difference < 0) {
+		nibble = 8;
+		difference = -difference;
+	}
+
+	// 復号と同じ丸めで差分を3bitに量子化する
+	int32_t threshold = step;
+	for (uint8_t bit = 4; bit > 0; bit >>= 1) {
+		if (difference >= threshold) {
+			nibble |= bit;
+			difference -= threshold;
+		}
+		threshold >>= 1;
+	}
+
+	// 予測値は復号側と同じ計算で進める
+	DecodeNibble(state, nibble);
+	return nibble;
+}
+
+int16_t ToInt16(float sample) { return static_cast<int16_t>(std::lround(std::clamp(sample, -1.0f, 1.0f) * 32767.0f)); }
+
+} // namespace
+
+namespace ImaAdpcm {
+
+uint32_t GetSamplesPerBlock(uint32_t blockAlign, uint32_t channels) { return (blockAlign - kHeaderSize * channels) * 2 / channels + 1; }
+
+uint32_t GetDefaultBlockAlign(uint32_t channels) { return 256 * channels; }
+
+std::vector<uint8_t> Encode(const float* samples, uint32_t frameCount, uint32_t channels, uint32_t blockAlign) {
+
+	assert(channels == 1 || channels == 2);
+	const uint32_t samplesPerBlock = GetSamplesPerBlock(blockAlign, channels);
+	const uint32_t blockCount = (frameCount + samplesPerBlock - 1) / samplesPerBlock;
+
+	std::vector<uint8_t> data(size_t(blockCount) * blockAlign, 0);
+
+	// ステップ番号はブロックをまたいで引き継ぐ（ブロックの頭で音が荒れない）
+	State states[2];
+	auto sampleAt = [&](uint32_t frame, uint32_t channel) -> int32_t { return frame < frameCount ? ToInt16(samples[size_t(frame) * channels + channel]) : 0; };
+
+	for (uint32_t block = 0; block < blockCount; ++block) {
+		uint8_t* destination = data.data() + size_t(block) * blockAlign;
+		const uint32_t firstFrame = block * samplesPerBlock;
+
+		// ヘッダ（最初のサンプルはそのまま入れる）
+		for (uint32_t channel = 0; channel < channels; ++channel) {
+			State& state = states[channel];
+			state.predictor = sampleAt(firstFrame, channel);
+			uint8_t* header = destination + channel * kHeaderSize;
+			header[0] = static_cast<uint8_t>(state.predictor & 0xFF);
+			header[1] = static_cast<uint8_t>((state.predictor >> 8) & 0xFF);
+			header[2] = static_cast<uint8_t>(state.stepIndex);
+			header[3] = 0;
+		}
+
+		// 8サンプルずつチャンネルを交互に
+		uint8_t* word = destination + kHeaderSize * channels;
+		for (uint32_t frame = 1; frame < samplesPerBlock; frame += kSamplesPerWord) {
+			for (uint32_t channel = 0; channel < channels; ++channel) {
+				for (uint32_t i = 0; i < kSamplesPerWord; i += 2) {
+					const uint8_t low = EncodeSample(states[channel], sampleAt(firstFrame + frame + i, channel));
+					const uint8_t high = EncodeSample(states[channel], sampleAt(firstFrame + frame + i + 1, channel));
+					word[i / 2] = static_cast<uint8_t>(low | high << 4);
+				}
+				word += kBytesPerWord;
+			}
+		}
+	}
+	return data;
+}
+
+void Decode(const uint8_t* data, uint32_t channels, uint32_t blockAlign, uint32_t firstFrame, uint32_t frameCount, float* output) {
+
+	Decoder decoder;
+	decoder.Reset(data, channels, blockAlign);
+	decoder.Seek(firstFrame);
+	decoder.Read(output, frameCount);
+}
+
+void Decoder::Reset(const uint8_t* data, uint32_t channels, uint32_t blockAlign) {
+
+	assert(channels >= 1 && channels <= kMaxChannels);
+	data_ = data;
+	channels_ = channels;
+	blockAlign_ = blockAlign;
+	samplesPerBlock_ = GetSamplesPerBlock(blockAlign, channels);
+	// ブロック内の組が8フレームずつ割り切れる形式だけ扱う
+	assert((samplesPerBlock_ - 1) % kGroupFrames == 0);
+
+	block_ = 0;
+	blockFrame_ = 0;
+	firstFrame_ = 0;
+	frameCount_ = 0;
+	position_ = 0;
+}
+
+void Decoder::Seek(uint32_t frame) {
+
+	position_ = frame;
+
+	// 手元にあるか、次の組と同じブロックの先なら続きから復号する
+	if (frameCount_ > 0 && frame >= firstFrame_ && (frame < firstFrame_ + frameCount_ || frame / samplesPerBlock_ == block_)) {
+		return;
+	}
+
+	// それ以外はブロックの頭からやり直す
+	block_ = frame / samplesPerBlock_;
+	blockFrame_ = 0;
+	firstFrame_ = block_ * samplesPerBlock_;
+	frameCount_ = 0;
+}
+
+void Decoder::Read(float* output, uint32_t frameCount) {
+
+	while (frameCount > 0) {
+		// 読む位置まで組を進める（手前の組は状態を進めるだけ）
+		while (position_ >= firstFrame_ + frameCount_) {
+			DecodeGroup();
+		}
+
+		const uint32_t index = position_ - firstFrame_;
+		const uint32_t count = std::min(frameCount, frameCount_ - index);
+		std::copy_n(frames_ + size_t(index) * channels_, size_t(count) * channels_, output);
+
+		output += size_t(count) * channels_;
+		position_ += count;
+		frameCount -= count;
+	}
+}
+
+void Decoder::DecodeGroup() {
+
+	// 1つ前の組の最後のフレームを先頭に残す
+	uint32_t base = 0;
+	if (frameCount_ > 0) {
+		std::copy_n(frames_ + size_t(frameCount_ - 1) * channels_, channels_, frames_);
+		base = 1;
+	}
+	firstFrame_ = block_ * samplesPerBlock_ + blockFrame_ - base;
+
+	constexpr float kScale = 1.0f / 32768.0f;
+	const uint8_t* source = data_ + size_t(block_) * blockAlign_;
+
+	if (blockFrame_ == 0) {
+		// ブロックの頭はヘッダのサンプルそのもの
+		for (uint32_t channel = 0; channel < channels_; ++channel) {
+			const uint8_t* header = source + channel * kHeaderSize;
+			predictors_[channel] = static_cast<int16_t>(header[0] | header[1] << 8);
+			stepIndices_[channel] = std::min<int32_t>(header[2], 88);
+			frames_[base * channels_ + channel] = static_cast<float>(predictors_[channel]) * kScale;
+		}
+		frameCount_ = base + 1;
+		blockFrame_ = 1;
+		return;
+	}
+
+	// 組はチャンネルごとに4バイト（8サンプル）ずつ並ぶ
+	const uint8_t* word = source + kHeaderSize * channels_ + size_t(blockFrame_ - 1) / kSamplesPerWord * kBytesPerWord * channels_;
+	for (uint32_t channel = 0; channel < channels_; ++channel) {
+		State state{predictors_[channel], stepIndices_[channel]};
+		for (uint32_t i = 0; i < kSamplesPerWord; ++i) {
+			const uint8_t nibble = (word[i / 2] >> ((i & 1) * 4)) & 0x0F;
+			frames_[(base + i) * channels_ + channel] = static_cast<float>(DecodeNibble(state, nibble)) * kScale;
+		}
+		predictors_[channel] = state.predictor;
+		stepIndices_[channel] = state.stepIndex;
+		word += kBytesPerWord;
+	}
+	frameCount_ = base + kGroupFrames;
+
+	blockFrame_ += kGroupFrames;
+	if (blockFrame_ >= samplesPerBlock_) {
+		++block_;
+		blockFrame_ = 0;
+	}
+}
+
+} // namespace ImaAdpcm
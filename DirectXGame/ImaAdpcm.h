@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// IMA-ADPCM（WAVE_FORMAT_IMA_ADPCM と同じブロック形式）の符号化と復号
+/// 16bit PCM の 1/4 の大きさで、ブロックごとに単独で復号できる
+/// ブロックはチャンネルごとに4バイトのヘッダ（最初のサンプルとステップ番号）と、
+/// チャンネルごとに8サンプル（4バイト）ずつ交互に並んだ4bitのデータからなる
+/// </summary>
+namespace ImaAdpcm {
+
+// 波形の種類（WAVE_FORMAT_IMA_ADPCM）
+constexpr uint16_t kFormatImaAdpcm = 0x0011;
+
+/// <summary>
+/// 1ブロックのサンプル数（チャンネルあたり）
+/// </summary>
+uint32_t GetSamplesPerBlock(uint32_t blockAlign, uint32_t channels);
+
+/// <summary>
+/// ブロックの大きさ（チャンネルあたり256バイトにする）
+/// </summary>
+uint32_t GetDefaultBlockAlign(uint32_t channels);
+
+/// <summary>
+/// 符号化
+/// </summary>
+/// <param name="samples">インターリーブの float サンプル（-1〜1）</param>
+/// <param name="frameCount">フレーム数</param>
+/// <param name="channels">チャンネル数（1 か 2）</param>
+/// <param name="blockAlign">ブロックの大きさ</param>
+/// <returns>ブロックを並べたもの（最後のブロックは無音で埋める）</returns>
+std::vector<uint8_t> Encode(const float* samples, uint32_t frameCount, uint32_t channels, uint32_t blockAlign);
+
+/// <summary>
+/// 指定した範囲のフレームを float に復号する（Decoder を1回だけ使う）
+/// </summary>
+/// <param name="data">ブロックを並べたもの</param>
+/// <param name="channels">チャンネル数（1 か 2）</param>
+/// <param name="blockAlign">ブロックの大きさ</param>
+/// <param name="firstFrame">最初のフレーム</param>
+/// <param name="frameCount">フレーム数</param>
+/// <param name="output">インターリーブの float 出力（frameCount × channels 個）</param>
+void Decode(const uint8_t* data, uint32_t channels, uint32_t blockAlign, uint32_t firstFrame, uint32_t frameCount, float* output);
+
+/// <summary>
+/// 続きから順に読む復号器
+/// 8フレームの組ごとに復号して手元に置き、直前の組の最後の1フレームまでは戻って読み直せる
+/// 同じブロックの中で先に進む時は頭から復号し直さない
+/// </summary>
+class Decoder {
+public:
+	// 扱えるチャンネル数
+	static constexpr uint32_t kMaxChannels = 2;
+	// データの組のフレーム数
+	static constexpr uint32_t kGroupFrames = 8;
+
+	/// <summary>
+	/// 読むデータを設定して先頭に戻す
+	/// </summary>
+	/// <param name="data">ブロックを並べたもの</param>
+	/// <param name="channels">チャンネル数（1 か 2）</param>
+	/// <param name="blockAlign">ブロックの大きさ</param>
+	void Reset(const uint8_t* data, uint32_t channels, uint32_t blockAlign);
+
+	/// <summary>
+	/// 次に読むフレームを移す（手元か同じブロックの先なら続きから、それ以外はブロックの頭から復号し直す）
+	/// </summary>
+	void Seek(uint32_t frame);
+
+	/// <summary>
+	/// 続きを読む
+	/// </summary>
+	/// <param name="output">インターリーブの float 出力（frameCount × channels 個）</param>
+	/// <param name="frameCount">フレーム数</param>
+	void Read(float* output, uint32_t frameCount);
+
+	/// <summary>
+	/// 次に読むフレーム
+	/// </summary>
+	uint32_t GetPosition() const { return position_; }
+
+private:
+	/// <summary>
+	/// 次の組（ブロックの頭なら最初のサンプルだけ）を復号して手元に置く
+	/// </summary>
+	void DecodeGroup();
+
+	const uint8_t* data_ = nullptr;
+	uint32_t channels_ = 0;
+	uint32_t blockAlign_ = 0;
+	uint32_t samplesPerBlock_ = 0;
+
+	// 次に復号する組のブロックと、ブロック内のフレーム
+	uint32_t block_ = 0;
+	uint32_t blockFrame_ = 0;
+	// チャンネルごとの予測値とステップ番号
+	int32_t predictors_[kMaxChannels] = {};
+	int32_t stepIndices_[kMaxChannels] = {};
+
+	// 手元の復号済みフレーム（先頭は1つ前の組の最後のフレーム）
+	float frames_[(kGroupFrames + 1) * kMaxChannels] = {};
+	// frames_[0] のフレーム番号と、手元にある数
+	uint32_t firstFrame_ = 0;
+	uint32_t frameCount_ = 0;
+	// 次に読むフレーム
+	uint32_t position_ = 0;
+};
+
+} // namespace ImaAdpcm
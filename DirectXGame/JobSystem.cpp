@@ -0,0 +1,291 @@
+#define NOMINMAX
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+// 後続の待ちを閉じた印（この後に並べようとしたジョブはすぐ積む）
+Job gClosedListMarker;
+Job* const kClosedList = &gClosedListMarker;
+
+// 呼んだスレッドのワーカー番号
+thread_local uint32_t tThreadIndex = JobSystem::kNotWorker;
+
+// 寝る前に他のキューを探し直す回数
+constexpr uint32_t kSpinCount = 64;
+
+} // namespace
+
+JobCounter::JobCounter() : waiters_(kClosedList) {}
+
+bool JobCounter::IsDone() const { return count_.load(std::memory_order_acquire) == 0 && waiters_.load(std::memory_order_acquire) == kClosedList; }
+
+JobSystem::WorkStealingQueue::WorkStealingQueue() : jobs_(kMaxJobsPerThread) {}
+
+bool JobSystem::WorkStealingQueue::Push(Job* job) {
+
+	const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+	const int64_t top = top_.load(std::memory_order_acquire);
+	if (bottom - top >= static_cast<int64_t>(kMaxJobsPerThread)) {
+		return false;
+	}
+
+	jobs_[bottom & (kMaxJobsPerThread - 1)].store(job, std::memory_order_relaxed);
+	// ジョブの中身を書き終えてから盗む側に見せる
+	bottom_.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+Job* JobSystem::WorkStealingQueue::Pop() {
+
+	const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+	bottom_.store(bottom, std::memory_order_relaxed);
+	// 後ろを1つ減らしたのを、盗む側が前を読むより先に見せる
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = top_.load(std::memory_order_relaxed);
+
+	if (top > bottom) {
+		// 空だった
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = jobs_[bottom & (kMaxJobsPerThread - 1)].load(std::memory_order_relaxed);
+	if (top == bottom) {
+		// 最後の1つは盗む側と取り合う
+		if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			job = nullptr;
+		}
+		bottom_.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+Job* JobSystem::WorkStealingQueue::Steal() {
+
+	int64_t top = top_.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const int64_t bottom = bottom_.load(std::memory_order_acquire);
+	if (top >= bottom) {
+		return nullptr;
+	}
+
+	Job* job = jobs_[top & (kMaxJobsPerThread - 1)].load(std::memory_order_relaxed);
+	if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		// 他のスレッドに取られた
+		return nullptr;
+	}
+	return job;
+}
+
+JobSystem* JobSystem::GetInstance() {
+	static JobSystem instance;
+	return &instance;
+}
+
+void JobSystem::Initialize(uint32_t threadCount) {
+
+	assert(workers_.empty());
+
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	workers_.resize(threadCount);
+	for (Worker*& worker : workers_) {
+		worker = new Worker();
+	}
+
+	// 呼んだスレッドが0番
+	tThreadIndex = 0;
+
+	quit_ = false;
+	for (uint32_t i = 1; i < threadCount; ++i) {
+		workers_[i]->thread = std::thread(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+void JobSystem::Finalize() {
+
+	{
+		std::scoped_lock lock(mutex_);
+		quit_ = true;
+	}
+	condition_.notify_all();
+
+	// 他のワーカーがキューを覗いている間は消せないので、全員止めてから消す
+	for (Worker* worker : workers_) {
+		if (worker->thread.joinable()) {
+			worker->thread.join();
+		}
+	}
+	for (Worker* worker : workers_) {
+		delete worker;
+	}
+	workers_.clear();
+	queuedCount_ = 0;
+	tThreadIndex = kNotWorker;
+}
+
+uint32_t JobSystem::GetThreadIndex() { return tThreadIndex; }
+
+void JobSystem::Wait(JobCounter* counter) {
+
+	const uint32_t threadIndex = tThreadIndex;
+	assert(threadIndex != kNotWorker);
+
+	// 待っている間も自分でジョブを進める
+	while (!counter->IsDone()) {
+		if (Job* job = FindJob(threadIndex)) {
+			Execute(job);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+Job* JobSystem::AllocateJob() {
+
+	assert(tThreadIndex != kNotWorker && "jobs must be issued from a worker thread");
+	const uint32_t threadIndex = tThreadIndex;
+	Worker* worker = workers_[threadIndex];
+	Job* job = &worker->jobs[worker->nextJob];
+	worker->nextJob = (worker->nextJob + 1) & (kMaxJobsPerThread - 1);
+
+	// 一周前のジョブがまだ終わっていなければ、進めながら待つ
+	while (job->pending.load(std::memory_order_acquire)) {
+		if (Job* other = FindJob(threadIndex)) {
+			Execute(other);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	return job;
+}
+
+void JobSystem::CountUp(JobCounter* counter) {
+
+	if (counter->count_.fetch_add(1, std::memory_order_acq_rel) != 0) {
+		return;
+	}
+
+	// 0から数え直す時に後続の待ちを開き直す
+	// 前の最後のジョブが数を0にしてから待ちを閉じるまでの間なら、閉じ終わるのを待つ（先に開くと新しい待ちが閉じられる）
+	Job* expected = kClosedList;
+	while (!counter->waiters_.compare_exchange_weak(expected, nullptr, std::memory_order_acq_rel, std::memory_order_acquire)) {
+		expected = kClosedList;
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::Submit(Job* job, JobCounter* dependency) {
+
+	if (!dependency) {
+		Enqueue(job);
+		return;
+	}
+
+	// 依存先がまだ終わっていなければ、その待ちに並べる（最後のジョブが積んでくれる）
+	Job* head = dependency->waiters_.load(std::memory_order_acquire);
+	while (head != kClosedList) {
+		job->nextWaiter = head;
+		if (dependency->waiters_.compare_exchange_weak(head, job, std::memory_order_release, std::memory_order_acquire)) {
+			return;
+		}
+	}
+	Enqueue(job);
+}
+
+void JobSystem::Enqueue(Job* job) {
+
+	// 盗まれて減らされる前に数える
+	queuedCount_.fetch_add(1, std::memory_order_seq_cst);
+
+	Worker* worker = workers_[tThreadIndex];
+	if (!worker->queue.Push(job)) {
+		// キューが満杯ならその場で実行する
+		queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+		Execute(job);
+		return;
+	}
+
+	if (sleepingCount_.load(std::memory_order_seq_cst) > 0) {
+		// 寝ようとしているワーカーが条件を確かめ終えるのを待ってから起こす
+		{ std::scoped_lock lock(mutex_); }
+		condition_.notify_one();
+	}
+}
+
+Job* JobSystem::FindJob(uint32_t threadIndex) {
+
+	// 自分のキュー（最後に積んだものから）
+	Job* job = workers_[threadIndex]->queue.Pop();
+
+	// 空なら隣から順に盗む
+	const uint32_t workerCount = static_cast<uint32_t>(workers_.size());
+	for (uint32_t i = 1; !job && i < workerCount; ++i) {
+		job = workers_[(threadIndex + i) % workerCount]->queue.Steal();
+	}
+
+	if (job) {
+		queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+void JobSystem::Execute(Job* job) {
+
+	{
+		PROFILE_ZONE("Job");
+		job->invoke(job);
+	}
+
+	// ここから先はジョブに触らない（積んだスレッドが使い回してよい）
+	JobCounter* counter = job->counter;
+	job->pending.store(false, std::memory_order_release);
+	if (!counter || counter->count_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	// 最後のジョブが後続を積む（閉じた後はカウンターに触らない。待っている側がすぐ破棄してよい）
+	// 閉じた印はジョブではないので積まない
+	Job* waiter = counter->waiters_.exchange(kClosedList, std::memory_order_acq_rel);
+	assert(waiter != kClosedList && "job counter was closed twice");
+	while (waiter && waiter != kClosedList) {
+		Job* next = waiter->nextWaiter;
+		Enqueue(waiter);
+		waiter = next;
+	}
+}
+
+void JobSystem::WorkerMain(uint32_t threadIndex) {
+
+	tThreadIndex = threadIndex;
+	Profiler::GetInstance()->SetThreadName("Job Worker " + std::to_string(threadIndex));
+
+	uint32_t idleCount = 0;
+	while (true) {
+		if (Job* job = FindJob(threadIndex)) {
+			Execute(job);
+			idleCount = 0;
+			continue;
+		}
+
+		// しばらくは寝ずに探し直す（短いジョブが続けて積まれる時に起こす手間を省く）
+		if (++idleCount < kSpinCount) {
+			std::this_thread::yield();
+			continue;
+		}
+		idleCount = 0;
+
+		std::unique_lock lock(mutex_);
+		sleepingCount_.fetch_add(1, std::memory_order_seq_cst);
+		condition_.wait(lock, [this]() { return quit_ || queuedCount_.load(std::memory_order_seq_cst) > 0; });
+		sleepingCount_.fetch_sub(1, std::memory_order_relaxed);
+		if (quit_) {
+			return;
+		}
+	}
+}
@@ -0,0 +1,282 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class JobCounter;
+
+// リングのジョブとキューの位置をキャッシュラインに揃えた分の詰め物は意図したもの（C4324 を出さない）
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+/// <summary>
+/// ジョブ（関数オブジェクトをそのまま中に持ち、確保しない）
+/// </summary>
+struct alignas(64) Job {
+	// 関数オブジェクトを置ける大きさ
+	static constexpr size_t kStorageSize = 96;
+
+	void (*invoke)(Job* job) = nullptr;
+	JobCounter* counter = nullptr;
+	// 依存先のカウンターで待っている間のつなぎ
+	Job* nextWaiter = nullptr;
+	// 積んでから実行し終えるまで立つ（リングで使い回す時に確かめる）
+	std::atomic<bool> pending = false;
+	alignas(16) unsigned char storage[kStorageSize];
+};
+
+/// <summary>
+/// ジョブの完了を数えるカウンター
+/// ジョブを積むたびに増え、終わるたびに減り、0になると後続のジョブ（依存）が積まれる
+/// 1つのカウンターに積むジョブと後続のジョブは、同じスレッドから出すこと
+/// </summary>
+class JobCounter {
+public:
+	JobCounter();
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	/// <summary>
+	/// 積んだジョブが全て終わり、後続も積み終えたか
+	/// </summary>
+	bool IsDone() const;
+
+private:
+	friend class JobSystem;
+
+	std::atomic<uint32_t> count_ = 0;
+	// 終わるのを待っている後続のジョブ
+	// 最後のジョブが後続を積み終えると閉じた印になり、それまでカウンターは終わったことにならない
+	std::atomic<Job*> waiters_;
+};
+
+/// <summary>
+/// ワークスティーリングのジョブスケジューラ
+/// スレッドごとに両端キューを持ち、自分のキューは後ろから取り、空なら他のキューの前から盗む
+/// メインスレッドも0番のワーカーとして扱い、Wait の間は自分でジョブを実行する
+/// ジョブはスレッドごとのリングから取るので確保しない（1スレッドが一度に出せるのは kMaxJobsPerThread 個まで）
+/// </summary>
+class JobSystem {
+public:
+	// 1スレッドのキューとジョブのリングの大きさ
+	static constexpr uint32_t kMaxJobsPerThread = 4096;
+
+	static JobSystem* GetInstance();
+
+	/// <summary>
+	/// 初期化（呼んだスレッドが0番のワーカーになる）
+	/// </summary>
+	/// <param name="threadCount">メインスレッドを含むスレッド数（0ならコア数）</param>
+	void Initialize(uint32_t threadCount = 0);
+
+	/// <summary>
+	/// 終了処理（積まれたジョブが無いこと）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// メインスレッドを含むスレッド数
+	/// </summary>
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+	/// <summary>
+	/// ジョブを積む（ワーカーのスレッドから呼ぶ）
+	/// </summary>
+	/// <param name="function">引数なしで呼べる関数オブジェクト（Job::kStorageSize に収まること）</param>
+	/// <param name="counter">終わった時に減らすカウンター</param>
+	/// <param name="dependency">このカウンターが0になってから実行する（nullptr なら待たない）</param>
+	template<typename Function>
+	void Run(Function&& function, JobCounter* counter, JobCounter* dependency = nullptr);
+
+	/// <summary>
+	/// カウンターが0になるまで、他のジョブを実行しながら待つ
+	/// </summary>
+	void Wait(JobCounter* counter);
+
+	/// <summary>
+	/// [0, count) を grainSize ずつに分けて並列に処理し、全て終わるまで待つ
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">1ジョブの要素数</param>
+	/// <param name="function">function(begin, end) で範囲を処理する</param>
+	template<typename Function>
+	void ParallelFor(uint32_t count, uint32_t grainSize, const Function& function);
+
+	/// <summary>
+	/// 配列の各要素を並列に処理し、全て終わるまで待つ
+	/// </summary>
+	/// <param name="items">要素</param>
+	/// <param name="grainSize">1ジョブの要素数</param>
+	/// <param name="function">function(item) で1要素を処理する</param>
+	template<typename T, typename Function>
+	void ParallelForEach(std::span<T> items, uint32_t grainSize, const Function& function);
+
+	/// <summary>
+	/// 呼んだスレッドのワーカー番号（ワーカー以外は kNotWorker）
+	/// </summary>
+	static uint32_t GetThreadIndex();
+
+	// ワーカー以外のスレッド
+	static constexpr uint32_t kNotWorker = UINT32_MAX;
+
+private:
+	JobSystem() = default;
+	~JobSystem() = default;
+	JobSystem(const JobSystem&) = delete;
+	const JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// 固定長の両端キュー（Chase-Lev）
+	/// 持ち主のスレッドは後ろに積んで後ろから取り、他のスレッドは前から盗む
+	/// </summary>
+	class WorkStealingQueue {
+	public:
+		WorkStealingQueue();
+
+		/// <summary>
+		/// 積む（持ち主だけ）
+		/// </summary>
+		/// <returns>満杯なら false</returns>
+		bool Push(Job* job);
+
+		/// <summary>
+		/// 後ろから取る（持ち主だけ）
+		/// </summary>
+		Job* Pop();
+
+		/// <summary>
+		/// 前から盗む（どのスレッドからでもよい）
+		/// </summary>
+		Job* Steal();
+
+	private:
+		std::vector<std::atomic<Job*>> jobs_;
+		alignas(64) std::atomic<int64_t> top_ = 0;
+		alignas(64) std::atomic<int64_t> bottom_ = 0;
+	};
+
+	/// <summary>
+	/// スレッドごとの持ち物
+	/// </summary>
+	struct Worker {
+		WorkStealingQueue queue;
+		Job jobs[kMaxJobsPerThread];
+		uint32_t nextJob = 0;
+		std::thread thread;
+	};
+
+	/// <summary>
+	/// 呼んだスレッドのリングからジョブを取る（一周して前のジョブが終わっていなければ、他のジョブを実行しながら待つ）
+	/// </summary>
+	Job* AllocateJob();
+
+	/// <summary>
+	/// カウンターを1つ増やす（0から数え直す時は、前の最後のジョブが後続の待ちを閉じ終えてから開き直す）
+	/// </summary>
+	void CountUp(JobCounter* counter);
+
+	/// <summary>
+	/// 依存先が終わっていればキューに積み、終わっていなければ依存先の待ちに並べる
+	/// </summary>
+	void Submit(Job* job, JobCounter* dependency);
+
+	/// <summary>
+	/// 呼んだスレッドのキューに積んで、寝ているワーカーを起こす
+	/// </summary>
+	void Enqueue(Job* job);
+
+	/// <summary>
+	/// 自分のキューか他のキューからジョブを1つ取る
+	/// </summary>
+	Job* FindJob(uint32_t threadIndex);
+
+	/// <summary>
+	/// 実行してカウンターを減らし、0になったら後続を積む
+	/// </summary>
+	void Execute(Job* job);
+
+	/// <summary>
+	/// ワーカースレッド本体
+	/// </summary>
+	void WorkerMain(uint32_t threadIndex);
+
+	template<typename Function>
+	static void Invoke(Job* job) {
+		Function* function = std::launder(reinterpret_cast<Function*>(job->storage));
+		(*function)();
+		function->~Function();
+	}
+
+	std::vector<Worker*> workers_;
+
+	// キューに積まれているジョブの数（寝るかどうかの判断に使う）
+	std::atomic<uint32_t> queuedCount_ = 0;
+	std::atomic<uint32_t> sleepingCount_ = 0;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	bool quit_ = false;
+};
+
+#pragma warning(pop)
+
+template<typename Function>
+void JobSystem::Run(Function&& function, JobCounter* counter, JobCounter* dependency) {
+
+	using Stored = std::decay_t<Function>;
+	static_assert(sizeof(Stored) <= Job::kStorageSize, "job function is too large; capture by pointer instead");
+	static_assert(alignof(Stored) <= 16, "job function is over-aligned");
+
+	Job* job = AllocateJob();
+	new (job->storage) Stored(std::forward<Function>(function));
+	job->invoke = &Invoke<Stored>;
+	job->counter = counter;
+	job->nextWaiter = nullptr;
+	job->pending.store(true, std::memory_order_relaxed);
+
+	if (counter) {
+		CountUp(counter);
+	}
+	Submit(job, dependency);
+}
+
+template<typename Function>
+void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const Function& function) {
+
+	if (count == 0) {
+		return;
+	}
+	grainSize = grainSize > 0 ? grainSize : 1;
+
+	// 1つに収まる、ワーカーがいない、ワーカー以外のスレッドから呼ばれた時はそのまま呼ぶ
+	if (count <= grainSize || workers_.size() <= 1 || GetThreadIndex() == kNotWorker) {
+		function(0u, count);
+		return;
+	}
+
+	// 呼び出しは終わるまで戻らないので、関数オブジェクトは参照で渡してよい
+	JobCounter counter;
+	const Function* target = &function;
+	for (uint32_t begin = 0; begin < count; begin += grainSize) {
+		const uint32_t end = count - begin > grainSize ? begin + grainSize : count;
+		Run([target, begin, end]() { (*target)(begin, end); }, &counter);
+	}
+	Wait(&counter);
+}
+
+template<typename T, typename Function>
+void JobSystem::ParallelForEach(std::span<T> items, uint32_t grainSize, const Function& function) {
+
+	ParallelFor(static_cast<uint32_t>(items.size()), grainSize, [&items, &function](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			function(items[i]);
+		}
+	});
+}
@@ -1,4 +1,5 @@
 #include "MapChipField.h"
+#include "MemoryTracker.h"
 #include <cassert>
 #include <fstream>
 #include <map>
@@ -14,6 +15,11 @@ std::map<std::string, MapChipType> mapChipTable = {
     {"1", MapChipType::kBlock},
 };
 
+std::map<std::string, SpawnType> spawnTable = {
+    {"0", SpawnType::kNone },
+    {"1", SpawnType::kEnemy},
+};
+
 }
 
 void MapChipField::ResetMapChipData() {
@@ -28,6 +34,8 @@ void MapChipField::ResetMapChipData() {
 
 void MapChipField::LoadMapChipCsv(const std::string& filePath) {
 
+	MemoryTagScope memoryTag(MemoryTag::kMap);
+
 	// マップチップデータをリセット
 	ResetMapChipData();
 
@@ -66,7 +74,70 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
 	}
 }
 
-MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) {
+void MapChipField::LoadSpawnCsv(const std::string& filePath) {
+
+	MemoryTagScope memoryTag(MemoryTag::kMap);
+
+	// ファイルを開く
+	std::ifstream file;
+	file.open(filePath);
+	assert(file.is_open());
+
+	// 出現レイヤーCSV
+	std::stringstream spawnCsv;
+	spawnCsv << file.rdbuf();
+	file.close();
+
+	// 行の順に読んだ出現位置を、列ごとに数えてから列の順に並べ直す
+	std::vector<SpawnPoint> points;
+	spawnColumnStarts_.assign(kNumBlockHorizontal + 1, 0);
+	for (uint32_t i = 0; i < kNumBlockVirtical; ++i) {
+
+		std::string line;
+		getline(spawnCsv, line);
+
+		std::istringstream line_stream(line);
+
+		for (uint32_t j = 0; j < kNumBlockHorizontal; ++j) {
+
+			std::string word;
+			getline(line_stream, word, ',');
+
+			auto it = spawnTable.find(word);
+			if (it == spawnTable.end() || it->second == SpawnType::kNone) {
+				continue;
+			}
+			points.push_back({it->second, j, i});
+			++spawnColumnStarts_[j + 1];
+		}
+	}
+
+	for (uint32_t j = 0; j < kNumBlockHorizontal; ++j) {
+		spawnColumnStarts_[j + 1] += spawnColumnStarts_[j];
+	}
+
+	spawnPoints_.resize(points.size());
+	std::vector<uint32_t> cursor(spawnColumnStarts_.begin(), spawnColumnStarts_.end() - 1);
+	for (const SpawnPoint& point : points) {
+		spawnPoints_[cursor[point.xIndex]++] = point;
+	}
+}
+
+std::span<const SpawnPoint> MapChipField::GetSpawnPointsByColumns(uint32_t firstXIndex, uint32_t lastXIndex) const {
+
+	if (spawnColumnStarts_.empty() || firstXIndex > lastXIndex || firstXIndex >= kNumBlockHorizontal) {
+		return {};
+	}
+	if (lastXIndex >= kNumBlockHorizontal) {
+		lastXIndex = kNumBlockHorizontal - 1;
+	}
+
+	const uint32_t begin = spawnColumnStarts_[firstXIndex];
+	const uint32_t end = spawnColumnStarts_[lastXIndex + 1];
+	return std::span<const SpawnPoint>(spawnPoints_).subspan(begin, end - begin);
+}
+
+MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const {
 
 	if (xIndex < 0 || kNumBlockHorizontal - 1 < xIndex) {
 		return MapChipType::kBlank;
@@ -79,7 +150,7 @@ MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex
 
 Vector3 MapChipField::GetMatChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) const { return Vector3(kBlockWidth * xIndex, kBlockHeight * (kNumBlockVirtical - 1 - yIndex), 0); }
 
-MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const KamataEngine::Vector3& position) {
+MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const KamataEngine::Vector3& position) const {
 
 	IndexSet indexSet{};
 
@@ -89,7 +160,7 @@ MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const KamataEn
 	return indexSet;
 }
 
-MapChipField::Rect MapChipField::GetRectByIndex(uint32_t xIndex, uint32_t yIndex) {
+MapChipField::Rect MapChipField::GetRectByIndex(uint32_t xIndex, uint32_t yIndex) const {
 
 	// 指定ブロックの中心座標を取得する
 	Vector3 center = GetMatChipPositionByIndex(xIndex, yIndex);
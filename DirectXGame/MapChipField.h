@@ -1,12 +1,26 @@
 #pragma once
 #include "KamataEngine.h"
 #include <cstdint>
+#include <span>
 #include <vector>
 enum class MapChipType {
 	kBlank, // 空白
 	kBlock, // ブロック
 };
 
+// 出現レイヤーの種類
+enum class SpawnType {
+	kNone,  // 何も出さない
+	kEnemy, // 敵
+};
+
+// 出現レイヤーの1マス分
+struct SpawnPoint {
+	SpawnType type;
+	uint32_t xIndex;
+	uint32_t yIndex;
+};
+
 struct MapChipData {
 	std::vector<std::vector<MapChipType>> data;
 };
@@ -30,17 +44,29 @@ public:
 
 	void LoadMapChipCsv(const std::string& filePath);
 
-	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex);
+	/// <summary>
+	/// 出現レイヤーのCSVを読み込む（マップチップと同じ大きさで、敵などを出すマスに種類の番号を書く）
+	/// </summary>
+	void LoadSpawnCsv(const std::string& filePath);
+
+	/// <summary>
+	/// 列の範囲にある出現位置（列の順）
+	/// </summary>
+	/// <param name="firstXIndex">最初の列</param>
+	/// <param name="lastXIndex">最後の列（この列も含む）</param>
+	std::span<const SpawnPoint> GetSpawnPointsByColumns(uint32_t firstXIndex, uint32_t lastXIndex) const;
+
+	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const;
 
 	KamataEngine::Vector3 GetMatChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) const;
 
-	uint32_t GetNumBlockVirtical() { return kNumBlockVirtical; }
+	uint32_t GetNumBlockVirtical() const { return kNumBlockVirtical; }
 
-	uint32_t GetNumBlockHorizontal() { return kNumBlockHorizontal; }
+	uint32_t GetNumBlockHorizontal() const { return kNumBlockHorizontal; }
 
-	IndexSet GetMapChipIndexSetByPosition(const KamataEngine::Vector3& position);
+	IndexSet GetMapChipIndexSetByPosition(const KamataEngine::Vector3& position) const;
 
-	Rect GetRectByIndex(uint32_t xIndex, uint32_t yIndex);
+	Rect GetRectByIndex(uint32_t xIndex, uint32_t yIndex) const;
 
 	static float GetBlockHeight() { return kBlockHeight; }
 
@@ -55,4 +81,8 @@ private:
 	static inline const uint32_t kNumBlockHorizontal = 100;
 
 	MapChipData mapChipData_;
+
+	// 出現位置（列の順）と、列ごとの先頭の位置（列 x の出現位置は [spawnColumnStarts_[x], spawnColumnStarts_[x + 1])）
+	std::vector<SpawnPoint> spawnPoints_;
+	std::vector<uint32_t> spawnColumnStarts_;
 };
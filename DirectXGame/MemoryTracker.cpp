@@ -0,0 +1,225 @@
+#define NOMINMAX
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
+
+namespace {
+
+/// <summary>
+/// 確保の前に置くヘッダ（返すアドレスの揃えを崩さない大きさにする）
+/// </summary>
+struct alignas(16) AllocationHeader {
+	uint64_t size;
+	// 確保した先頭から返したアドレスまで
+	uint32_t offset;
+	MemoryTag tag;
+};
+
+static_assert(sizeof(AllocationHeader) == 16);
+
+/// <summary>
+/// タグごとの数（スレッドが奪い合わないように離す）
+/// キャッシュラインの大きさまで自分で詰めて、alignas による詰め物（/W4 の C4324）を出さない
+/// </summary>
+struct alignas(64) Counters {
+	std::atomic<int64_t> liveBytes;
+	std::atomic<int64_t> peakBytes;
+	std::atomic<uint64_t> allocationCount;
+	std::atomic<uint64_t> allocatedBytes;
+	unsigned char padding[64 - sizeof(std::atomic<int64_t>) * 4];
+};
+
+static_assert(sizeof(Counters) == 64);
+
+// 静的初期化より前の new からも使うので定数で初期化する
+constinit Counters gCounters[static_cast<size_t>(MemoryTag::kCount)] = {};
+
+thread_local MemoryTag tCurrentTag = MemoryTag::kOther;
+
+void* Allocate(size_t size, size_t alignment) {
+
+	alignment = std::max<size_t>(alignment, alignof(AllocationHeader));
+	const size_t extra = sizeof(AllocationHeader) + (alignment > alignof(AllocationHeader) ? alignment : 0);
+	if (size > SIZE_MAX - extra) {
+		return nullptr;
+	}
+	unsigned char* raw = static_cast<unsigned char*>(std::malloc(size + extra));
+	if (!raw) {
+		return nullptr;
+	}
+
+	// ヘッダの後ろで揃える
+	const uintptr_t address = (reinterpret_cast<uintptr_t>(raw) + sizeof(AllocationHeader) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+	unsigned char* pointer = reinterpret_cast<unsigned char*>(address);
+
+	const MemoryTag tag = tCurrentTag;
+	AllocationHeader* header = reinterpret_cast<AllocationHeader*>(pointer) - 1;
+	header->size = size;
+	header->offset = static_cast<uint32_t>(pointer - raw);
+	header->tag = tag;
+
+	Counters& counters = gCounters[static_cast<size_t>(tag)];
+	const int64_t live = counters.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+	int64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+	while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+	counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+	counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	return pointer;
+}
+
+void Free(void* pointer) {
+
+	if (!pointer) {
+		return;
+	}
+	const AllocationHeader* header = static_cast<const AllocationHeader*>(pointer) - 1;
+	gCounters[static_cast<size_t>(header->tag)].liveBytes.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+	std::free(static_cast<unsigned char*>(pointer) - header->offset);
+}
+
+void* AllocateOrThrow(size_t size, size_t alignment) {
+
+	void* pointer = Allocate(size, alignment);
+	if (!pointer) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+} // namespace
+
+MemoryTagScope::MemoryTagScope(MemoryTag tag) : previous_(tCurrentTag) { tCurrentTag = tag; }
+
+MemoryTagScope::~MemoryTagScope() { tCurrentTag = previous_; }
+
+MemoryTracker* MemoryTracker::GetInstance() {
+	static MemoryTracker instance;
+	return &instance;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag) {
+	switch (tag) {
+	case MemoryTag::kModel:
+		return "Model";
+	case MemoryTag::kMesh:
+		return "Mesh";
+	case MemoryTag::kTexture:
+		return "TextureManager";
+	case MemoryTag::kAudio:
+		return "Audio";
+	case MemoryTag::kGameScene:
+		return "GameScene";
+	case MemoryTag::kMap:
+		return "Map";
+	case MemoryTag::kFrameArena:
+		return "FrameArena";
+	default:
+		return "Other";
+	}
+}
+
+MemoryTag MemoryTracker::GetCurrentTag() { return tCurrentTag; }
+
+void MemoryTracker::BeginFrame() {
+
+	for (size_t i = 0; i < static_cast<size_t>(MemoryTag::kCount); ++i) {
+		const uint64_t count = gCounters[i].allocationCount.load(std::memory_order_relaxed);
+		const uint64_t bytes = gCounters[i].allocatedBytes.load(std::memory_order_relaxed);
+		frameAllocations_[i] = count - lastAllocationCount_[i];
+		frameBytes_[i] = bytes - lastAllocatedBytes_[i];
+		lastAllocationCount_[i] = count;
+		lastAllocatedBytes_[i] = bytes;
+	}
+}
+
+MemoryTracker::TagStats MemoryTracker::GetStats(MemoryTag tag) const {
+
+	const size_t index = static_cast<size_t>(tag);
+	TagStats stats;
+	stats.liveBytes = gCounters[index].liveBytes.load(std::memory_order_relaxed);
+	stats.peakBytes = gCounters[index].peakBytes.load(std::memory_order_relaxed);
+	stats.allocationCount = gCounters[index].allocationCount.load(std::memory_order_relaxed);
+	stats.frameAllocations = frameAllocations_[index];
+	stats.frameBytes = frameBytes_[index];
+	return stats;
+}
+
+void MemoryTracker::PrintReport(FILE* output) const {
+
+	std::fprintf(output, "  %-16s %12s %12s %12s %12s %12s\n", "tag", "live KB", "peak KB", "allocs", "allocs/frame", "bytes/frame");
+	for (size_t i = 0; i < static_cast<size_t>(MemoryTag::kCount); ++i) {
+		const MemoryTag tag = static_cast<MemoryTag>(i);
+		const TagStats stats = GetStats(tag);
+		std::fprintf(output, "  %-16s %12.1f %12.1f %12llu %12llu %12llu\n", GetTagName(tag), stats.liveBytes / 1024.0, stats.peakBytes / 1024.0,
+		             static_cast<unsigned long long>(stats.allocationCount), static_cast<unsigned long long>(stats.frameAllocations), static_cast<unsigned long long>(stats.frameBytes));
+	}
+}
+
+void MemoryTracker::DrawOverlay() const {
+#ifdef USE_IMGUI
+
+	ImGui::Begin("Memory");
+	if (ImGui::BeginTable("memory", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+		ImGui::TableSetupColumn("Tag");
+		ImGui::TableSetupColumn("Live KB");
+		ImGui::TableSetupColumn("Peak KB");
+		ImGui::TableSetupColumn("Allocs");
+		ImGui::TableSetupColumn("Allocs/frame");
+		ImGui::TableSetupColumn("Bytes/frame");
+		ImGui::TableHeadersRow();
+		for (size_t i = 0; i < static_cast<size_t>(MemoryTag::kCount); ++i) {
+			const MemoryTag tag = static_cast<MemoryTag>(i);
+			const TagStats stats = GetStats(tag);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(GetTagName(tag));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", stats.liveBytes / 1024.0);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", stats.peakBytes / 1024.0);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.allocationCount));
+			ImGui::TableNextColumn();
+			// フレームごとの確保は目立たせる
+			if (stats.frameAllocations > 0) {
+				ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.3f, 1.0f), "%llu", static_cast<unsigned long long>(stats.frameAllocations));
+			} else {
+				ImGui::TextUnformatted("0");
+			}
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.frameBytes));
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
+#endif
+}
+
+// グローバルの new/delete の置き換え（揃えの指定が無いものは既定の揃え）
+void* operator new(size_t size) { return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size) { return AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Allocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { Free(pointer); }
+void operator delete[](void* pointer) noexcept { Free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { Free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { Free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { Free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { Free(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { Free(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { Free(pointer); }
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+
+/// <summary>
+/// 確保したメモリの持ち主
+/// </summary>
+enum class MemoryTag : uint8_t {
+	kOther,      // タグの付いていない確保
+	kModel,      // Model（OBJ の読み込みと法線の平滑化）
+	kMesh,       // OptimizedModel のメッシュ
+	kTexture,    // TextureManager の読み込み（CPU 側のみ）
+	kAudio,      // Audio::SoundData、ミキサーとストリーミングの音
+	kGameScene,  // GameScene の初期化と更新で確保したもの
+	kMap,        // マップチップ
+	kFrameArena, // FrameArena のブロックと溢れた分
+	kCount,
+};
+
+/// <summary>
+/// スコープの間、このスレッドの確保に tag を付ける（入れ子にすると内側が優先）
+/// </summary>
+class MemoryTagScope {
+public:
+	explicit MemoryTagScope(MemoryTag tag);
+	~MemoryTagScope();
+	MemoryTagScope(const MemoryTagScope&) = delete;
+	MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+	MemoryTag previous_;
+};
+
+/// <summary>
+/// タグごとのメモリの使用量
+/// グローバルの operator new/delete を置き換え、確保の前に大きさとタグを書いたヘッダを付けて数える
+/// 数えるのはこの実行ファイルの new だけで、GPU のリソースや DLL の中の確保は入らない
+/// </summary>
+class MemoryTracker {
+public:
+	/// <summary>
+	/// タグの集計
+	/// </summary>
+	struct TagStats {
+		// 今使っている大きさと、その最大
+		int64_t liveBytes = 0;
+		int64_t peakBytes = 0;
+		// 始めてからの確保の回数
+		uint64_t allocationCount = 0;
+		// 直前のフレームの確保の回数と大きさ
+		uint64_t frameAllocations = 0;
+		uint64_t frameBytes = 0;
+	};
+
+	static MemoryTracker* GetInstance();
+
+	/// <summary>
+	/// タグの名前
+	/// </summary>
+	static const char* GetTagName(MemoryTag tag);
+
+	/// <summary>
+	/// 呼んだスレッドで今付いているタグ
+	/// </summary>
+	static MemoryTag GetCurrentTag();
+
+	/// <summary>
+	/// フレームの区切り（前のフレームの確保の数を確定する）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// タグの集計
+	/// </summary>
+	TagStats GetStats(MemoryTag tag) const;
+
+	/// <summary>
+	/// 表にして出力する（ヘッドレスで動かす時用）
+	/// </summary>
+	void PrintReport(FILE* output) const;
+
+	/// <summary>
+	/// 表を ImGui で表示する（USE_IMGUI の時だけ）
+	/// </summary>
+	void DrawOverlay() const;
+
+private:
+	MemoryTracker() = default;
+	~MemoryTracker() = default;
+	MemoryTracker(const MemoryTracker&) = delete;
+	const MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+	// 前のフレームの区切りでの確保の回数と大きさの合計
+	uint64_t lastAllocationCount_[static_cast<size_t>(MemoryTag::kCount)] = {};
+	uint64_t lastAllocatedBytes_[static_cast<size_t>(MemoryTag::kCount)] = {};
+	// 直前のフレームの分
+	uint64_t frameAllocations_[static_cast<size_t>(MemoryTag::kCount)] = {};
+	uint64_t frameBytes_[static_cast<size_t>(MemoryTag::kCount)] = {};
+};
@@ -0,0 +1,356 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <execution>
+#include <numeric>
+
+namespace {
+
+// 頂点のバイト列ハッシュ（FNV-1a）
+uint64_t HashVertex(const MeshOptimizer::Vertex& vertex) {
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < sizeof(MeshOptimizer::Vertex); ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+// 平滑化の合計を並列で行う頂点数の下限
+constexpr size_t kParallelSmoothingVertexCount = 1 << 16;
+
+// 2の累乗に切り上げ
+size_t NextPowerOfTwo(size_t value) {
+	size_t result = 1;
+	while (result < value) {
+		result <<= 1;
+	}
+	return result;
+}
+
+// Forsyth法のスコア定数
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+// 頂点スコア（キャッシュ位置と残り三角形数から求める）
+float VertexScore(int32_t cachePosition, uint32_t remainingValence) {
+
+	if (remainingValence == 0) {
+		// もう使われない頂点
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if (cachePosition >= 0) {
+		if (cachePosition < 3) {
+			// 直前の三角形で使った頂点は固定値（同じ三角形を続けて選ばないため）
+			score = kLastTriangleScore;
+		} else {
+			const float scaler = 1.0f / static_cast<float>(MeshOptimizer::kCacheSize - 3);
+			score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, kCacheDecayPower);
+		}
+	}
+
+	// 残りが少ない頂点を優先して使い切る
+	score += kValenceBoostScale * std::pow(static_cast<float>(remainingValence), -kValenceBoostPower);
+	return score;
+}
+
+} // namespace
+
+namespace MeshOptimizer {
+
+void WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+
+	if (vertices.empty()) {
+		return;
+	}
+
+	// オープンアドレス法のハッシュテーブル（空きは UINT32_MAX）
+	const size_t tableSize = NextPowerOfTwo(vertices.size() * 2);
+	const size_t mask = tableSize - 1;
+	std::vector<uint32_t> table(tableSize, UINT32_MAX);
+
+	// 旧頂点番号 → 新頂点番号
+	std::vector<uint32_t> remap(vertices.size());
+	uint32_t uniqueCount = 0;
+
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		size_t slot = static_cast<size_t>(HashVertex(vertices[i])) & mask;
+
+		while (true) {
+			uint32_t entry = table[slot];
+			if (entry == UINT32_MAX) {
+				// 新しい頂点として前に詰める
+				table[slot] = uniqueCount;
+				vertices[uniqueCount] = vertices[i];
+				remap[i] = uniqueCount++;
+				break;
+			}
+			if (std::memcmp(&vertices[entry], &vertices[i], sizeof(Vertex)) == 0) {
+				// 既出の頂点
+				remap[i] = entry;
+				break;
+			}
+			slot = (slot + 1) & mask;
+		}
+	}
+
+	vertices.resize(uniqueCount);
+	for (uint32_t& index : indices) {
+		index = remap[index];
+	}
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0 || vertexCount == 0) {
+		return;
+	}
+
+	// 頂点ごとの隣接三角形リスト（CSR形式）
+	std::vector<uint32_t> valence(vertexCount, 0);
+	for (uint32_t index : indices) {
+		++valence[index];
+	}
+
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		offsets[v + 1] = offsets[v] + valence[v];
+	}
+
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+	for (size_t t = 0; t < triangleCount; ++t) {
+		for (size_t k = 0; k < 3; ++k) {
+			adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+		}
+	}
+
+	// スコアの初期化
+	std::vector<int32_t> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		vertexScores[v] = VertexScore(-1, valence[v]);
+	}
+
+	std::vector<float> triangleScores(triangleCount);
+	for (size_t t = 0; t < triangleCount; ++t) {
+		triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+	}
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<uint32_t> output;
+	output.reserve(indices.size());
+
+	// LRUキャッシュ（新しいものが先頭、3つ分はみ出し用に余裕を持たせる）
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> nextCache;
+	cache.reserve(kCacheSize + 3);
+	nextCache.reserve(kCacheSize + 3);
+
+	// キャッシュから候補が見つからない時の走査位置
+	size_t scanCursor = 0;
+
+	// 最初の三角形は全体から最高スコアのものを選ぶ
+	int64_t bestTriangle = std::distance(triangleScores.begin(), std::max_element(triangleScores.begin(), triangleScores.end()));
+
+	while (bestTriangle >= 0) {
+		const uint32_t* tri = &indices[static_cast<size_t>(bestTriangle) * 3];
+
+		// 出力して使用済みにする
+		emitted[bestTriangle] = true;
+		output.insert(output.end(), tri, tri + 3);
+
+		// 隣接リストから取り除く（有効部分の末尾と入れ替え）
+		for (size_t k = 0; k < 3; ++k) {
+			uint32_t v = tri[k];
+			uint32_t* begin = &adjacency[offsets[v]];
+			uint32_t* end = begin + valence[v];
+			uint32_t* found = std::find(begin, end, static_cast<uint32_t>(bestTriangle));
+			std::swap(*found, *(end - 1));
+			--valence[v];
+		}
+
+		// キャッシュ更新（三角形の頂点を先頭へ）
+		nextCache.assign(tri, tri + 3);
+		for (uint32_t v : cache) {
+			if (v != tri[0] && v != tri[1] && v != tri[2]) {
+				nextCache.push_back(v);
+			}
+		}
+
+		// 追い出された頂点のスコア更新
+		for (size_t i = kCacheSize; i < nextCache.size(); ++i) {
+			uint32_t v = nextCache[i];
+			cachePosition[v] = -1;
+			vertexScores[v] = VertexScore(-1, valence[v]);
+			for (uint32_t j = 0; j < valence[v]; ++j) {
+				uint32_t t = adjacency[offsets[v] + j];
+				triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+			}
+		}
+		if (nextCache.size() > kCacheSize) {
+			nextCache.resize(kCacheSize);
+		}
+		cache.swap(nextCache);
+
+		// キャッシュ内の頂点のスコア更新
+		for (size_t i = 0; i < cache.size(); ++i) {
+			uint32_t v = cache[i];
+			cachePosition[v] = static_cast<int32_t>(i);
+			vertexScores[v] = VertexScore(cachePosition[v], valence[v]);
+		}
+
+		// キャッシュ内の頂点に隣接する三角形から次を選ぶ
+		bestTriangle = -1;
+		float bestScore = -1.0f;
+		for (uint32_t v : cache) {
+			for (uint32_t j = 0; j < valence[v]; ++j) {
+				uint32_t t = adjacency[offsets[v] + j];
+				float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+				triangleScores[t] = score;
+				if (score > bestScore) {
+					bestScore = score;
+					bestTriangle = t;
+				}
+			}
+		}
+
+		// 候補が無ければ未出力の三角形を先頭から探す
+		if (bestTriangle < 0) {
+			while (scanCursor < triangleCount && emitted[scanCursor]) {
+				++scanCursor;
+			}
+			if (scanCursor < triangleCount) {
+				bestTriangle = static_cast<int64_t>(scanCursor);
+			}
+		}
+	}
+
+	indices.swap(output);
+}
+
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+
+	// 初めて参照された順に番号を振り直す
+	std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+	std::vector<Vertex> reordered;
+	reordered.reserve(vertices.size());
+
+	for (uint32_t& index : indices) {
+		if (remap[index] == UINT32_MAX) {
+			remap[index] = static_cast<uint32_t>(reordered.size());
+			reordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+
+	// どこからも参照されない頂点は捨てる
+	vertices.swap(reordered);
+}
+
+float CalculateACMR(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0) {
+		return 0.0f;
+	}
+
+	// FIFOキャッシュ：頂点が入った時刻を記録し、cacheSize 回のミスで追い出されたとみなす
+	std::vector<uint64_t> insertedAt(vertexCount, 0);
+	uint64_t missCount = 0;
+
+	for (uint32_t index : indices) {
+		if (insertedAt[index] == 0 || missCount + 1 - insertedAt[index] > cacheSize) {
+			++missCount;
+			insertedAt[index] = missCount;
+		}
+	}
+
+	return static_cast<float>(missCount) / static_cast<float>(triangleCount);
+}
+
+void CalculateSmoothedNormals(std::vector<Vertex>& vertices, const std::vector<uint32_t>& positionIndices) {
+
+	assert(positionIndices.size() == vertices.size());
+	if (vertices.empty()) {
+		return;
+	}
+
+	// 座標番号をそのままグループ番号にする
+	const std::vector<uint32_t>& groups = positionIndices;
+	const size_t groupCount = *std::max_element(groups.begin(), groups.end()) + size_t(1);
+
+	// グループごとの頂点リスト（CSR形式）
+	std::vector<uint32_t> offsets(groupCount + 1, 0);
+	for (uint32_t group : groups) {
+		++offsets[group + 1];
+	}
+	for (size_t g = 0; g < groupCount; ++g) {
+		offsets[g + 1] += offsets[g];
+	}
+
+	std::vector<uint32_t> members(vertices.size());
+	std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		members[fill[groups[i]]++] = static_cast<uint32_t>(i);
+	}
+
+	// グループ内の法線を合計して正規化し、全員に書き戻す（グループ同士は独立）
+	auto smoothGroup = [&](uint32_t group) {
+		KamataEngine::Vector3 sum = {0.0f, 0.0f, 0.0f};
+		for (uint32_t i = offsets[group]; i < offsets[group + 1]; ++i) {
+			const KamataEngine::Vector3& normal = vertices[members[i]].normal;
+			sum.x += normal.x;
+			sum.y += normal.y;
+			sum.z += normal.z;
+		}
+
+		float length = std::sqrt(sum.x * sum.x + sum.y * sum.y + sum.z * sum.z);
+		if (length <= 0.0f) {
+			// 打ち消し合う場合は元の法線のまま
+			return;
+		}
+		sum = {sum.x / length, sum.y / length, sum.z / length};
+
+		for (uint32_t i = offsets[group]; i < offsets[group + 1]; ++i) {
+			vertices[members[i]].normal = sum;
+		}
+	};
+
+	if (vertices.size() >= kParallelSmoothingVertexCount) {
+		std::vector<uint32_t> groupIndices(groupCount);
+		std::iota(groupIndices.begin(), groupIndices.end(), 0u);
+		std::for_each(std::execution::par, groupIndices.begin(), groupIndices.end(), smoothGroup);
+	} else {
+		for (uint32_t g = 0; g < groupCount; ++g) {
+			smoothGroup(g);
+		}
+	}
+}
+
+Stats Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+
+	Stats stats;
+	stats.vertexCountBefore = vertices.size();
+	stats.triangleCount = indices.size() / 3;
+	stats.acmrBefore = CalculateACMR(indices, vertices.size());
+
+	WeldVertices(vertices, indices);
+	OptimizeVertexCache(indices, vertices.size());
+	OptimizeVertexFetch(vertices, indices);
+
+	stats.vertexCountAfter = vertices.size();
+	stats.acmrAfter = CalculateACMR(indices, vertices.size());
+	stats.use16BitIndices = CanUse16BitIndices(vertices.size());
+	return stats;
+}
+
+} // namespace MeshOptimizer
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <math/Vector2.h>
+#include <math/Vector3.h>
+#include <vector>
+
+/// <summary>
+/// メッシュ最適化（頂点の統合・頂点キャッシュ向けの並べ替え）
+/// </summary>
+namespace MeshOptimizer {
+
+/// <summary>
+/// 頂点（Mesh::VertexPosNormalUv と同じ並び、エンジンに依存せずツールからも使えるように自前で持つ）
+/// </summary>
+struct Vertex {
+	KamataEngine::Vector3 pos;    // xyz座標
+	KamataEngine::Vector3 normal; // 法線ベクトル
+	KamataEngine::Vector2 uv;     // uv座標
+};
+
+// 最適化で使う頂点キャッシュのサイズ（Forsyth法の想定値）
+inline constexpr uint32_t kCacheSize = 32;
+
+// ACMR計測で使う FIFO キャッシュのサイズ（一般的なGPUの想定値）
+inline constexpr uint32_t kMeasureCacheSize = 16;
+
+/// <summary>
+/// 最適化結果の統計
+/// </summary>
+struct Stats {
+	size_t vertexCountBefore = 0; // 最適化前の頂点数
+	size_t vertexCountAfter = 0;  // 最適化後の頂点数
+	size_t triangleCount = 0;     // 三角形数
+	float acmrBefore = 0.0f;      // 最適化前のACMR（三角形あたりの頂点キャッシュミス数）
+	float acmrAfter = 0.0f;       // 最適化後のACMR
+	bool use16BitIndices = false; // 16bitインデックスに収まるか
+};
+
+/// <summary>
+/// 完全に同じ頂点を1つにまとめる
+/// </summary>
+/// <param name="vertices">頂点配列（統合後に詰められる）</param>
+/// <param name="indices">インデックス配列（統合後の番号に振り直される）</param>
+void WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+/// <summary>
+/// 頂点キャッシュの局所性が上がるように三角形を並べ替える（Forsyth法）
+/// </summary>
+/// <param name="indices">インデックス配列</param>
+/// <param name="vertexCount">頂点数</param>
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+/// <summary>
+/// インデックスから参照される順に頂点を並べ替える
+/// </summary>
+/// <param name="vertices">頂点配列</param>
+/// <param name="indices">インデックス配列</param>
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+/// <summary>
+/// ACMR（三角形あたりの頂点キャッシュミス数）を FIFO キャッシュで計測する
+/// 3.0 が最悪、0.5 付近が理想
+/// </summary>
+/// <param name="indices">インデックス配列</param>
+/// <param name="vertexCount">頂点数</param>
+/// <param name="cacheSize">キャッシュサイズ</param>
+/// <returns>ACMR</returns>
+float CalculateACMR(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = kMeasureCacheSize);
+
+/// <summary>
+/// 16bitインデックスで表現できるか
+/// </summary>
+/// <param name="vertexCount">頂点数</param>
+inline bool CanUse16BitIndices(size_t vertexCount) { return vertexCount <= 0xFFFF; }
+
+/// <summary>
+/// OBJ の同じ座標番号を持つ頂点の法線を平均して滑らかにする（Mesh::CalculateSmoothedVertexNormals と同じ束ね方）
+/// 座標番号ごとのCSR形式の隣接配列を作り、グループごとに1パスで法線を合計する
+/// </summary>
+/// <param name="vertices">頂点配列</param>
+/// <param name="positionIndices">頂点ごとの OBJ の座標番号</param>
+void CalculateSmoothedNormals(std::vector<Vertex>& vertices, const std::vector<uint32_t>& positionIndices);
+
+/// <summary>
+/// 統合・三角形の並べ替え・頂点の並べ替えをまとめて行う
+/// </summary>
+/// <param name="vertices">頂点配列</param>
+/// <param name="indices">インデックス配列</param>
+/// <returns>統計</returns>
+Stats Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+} // namespace MeshOptimizer
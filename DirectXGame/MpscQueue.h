@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// 固定長のロックフリーキュー（書き込みは複数スレッド、読み出しは1スレッド）
+/// 各セルに番号を持たせ、書き込み側は位置の CAS だけで順番を取る（確保もロックもしない）
+/// 満杯の時は待たずに失敗を返す
+/// </summary>
+/// <typeparam name="T">要素（コピーできること）</typeparam>
+/// <typeparam name="kCapacity">容量（2の累乗）</typeparam>
+template<typename T, uint32_t kCapacity>
+class MpscQueue {
+	static_assert(kCapacity >= 2 && (kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+public:
+	MpscQueue() {
+		for (uint32_t i = 0; i < kCapacity; ++i) {
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	/// <summary>
+	/// 追加（どのスレッドからでもよい）
+	/// </summary>
+	/// <returns>満杯なら false</returns>
+	bool Push(const T& value) {
+
+		uint32_t position = enqueuePosition_.load(std::memory_order_relaxed);
+		Cell* cell = nullptr;
+		while (true) {
+			cell = &cells_[position & (kCapacity - 1)];
+			const uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const int32_t difference = static_cast<int32_t>(sequence - position);
+			if (difference == 0) {
+				// このセルが空いている。位置を進められたら自分のもの
+				if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				// 読み出し側が1周分遅れている
+				return false;
+			} else {
+				position = enqueuePosition_.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->value = value;
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// <summary>
+	/// 取り出し（読み出し側の1スレッドだけが呼ぶ）
+	/// </summary>
+	/// <returns>空なら false</returns>
+	bool Pop(T& value) {
+
+		Cell& cell = cells_[dequeuePosition_ & (kCapacity - 1)];
+		const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+		if (static_cast<int32_t>(sequence - (dequeuePosition_ + 1)) < 0) {
+			return false;
+		}
+
+		value = cell.value;
+		cell.sequence.store(dequeuePosition_ + kCapacity, std::memory_order_release);
+		++dequeuePosition_;
+		return true;
+	}
+
+	/// <summary>
+	/// 空か（読み出し側の1スレッドだけが呼ぶ）
+	/// </summary>
+	bool IsEmpty() const {
+		const Cell& cell = cells_[dequeuePosition_ & (kCapacity - 1)];
+		return static_cast<int32_t>(cell.sequence.load(std::memory_order_acquire) - (dequeuePosition_ + 1)) < 0;
+	}
+
+private:
+	// 書き込み側と読み出し側の位置を離す幅
+	static constexpr size_t kCacheLineSize = 64;
+
+	struct Cell {
+		std::atomic<uint32_t> sequence;
+		T value;
+	};
+
+	Cell cells_[kCapacity];
+	// 書き込み側と読み出し側で同じキャッシュラインを取り合わないように、間に1本分の詰め物を置く
+	// （alignas で揃えると使う側のクラスまで詰め物が入り、/W4 の C4324 になる）
+	unsigned char cellsPadding_[kCacheLineSize];
+	std::atomic<uint32_t> enqueuePosition_ = 0;
+	unsigned char enqueuePadding_[kCacheLineSize];
+	uint32_t dequeuePosition_ = 0;
+};
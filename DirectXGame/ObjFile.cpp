@@ -0,0 +1,181 @@
+#include "ObjFile.h"
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 読み込むディレクトリ（Model と同じ）
+const std::string kBaseDirectory = "Resources/";
+
+// 未設定のマテリアル番号
+constexpr uint32_t kNoMaterial = UINT32_MAX;
+
+// パスからファイル名を取り出す（MTL にフルパスで書かれていることがある）
+std::string GetFileName(const std::string& path) {
+	size_t separator = path.find_last_of("/\\");
+	return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+
+// OBJ の番号（1始まり、負なら末尾から）を0始まりにする
+uint32_t ResolveIndex(long index, size_t count) { return static_cast<uint32_t>(index < 0 ? static_cast<long>(count) + index : index - 1); }
+
+/// <summary>
+/// MTL ファイルを読み込んでマテリアルを追加する
+/// </summary>
+void LoadMaterials(const std::string& modelName, const std::string& fileName, std::vector<ObjFile::MaterialData>& materials, std::unordered_map<std::string, uint32_t>& materialIndices) {
+
+	std::ifstream file(kBaseDirectory + modelName + "/" + fileName);
+	if (file.fail()) {
+		return;
+	}
+
+	ObjFile::MaterialData* material = nullptr;
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream lineStream(line);
+		std::string key;
+		lineStream >> key;
+
+		if (key == "newmtl") {
+			material = &materials.emplace_back();
+			lineStream >> material->name;
+			materialIndices[material->name] = static_cast<uint32_t>(materials.size() - 1);
+		} else if (!material) {
+			continue;
+		} else if (key == "Ka") {
+			lineStream >> material->ambient.x >> material->ambient.y >> material->ambient.z;
+		} else if (key == "Kd") {
+			lineStream >> material->diffuse.x >> material->diffuse.y >> material->diffuse.z;
+		} else if (key == "Ks") {
+			lineStream >> material->specular.x >> material->specular.y >> material->specular.z;
+		} else if (key == "map_Kd") {
+			std::string textureFileName;
+			lineStream >> textureFileName;
+			material->textureFileName = modelName + "/" + GetFileName(textureFileName);
+		}
+	}
+}
+
+} // namespace
+
+namespace ObjFile {
+
+bool Load(const std::string& modelName, ModelData& model) {
+
+	model = {};
+
+	std::ifstream file(kBaseDirectory + modelName + "/" + modelName + ".obj");
+	if (file.fail()) {
+		return false;
+	}
+
+	std::vector<Vector3> positions;
+	std::vector<Vector3> normals;
+	std::vector<Vector2> texcoords;
+	std::unordered_map<std::string, uint32_t> materialIndices;
+
+	MeshData mesh;
+	mesh.material = kNoMaterial;
+
+	// 面を持つメッシュだけを残す
+	auto finishMesh = [&]() {
+		if (!mesh.vertices.empty()) {
+			model.meshes.push_back(std::move(mesh));
+		}
+		mesh = {};
+		mesh.material = kNoMaterial;
+	};
+
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream lineStream(line);
+		std::string key;
+		lineStream >> key;
+
+		if (key == "mtllib") {
+			std::string fileName;
+			lineStream >> fileName;
+			LoadMaterials(modelName, fileName, model.materials, materialIndices);
+		} else if (key == "g") {
+			finishMesh();
+			lineStream >> mesh.name;
+		} else if (key == "v") {
+			Vector3& position = positions.emplace_back();
+			lineStream >> position.x >> position.y >> position.z;
+		} else if (key == "vt") {
+			Vector2& texcoord = texcoords.emplace_back();
+			lineStream >> texcoord.x >> texcoord.y;
+			// V方向反転
+			texcoord.y = 1.0f - texcoord.y;
+		} else if (key == "vn") {
+			Vector3& normal = normals.emplace_back();
+			lineStream >> normal.x >> normal.y >> normal.z;
+		} else if (key == "usemtl") {
+			// エンジンと同じく、メッシュの最初のマテリアルだけを使う
+			std::string materialName;
+			lineStream >> materialName;
+			auto it = materialIndices.find(materialName);
+			if (mesh.material == kNoMaterial && it != materialIndices.end()) {
+				mesh.material = it->second;
+			}
+		} else if (key == "f") {
+			// 角ごとに頂点を追加（「座標/uv/法線」「座標//法線」「座標/uv」「座標」）
+			const uint32_t first = static_cast<uint32_t>(mesh.vertices.size());
+			std::string corner;
+			while (lineStream >> corner) {
+				long indexPosition = 0;
+				long indexTexcoord = 0;
+				long indexNormal = 0;
+				std::istringstream cornerStream(corner);
+				cornerStream >> indexPosition;
+				if (cornerStream.get() == '/') {
+					if (cornerStream.peek() != '/') {
+						cornerStream >> indexTexcoord;
+					}
+					if (cornerStream.get() == '/') {
+						cornerStream >> indexNormal;
+					}
+				}
+
+				const uint32_t positionIndex = ResolveIndex(indexPosition, positions.size());
+				MeshOptimizer::Vertex vertex = {};
+				vertex.pos = positions[positionIndex];
+				if (indexTexcoord != 0) {
+					vertex.uv = texcoords[ResolveIndex(indexTexcoord, texcoords.size())];
+				}
+				if (indexNormal != 0) {
+					vertex.normal = normals[ResolveIndex(indexNormal, normals.size())];
+				}
+				mesh.vertices.push_back(vertex);
+				mesh.positionIndices.push_back(positionIndex);
+			}
+
+			// 扇状に三角形へ分割（四角形は 0,1,2 と 2,3,0 でエンジンと同じ向き）
+			const uint32_t cornerCount = static_cast<uint32_t>(mesh.vertices.size()) - first;
+			for (uint32_t i = 2; i < cornerCount; ++i) {
+				mesh.indices.insert(mesh.indices.end(), {first, first + i - 1, first + i});
+			}
+		}
+	}
+	finishMesh();
+
+	// マテリアルの無いメッシュにはデフォルトマテリアル
+	uint32_t defaultMaterial = kNoMaterial;
+	for (MeshData& meshData : model.meshes) {
+		if (meshData.material != kNoMaterial) {
+			continue;
+		}
+		if (defaultMaterial == kNoMaterial) {
+			defaultMaterial = static_cast<uint32_t>(model.materials.size());
+			model.materials.emplace_back();
+		}
+		meshData.material = defaultMaterial;
+	}
+
+	return true;
+}
+
+} // namespace ObjFile
@@ -0,0 +1,58 @@
+#pragma once
+#include "MeshOptimizer.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// OBJ/MTL ファイルの解析（CPU 側の処理だけで、GPU のリソースは作らない）
+/// 面の角ごとに頂点を作る・uv の V を反転する・多角形を扇状に分割する・g でメッシュを分ける点は Model::CreateFromOBJ と同じ
+/// </summary>
+namespace ObjFile {
+
+// マテリアルにテクスチャが無い時に貼るテクスチャ（エンジンと同じ）
+inline constexpr const char* kDefaultTextureFileName = "white1x1.png";
+
+/// <summary>
+/// マテリアル
+/// </summary>
+struct MaterialData {
+	std::string name;
+	KamataEngine::Vector3 ambient = {0.3f, 0.3f, 0.3f};
+	KamataEngine::Vector3 diffuse = {0.8f, 0.8f, 0.8f};
+	KamataEngine::Vector3 specular = {0.0f, 0.0f, 0.0f};
+	// Resources からの相対パス
+	std::string textureFileName = kDefaultTextureFileName;
+};
+
+/// <summary>
+/// メッシュ
+/// </summary>
+struct MeshData {
+	std::string name;
+	std::vector<MeshOptimizer::Vertex> vertices;
+	std::vector<uint32_t> indices;
+	// 頂点ごとの OBJ の座標番号（0始まり、平滑化で同じ座標の頂点を束ねるのに使う）
+	std::vector<uint32_t> positionIndices;
+	// materials の添え字
+	uint32_t material = 0;
+};
+
+/// <summary>
+/// モデル
+/// </summary>
+struct ModelData {
+	std::vector<MeshData> meshes;
+	// マテリアルの無いメッシュ用のデフォルトマテリアルも含む
+	std::vector<MaterialData> materials;
+};
+
+/// <summary>
+/// モデルを読み込む（Resources/モデル名/モデル名.obj）
+/// </summary>
+/// <param name="modelName">モデル名</param>
+/// <param name="model">読み込み結果</param>
+/// <returns>ファイルを開けたか</returns>
+bool Load(const std::string& modelName, ModelData& model);
+
+} // namespace ObjFile
@@ -0,0 +1,178 @@
+#include "OptimizedModel.h"
+#include "VertexQuantization.h"
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 復元用パラメータをシェーダーに渡す形にする
+OptimizedModelPipeline::QuantizationConstants MakeQuantizationConstants(const VertexQuantization::Params& params) {
+
+	OptimizedModelPipeline::QuantizationConstants constants = {
+	    {params.positionMin.x,   params.positionMin.y,   params.positionMin.z,   0.0f            },
+	    {params.positionScale.x, params.positionScale.y, params.positionScale.z, 0.0f            },
+	    {params.uvMin.x,         params.uvMin.y,         params.uvScale.x,       params.uvScale.y},
+	};
+	return constants;
+}
+
+} // namespace
+
+OptimizedModel::Source OptimizedModel::Prepare(const std::string& modelName, bool smoothing) {
+
+	Source source;
+	[[maybe_unused]] const bool loaded = ObjFile::Load(modelName, source.model);
+	assert(loaded);
+
+	for (ObjFile::MeshData& mesh : source.model.meshes) {
+		// 平滑化は自前のコピーに対して行う（統合より前に、面ごとの頂点のうちに行う）
+		if (smoothing) {
+			MeshOptimizer::CalculateSmoothedNormals(mesh.vertices, mesh.positionIndices);
+		}
+
+		// OBJの面順のままの頂点/インデックスを最適化
+		source.stats.push_back(MeshOptimizer::Optimize(mesh.vertices, mesh.indices));
+	}
+
+	return source;
+}
+
+OptimizedModel* OptimizedModel::Create(const Source& source, const std::vector<uint32_t>& textureHandles) {
+
+	assert(textureHandles.size() == source.model.materials.size());
+
+	OptimizedModel* instance = new OptimizedModel();
+	instance->textureHandles_ = textureHandles;
+	instance->stats_ = source.stats;
+
+	// マテリアル（テクスチャは描画時にハンドルで差し替えるので、マテリアル自身には読み込ませない）
+	for (const ObjFile::MaterialData& materialData : source.model.materials) {
+		std::unique_ptr<Material> material = Material::Create();
+		material->name_ = materialData.name;
+		material->ambient_ = materialData.ambient;
+		material->diffuse_ = materialData.diffuse;
+		material->specular_ = materialData.specular;
+		material->textureFilename_ = materialData.textureFileName;
+		material->Update();
+		instance->materials_.push_back(std::move(material));
+	}
+
+	for (size_t i = 0; i < source.model.meshes.size(); ++i) {
+		const ObjFile::MeshData& mesh = source.model.meshes[i];
+		const MeshOptimizer::Stats& stats = source.stats[i];
+
+		SubMesh subMesh;
+		subMesh.material = mesh.material;
+		subMesh.indexCount = static_cast<UINT>(mesh.indices.size());
+
+		// 頂点バッファ（量子化して半分の大きさで送る）
+		VertexQuantization::CompactMesh compactMesh = VertexQuantization::Quantize(mesh.vertices);
+		assert(VertexQuantization::Validate(mesh.vertices, compactMesh));
+		subMesh.quantization = MakeQuantizationConstants(compactMesh.params);
+
+		const size_t vertexBytes = sizeof(VertexQuantization::CompactVertex) * compactMesh.vertices.size();
+		subMesh.vertBuff = CreateBuffer(compactMesh.vertices.data(), vertexBytes);
+		subMesh.vbView.BufferLocation = subMesh.vertBuff->GetGPUVirtualAddress();
+		subMesh.vbView.SizeInBytes = static_cast<UINT>(vertexBytes);
+		subMesh.vbView.StrideInBytes = sizeof(VertexQuantization::CompactVertex);
+
+		// インデックスバッファ（収まるなら16bit）
+		if (stats.use16BitIndices) {
+			std::vector<uint16_t> indices16(mesh.indices.begin(), mesh.indices.end());
+			const size_t indexBytes = sizeof(uint16_t) * indices16.size();
+			subMesh.indexBuff = CreateBuffer(indices16.data(), indexBytes);
+			subMesh.ibView.SizeInBytes = static_cast<UINT>(indexBytes);
+			subMesh.ibView.Format = DXGI_FORMAT_R16_UINT;
+		} else {
+			const size_t indexBytes = sizeof(uint32_t) * mesh.indices.size();
+			subMesh.indexBuff = CreateBuffer(mesh.indices.data(), indexBytes);
+			subMesh.ibView.SizeInBytes = static_cast<UINT>(indexBytes);
+			subMesh.ibView.Format = DXGI_FORMAT_R32_UINT;
+		}
+		subMesh.ibView.BufferLocation = subMesh.indexBuff->GetGPUVirtualAddress();
+
+#ifdef _DEBUG
+		DebugText::GetInstance()->ConsolePrintf(
+		    "MeshOptimizer %s: vertices %zu -> %zu, ACMR %.3f -> %.3f, %s indices\n", mesh.name.c_str(), stats.vertexCountBefore, stats.vertexCountAfter, stats.acmrBefore, stats.acmrAfter,
+		    stats.use16BitIndices ? "16bit" : "32bit");
+
+		// 量子化の誤差とサイズ
+		VertexQuantization::Error error = VertexQuantization::Measure(mesh.vertices, compactMesh);
+		DebugText::GetInstance()->ConsolePrintf(
+		    "VertexQuantization %s: %zu -> %zu bytes, error pos %.6f normal %.4fdeg uv %.6f\n", mesh.name.c_str(), sizeof(MeshOptimizer::Vertex) * mesh.vertices.size(),
+		    vertexBytes, error.position, error.normalDegrees, error.uv);
+#endif // _DEBUG
+
+		instance->meshes_.push_back(subMesh);
+	}
+
+	return instance;
+}
+
+void OptimizedModel::SetAlpha(float alpha) {
+
+	for (const std::unique_ptr<Material>& material : materials_) {
+		material->alpha_ = alpha;
+		material->Update();
+	}
+}
+
+void OptimizedModel::Draw(const WorldTransform& worldTransform, const Camera& camera, const ObjectColor* objectColor) {
+
+	// 量子化頂点のパイプラインに切り替えてから、Model::Draw と同じ順でルートパラメータを積む
+	ModelCommon* modelCommon = ModelCommon::GetInstance();
+	ID3D12GraphicsCommandList* commandList = modelCommon->GetCommandList();
+	OptimizedModelPipeline::GetInstance()->SetPipeline(commandList);
+
+	modelCommon->LightCommand();
+	modelCommon->TransformCommand(worldTransform, camera);
+
+	if (!objectColor) {
+		objectColor = modelCommon->GetObjectColor();
+	}
+	objectColor->SetGraphicsCommand(commandList, static_cast<UINT>(Model::RoomParameter::kObjectColor));
+
+	DrawMeshes(commandList);
+
+	// 後に続く Model::Draw のために Model のパイプラインへ戻す（ルートパラメータは Model::Draw が全て積み直す）
+	Model::PostDraw();
+	Model::PreDraw(commandList);
+}
+
+void OptimizedModel::DrawMeshes(ID3D12GraphicsCommandList* commandList) const {
+
+	for (const SubMesh& subMesh : meshes_) {
+		commandList->IASetVertexBuffers(0, 1, &subMesh.vbView);
+		commandList->IASetIndexBuffer(&subMesh.ibView);
+		commandList->SetGraphicsRoot32BitConstants(
+		    OptimizedModelPipeline::kQuantizationRootParameter, sizeof(OptimizedModelPipeline::QuantizationConstants) / sizeof(float), &subMesh.quantization, 0);
+
+		materials_[subMesh.material]->SetGraphicsCommand(
+		    commandList, static_cast<UINT>(Model::RoomParameter::kMaterial), static_cast<UINT>(Model::RoomParameter::kTexture), textureHandles_[subMesh.material]);
+
+		commandList->DrawIndexedInstanced(subMesh.indexCount, 1, 0, 0, 0);
+	}
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> OptimizedModel::CreateBuffer(const void* data, size_t size) {
+
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	[[maybe_unused]] HRESULT result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer));
+	assert(SUCCEEDED(result));
+
+	// 書き込み
+	void* map = nullptr;
+	result = buffer->Map(0, nullptr, &map);
+	assert(SUCCEEDED(result));
+	std::memcpy(map, data, size);
+	buffer->Unmap(0, nullptr);
+
+	return buffer;
+}
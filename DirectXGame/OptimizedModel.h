@@ -0,0 +1,99 @@
+#pragma once
+#include "KamataEngine.h"
+#include "MeshOptimizer.h"
+#include "ObjFile.h"
+#include "OptimizedModelPipeline.h"
+#include <d3d12.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// 頂点キャッシュ最適化済みモデル
+/// OBJ を自前で解析して最適化し、自前の頂点/インデックスバッファとマテリアルで描画する
+/// （エンジンの Model は作らないので、同じ形状を2重に持たない）
+/// 頂点は VertexQuantization で 16byte に詰めて GPU に送り、OptimizedModelPipeline で復元して描く
+/// </summary>
+class OptimizedModel {
+public:
+	/// <summary>
+	/// GPU のリソースを作る前の、解析と最適化まで済んだデータ
+	/// </summary>
+	struct Source {
+		ObjFile::ModelData model;
+		std::vector<MeshOptimizer::Stats> stats;
+	};
+
+	/// <summary>
+	/// OBJ を解析して最適化する（CPU の処理だけなので、描画と並行して呼べる）
+	/// </summary>
+	/// <param name="modelName">モデル名</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <returns>最適化済みデータ</returns>
+	static Source Prepare(const std::string& modelName, bool smoothing);
+
+	/// <summary>
+	/// 最適化済みデータからバッファとマテリアルを作る
+	/// </summary>
+	/// <param name="source">Prepare の結果</param>
+	/// <param name="textureHandles">マテリアルごとのテクスチャ（source.model.materials と同じ順、参照は呼び出し側が持つ）</param>
+	/// <returns>生成されたモデル</returns>
+	static OptimizedModel* Create(const Source& source, const std::vector<uint32_t>& textureHandles);
+
+	/// <summary>
+	/// 描画（Model::PreDraw 〜 Model::PostDraw の間で呼ぶ、描いた後は Model のパイプラインに戻す）
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="camera">カメラ</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	void Draw(const KamataEngine::WorldTransform& worldTransform, const KamataEngine::Camera& camera, const KamataEngine::ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// メッシュだけを描画する
+	/// OptimizedModelPipeline::SetPipeline の後で、行列・カメラ・ライト・色のルートパラメータは積み済みであること
+	/// </summary>
+	/// <param name="commandList">命令発行先コマンドリスト</param>
+	void DrawMeshes(ID3D12GraphicsCommandList* commandList) const;
+
+	/// <summary>
+	/// 全マテリアルにアルファ値を設定する
+	/// </summary>
+	void SetAlpha(float alpha);
+
+	/// <summary>
+	/// マテリアルごとのテクスチャ
+	/// </summary>
+	const std::vector<uint32_t>& GetTextureHandles() const { return textureHandles_; }
+
+	/// <summary>
+	/// メッシュごとの最適化結果
+	/// </summary>
+	const std::vector<MeshOptimizer::Stats>& GetStats() const { return stats_; }
+
+private:
+	// 最適化済みメッシュ
+	struct SubMesh {
+		Microsoft::WRL::ComPtr<ID3D12Resource> vertBuff;
+		Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff;
+		D3D12_VERTEX_BUFFER_VIEW vbView = {};
+		D3D12_INDEX_BUFFER_VIEW ibView = {};
+		UINT indexCount = 0;
+		uint32_t material = 0;
+		// 量子化の復元用パラメータ
+		OptimizedModelPipeline::QuantizationConstants quantization = {};
+	};
+
+	/// <summary>
+	/// アップロードヒープにバッファを作ってデータを書き込む
+	/// </summary>
+	static Microsoft::WRL::ComPtr<ID3D12Resource> CreateBuffer(const void* data, size_t size);
+
+	// メッシュ
+	std::vector<SubMesh> meshes_;
+	// マテリアルとそのテクスチャ
+	std::vector<std::unique_ptr<KamataEngine::Material>> materials_;
+	std::vector<uint32_t> textureHandles_;
+	// 最適化結果
+	std::vector<MeshOptimizer::Stats> stats_;
+};
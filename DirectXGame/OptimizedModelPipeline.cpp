@@ -0,0 +1,101 @@
+#include "OptimizedModelPipeline.h"
+#include "ShaderCompiler.h"
+#include "SpriteBatch.h"
+#include <cassert>
+#include <d3dx12.h>
+
+using namespace KamataEngine;
+using Microsoft::WRL::ComPtr;
+
+OptimizedModelPipeline* OptimizedModelPipeline::GetInstance() {
+	static OptimizedModelPipeline instance;
+	return &instance;
+}
+
+void OptimizedModelPipeline::Initialize(ID3D12Device* device) {
+
+	assert(device);
+	[[maybe_unused]] HRESULT result = S_FALSE;
+
+	ComPtr<ID3DBlob> vsBlob = ShaderCompiler::Compile(L"Resources/shaders/ObjCompactVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = ShaderCompiler::Compile(L"Resources/shaders/ObjPS.hlsl", "ps_5_0");
+
+	// ルートシグネチャ（Model::RoomParameter の順に、復元用パラメータのルート定数を足す）
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0 レジスタ
+
+	CD3DX12_ROOT_PARAMETER rootParams[kQuantizationRootParameter + 1] = {};
+	rootParams[static_cast<size_t>(Model::RoomParameter::kWorldTransform)].InitAsConstantBufferView(0);
+	rootParams[static_cast<size_t>(Model::RoomParameter::kCamera)].InitAsConstantBufferView(1);
+	rootParams[static_cast<size_t>(Model::RoomParameter::kMaterial)].InitAsConstantBufferView(2);
+	rootParams[static_cast<size_t>(Model::RoomParameter::kTexture)].InitAsDescriptorTable(1, &descRangeSRV, D3D12_SHADER_VISIBILITY_PIXEL);
+	rootParams[static_cast<size_t>(Model::RoomParameter::kLight)].InitAsConstantBufferView(3);
+	rootParams[static_cast<size_t>(Model::RoomParameter::kObjectColor)].InitAsConstantBufferView(4);
+	rootParams[kQuantizationRootParameter].InitAsConstants(sizeof(QuantizationConstants) / sizeof(float), 5, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+
+	// uvは繰り返すことがあるのでラップ
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc = CD3DX12_STATIC_SAMPLER_DESC(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR);
+
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(_countof(rootParams), rootParams, 1, &samplerDesc, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+
+	result = device->CreateRootSignature(0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	// 頂点レイアウト（VertexQuantization::CompactVertex）
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL",   0, DXGI_FORMAT_R16G16_SNORM,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R16G16_UNORM,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// グラフィックスパイプライン
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline = {};
+	gpipeline.pRootSignature = rootSignature_.Get();
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	gpipeline.NumRenderTargets = 1;
+	gpipeline.RTVFormats[0] = SpriteBatch::kRenderTargetFormat;
+	gpipeline.SampleDesc.Count = 1;
+
+	// マテリアルのアルファで半透明にするので、通常のアルファブレンド
+	D3D12_RENDER_TARGET_BLEND_DESC& blendDesc = gpipeline.BlendState.RenderTarget[0];
+	blendDesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blendDesc.BlendEnable = true;
+	blendDesc.BlendOp = D3D12_BLEND_OP_ADD;
+	blendDesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blendDesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+	blendDesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blendDesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blendDesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	result = device->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&pipelineState_));
+	assert(SUCCEEDED(result));
+}
+
+void OptimizedModelPipeline::Finalize() {
+
+	pipelineState_.Reset();
+	rootSignature_.Reset();
+}
+
+void OptimizedModelPipeline::SetPipeline(ID3D12GraphicsCommandList* commandList) const {
+
+	assert(pipelineState_);
+
+	commandList->SetPipelineState(pipelineState_.Get());
+	commandList->SetGraphicsRootSignature(rootSignature_.Get());
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "KamataEngine.h"
+#include <d3d12.h>
+#include <wrl.h>
+
+/// <summary>
+/// 最適化済みモデル（量子化頂点）の描画パイプライン
+/// ルートパラメータは Model::RoomParameter と同じ番号で、その後ろに復元用パラメータのルート定数（b5）を足す
+/// 頂点シェーダーで復元した後は Model と同じピクセルシェーダー（ObjPS）で描く
+/// </summary>
+class OptimizedModelPipeline {
+public:
+	// 復元用パラメータのルートパラメータ番号
+	static constexpr UINT kQuantizationRootParameter = static_cast<UINT>(KamataEngine::Model::RoomParameter::kObjectColor) + 1;
+
+	/// <summary>
+	/// 復元用パラメータ（ObjCompactVS の b5 と同じ並び）
+	/// </summary>
+	struct QuantizationConstants {
+		float positionMin[4];   // xyz: 座標の最小値（メッシュのAABB）
+		float positionScale[4]; // xyz: AABBの大きさ
+		float uv[4];            // xy: uvの最小値 zw: uvの範囲
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static OptimizedModelPipeline* GetInstance();
+
+	/// <summary>
+	/// ルートシグネチャとパイプラインの生成
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	void Initialize(ID3D12Device* device);
+
+	/// <summary>
+	/// 解放
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// パイプラインとルートシグネチャを積む（Model::PreDraw の代わり）
+	/// ルートシグネチャが変わるので、積んだ後はルートパラメータを全て積み直すこと
+	/// </summary>
+	/// <param name="commandList">命令発行先コマンドリスト</param>
+	void SetPipeline(ID3D12GraphicsCommandList* commandList) const;
+
+private:
+	OptimizedModelPipeline() = default;
+	~OptimizedModelPipeline() = default;
+	OptimizedModelPipeline(const OptimizedModelPipeline&) = delete;
+	OptimizedModelPipeline& operator=(const OptimizedModelPipeline&) = delete;
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+};
@@ -1,6 +1,7 @@
 #define NOMINMAX
 #include "Player.h"
 #include "MapChipField.h"
+#include "Profiler.h"
 #include "VectorMath.h"
 #include <algorithm>
 #include <cfloat>
@@ -59,7 +60,7 @@ bool HitBlockExpanded3x3(MapChipField* field, const KamataEngine::Vector3& p, fl
 
 } // namespace
 
-void Player::Initialize(Model* innerModel, Model* outerModel, Model* modelAttack, Vector3& position) {
+void Player::Initialize(OptimizedModel* innerModel, OptimizedModel* outerModel, OptimizedModel* modelAttack, Vector3& position) {
 
 	// 3Dモデルの初期化
 	innerModel_ = innerModel;
@@ -73,9 +74,6 @@ void Player::Initialize(Model* innerModel, Model* outerModel, Model* modelAttack
 
 	WorldTransformUpdate(worldTransform_);
 
-	color_.Initialize();
-	color_.SetColor({1.0f, 1.0f, 1.0f, 0.5f});
-
 	modelAttack_ = modelAttack;
 	worldTransformAttack_.Initialize();
 	attackEffectVisible_ = false;
@@ -85,12 +83,13 @@ void Player::Initialize(Model* innerModel, Model* outerModel, Model* modelAttack
 	// カメラの初期化
 	camera_.Initialize();
 
-	wireVisualTransform_.Initialize();
 	wireAnchorVisualTransform_.Initialize();
 }
 
 void Player::Update() {
 
+	PROFILE_ZONE("Player::Update");
+
 	if (behaviorRequest_ != Behavior::kUnknown) {
 		// ふるまいを変更する
 		behavior_ = behaviorRequest_;
@@ -132,26 +131,23 @@ void Player::Update() {
 	}
 }
 
-void Player::Draw(Camera& camera) {
-
-	// DirectXCommonインスタンスの生成
-	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
-
-	Model::PreDraw(dxCommon->GetCommandList());
+void Player::AddToSnapshot(RenderSnapshot& snapshot) const {
 
 	// 3Dモデル描画
-	innerModel_->Draw(worldTransform_, camera);
+	snapshot.AddModel(innerModel_, worldTransform_.matWorld_);
 
-	outerModel_->Draw(worldTransform_, camera, &color_);
+	RenderSnapshot::ModelDraw& outer = snapshot.AddModel(outerModel_, worldTransform_.matWorld_);
+	outer.color = color_;
+	outer.hasColor = true;
 
 	if (behavior_ == Behavior::kAttack) {
-		modelAttack_->Draw(worldTransformAttack_, camera);
+		snapshot.AddModel(modelAttack_, worldTransformAttack_.matWorld_);
 	}
 
 	// ワイヤー可視化
 	if (isWireVisualVisible_ && (wireState_ == WireState::kFlying || wireState_ == WireState::kAttached)) {
 
-		KamataEngine::Model* wireModel = outerModel_;
+		OptimizedModel* wireModel = outerModel_;
 
 		// 始点は発射口
 		KamataEngine::Vector3 p = worldTransform_.translation_;
@@ -166,32 +162,26 @@ void Player::Draw(Camera& camera) {
 			a = wireAnchor_;
 		}
 
-		// ワイヤー本体
+		// ワイヤー本体（細長いモデルを伸ばして線に見せる）
 		KamataEngine::Vector3 d = {a.x - p.x, a.y - p.y, a.z - p.z};
 		float len = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
 		if (len > 0.0001f) {
 
-			wireVisualTransform_.translation_ = {(p.x + a.x) * 0.5f, (p.y + a.y) * 0.5f, (p.z + a.z) * 0.5f};
-			wireVisualTransform_.scale_ = {kWireVisualThickness_, kWireVisualThickness_, len};
+			KamataEngine::Vector3 translation = {(p.x + a.x) * 0.5f, (p.y + a.y) * 0.5f, (p.z + a.z) * 0.5f};
+			KamataEngine::Vector3 scale = {kWireVisualThickness_, kWireVisualThickness_, len};
 
 			float yaw = std::atan2(d.x, d.z);
 			float xz = std::sqrt(d.x * d.x + d.z * d.z);
 			float pitch = -std::atan2(d.y, xz);
-			wireVisualTransform_.rotation_ = {pitch, yaw, 0.0f};
+			KamataEngine::Vector3 rotation = {pitch, yaw, 0.0f};
 
-			WorldTransformUpdate(wireVisualTransform_);
-			wireModel->Draw(wireVisualTransform_, camera);
+			snapshot.AddModel(wireModel, MakeAffineMatrix(scale, rotation, translation));
 		}
 	}
-
-	Model::PostDraw();
 }
 
 Player::~Player() {
-
-	// 3Dモデルの解放
-	delete innerModel_;
-	delete outerModel_;
+	// モデルはAssetManagerが所有するのでここでは解放しない
 }
 
 void Player::Move() {
@@ -1,6 +1,7 @@
 #pragma once
 #include "AABB.h"
 #include "Easing.h"
+#include "RenderSnapshot.h"
 #include "KamataEngine.h"
 #include "WorldMatrixTransform.h"
 #include <numbers>
@@ -33,7 +34,7 @@ class Player {
 	};
 
 public:
-	void Initialize(KamataEngine::Model* innerModel, KamataEngine::Model* outerModel, KamataEngine::Model* modelAttack, KamataEngine::Vector3& position);
+	void Initialize(OptimizedModel* innerModel, OptimizedModel* outerModel, OptimizedModel* modelAttack, KamataEngine::Vector3& position);
 
 	/// <summary>
 	/// 更新
@@ -41,10 +42,10 @@ public:
 	void Update();
 
 	/// <summary>
-	/// 描画
+	/// 描画するモデルをスナップショットに積む
 	/// </summary>
-	/// <param name="camera"></param>
-	void Draw(KamataEngine::Camera& camera);
+	/// <param name="snapshot">スナップショット</param>
+	void AddToSnapshot(RenderSnapshot& snapshot) const;
 
 	/// <summary>
 	/// デストラクタ
@@ -184,8 +185,8 @@ private:
 	AttackPhase attackPhase_;
 
 	// 3Dモデル
-	KamataEngine::Model* innerModel_ = nullptr;
-	KamataEngine::Model* outerModel_ = nullptr;
+	OptimizedModel* innerModel_ = nullptr;
+	OptimizedModel* outerModel_ = nullptr;
 
 	// カメラ
 	KamataEngine::Camera camera_;
@@ -193,7 +194,8 @@ private:
 	// ワールド変換データ
 	KamataEngine::WorldTransform worldTransform_;
 
-	KamataEngine::ObjectColor color_;
+	// 外側のモデルに乗せる色
+	const KamataEngine::Vector4 color_ = {1.0f, 1.0f, 1.0f, 0.5f};
 
 	// 速度
 	KamataEngine::Vector3 velocity_ = {};
@@ -267,7 +269,7 @@ private:
 	KamataEngine::Vector3 attackVelocity_ = {1.0f, 0.0f, 0.0f};
 
 	// 攻撃エフェクト
-	KamataEngine::Model* modelAttack_ = nullptr;
+	OptimizedModel* modelAttack_ = nullptr;
 	KamataEngine::WorldTransform worldTransformAttack_;
 	bool attackEffectVisible_ = false;
 
@@ -314,9 +316,6 @@ private:
 	// --- ワイヤー可視化（デバッグ） ---
 	bool isWireVisualVisible_ = true;
 
-	// ワイヤー本体（細長いモデルを伸ばして線に見せる）
-	KamataEngine::WorldTransform wireVisualTransform_;
-
 	// アンカー位置のマーカー（小さいモデル）
 	KamataEngine::WorldTransform wireAnchorVisualTransform_;
 
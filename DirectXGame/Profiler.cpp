@@ -0,0 +1,360 @@
+#define NOMINMAX
+#include "Profiler.h"
+#include "FrameArena.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
+
+namespace {
+
+// 読んでいる間に書き足されても上書きされないように、リングの最後のこれだけは読まない
+constexpr uint32_t kReadMargin = 1024;
+
+// 呼んだスレッドの入れ子の深さ
+thread_local uint32_t tDepth = 0;
+
+double GetMicroseconds() { return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+void WriteEscaped(std::ofstream& file, std::string_view text) {
+	for (char c : text) {
+		if (c == '"' || c == '\\') {
+			file.put('\\');
+		}
+		file.put(c);
+	}
+}
+
+} // namespace
+
+/// <summary>
+/// スレッドが持つリングの参照（スレッドが終わるとリングを返す）
+/// </summary>
+struct ProfilerThreadSlot {
+	Profiler::ThreadBuffer* buffer = nullptr;
+
+	~ProfilerThreadSlot() {
+		if (buffer) {
+			Profiler::GetInstance()->ReleaseThreadBuffer(buffer);
+		}
+	}
+};
+
+namespace {
+
+thread_local ProfilerThreadSlot tThreadSlot;
+
+} // namespace
+
+Profiler* Profiler::GetInstance() {
+	static Profiler instance;
+	return &instance;
+}
+
+Profiler::Profiler() {
+
+	startTimestamp_ = GetTimestamp();
+	startMicroseconds_ = GetMicroseconds();
+}
+
+Profiler::~Profiler() {
+
+	for (ThreadBuffer* buffer : threads_) {
+		delete buffer;
+	}
+	threads_.clear();
+}
+
+uint64_t Profiler::GetTimestamp() { return __rdtsc(); }
+
+void Profiler::BeginFrame() {
+
+	frames_[frameCount_ % kFrameHistory] = GetTimestamp();
+	++frameCount_;
+	Calibrate();
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+
+	ThreadBuffer* buffer = GetThreadBuffer();
+	std::scoped_lock lock(mutex_);
+	buffer->name = name;
+}
+
+void Profiler::Record(const char* name, uint64_t begin, uint64_t end, uint32_t depth) {
+
+	ThreadBuffer* buffer = GetThreadBuffer();
+	const uint64_t index = buffer->writeCount.load(std::memory_order_relaxed);
+	buffer->events[index & (kEventsPerThread - 1)] = {name, begin, end, depth};
+	// 書き終えてから読む側に見せる
+	buffer->writeCount.store(index + 1, std::memory_order_release);
+}
+
+double Profiler::ToMilliseconds(uint64_t ticks) const { return static_cast<double>(ticks) / ticksPerMicrosecond_.load(std::memory_order_relaxed) / 1000.0; }
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+
+	if (tThreadSlot.buffer) {
+		return tThreadSlot.buffer;
+	}
+
+	std::scoped_lock lock(mutex_);
+
+	// 終わったスレッドのリングがあれば中身ごと使い回す
+	ThreadBuffer* buffer = nullptr;
+	for (ThreadBuffer* candidate : threads_) {
+		if (!candidate->inUse) {
+			buffer = candidate;
+			break;
+		}
+	}
+	if (!buffer) {
+		buffer = new ThreadBuffer();
+		buffer->id = static_cast<uint32_t>(threads_.size());
+		buffer->events.resize(kEventsPerThread);
+		threads_.push_back(buffer);
+	}
+	buffer->name = "Thread " + std::to_string(buffer->id);
+	buffer->inUse = true;
+
+	tThreadSlot.buffer = buffer;
+	return buffer;
+}
+
+void Profiler::ReleaseThreadBuffer(ThreadBuffer* buffer) {
+
+	std::scoped_lock lock(mutex_);
+	buffer->inUse = false;
+}
+
+void Profiler::Capture(uint64_t begin, uint64_t end, std::vector<CapturedEvent>& output) {
+
+	std::scoped_lock lock(mutex_);
+
+	for (ThreadBuffer* buffer : threads_) {
+		const uint64_t writeCount = buffer->writeCount.load(std::memory_order_acquire);
+		const uint64_t readable = kEventsPerThread - kReadMargin;
+		const uint64_t first = writeCount > readable ? writeCount - readable : 0;
+
+		for (uint64_t i = first; i < writeCount; ++i) {
+			const ProfileEvent& event = buffer->events[i & (kEventsPerThread - 1)];
+			if (event.end > begin && event.begin < end) {
+				output.push_back({event, buffer->id});
+			}
+		}
+	}
+}
+
+void Profiler::Calibrate() {
+
+	// 1ms 以上経ってから比を取る（それまでは 1GHz とみなす）
+	const double elapsed = GetMicroseconds() - startMicroseconds_;
+	if (elapsed > 1000.0) {
+		ticksPerMicrosecond_.store(static_cast<double>(GetTimestamp() - startTimestamp_) / elapsed, std::memory_order_relaxed);
+	}
+}
+
+void Profiler::DrawOverlay() {
+#ifdef USE_IMGUI
+
+	ImGui::Begin("Profiler");
+
+	// フレーム時間の推移
+	const uint32_t frameCount = static_cast<uint32_t>(std::min<uint64_t>(frameCount_, kFrameHistory));
+	if (frameCount >= 2) {
+		float times[kFrameHistory] = {};
+		const uint64_t first = frameCount_ - frameCount;
+		for (uint32_t i = 0; i + 1 < frameCount; ++i) {
+			times[i] = static_cast<float>(ToMilliseconds(frames_[(first + i + 1) % kFrameHistory] - frames_[(first + i) % kFrameHistory]));
+		}
+		char overlay[32];
+		std::snprintf(overlay, sizeof(overlay), "%.2f ms", times[frameCount - 2]);
+		ImGui::PlotLines("##frames", times, frameCount - 1, 0, overlay, 0.0f, 33.3f, ImVec2(-1.0f, 60.0f));
+	}
+
+	ImGui::Checkbox("Pause", &paused_);
+
+	// 直前のフレーム（最後の2つの印の間）を読み出す
+	if (!paused_ && frameCount >= 2) {
+		snapshotBegin_ = frames_[(frameCount_ - 2) % kFrameHistory];
+		snapshotEnd_ = frames_[(frameCount_ - 1) % kFrameHistory];
+		snapshot_.clear();
+		Capture(snapshotBegin_, snapshotEnd_, snapshot_);
+	}
+	if (snapshotEnd_ <= snapshotBegin_) {
+		ImGui::End();
+		return;
+	}
+
+	// 表示のための一時的な列は FrameArena に置く
+	std::pmr::memory_resource* frameArena = FrameArena::GetInstance();
+
+	std::pmr::vector<std::pmr::string> threadNames(frameArena);
+	{
+		std::scoped_lock lock(mutex_);
+		for (ThreadBuffer* buffer : threads_) {
+			threadNames.emplace_back(buffer->name);
+		}
+	}
+
+	// スレッドごとの段数（区間の無いスレッドは出さない）
+	std::pmr::vector<uint32_t> rows(threadNames.size(), 0, frameArena);
+	for (const CapturedEvent& captured : snapshot_) {
+		rows[captured.threadId] = std::max(rows[captured.threadId], captured.event.depth + 1);
+	}
+	std::pmr::vector<float> rowTops(threadNames.size(), 0.0f, frameArena);
+
+	constexpr float kLabelWidth = 100.0f;
+	constexpr float kRowHeight = 18.0f;
+	constexpr float kThreadSpacing = 6.0f;
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	const ImVec2 origin = ImGui::GetCursorScreenPos();
+	const float width = std::max(ImGui::GetContentRegionAvail().x - kLabelWidth, 100.0f);
+	const double frameTicks = static_cast<double>(snapshotEnd_ - snapshotBegin_);
+
+	// スレッドの名前
+	float top = origin.y;
+	for (size_t i = 0; i < threadNames.size(); ++i) {
+		if (rows[i] == 0) {
+			continue;
+		}
+		rowTops[i] = top;
+		drawList->AddText(ImVec2(origin.x, top), IM_COL32(220, 220, 220, 255), threadNames[i].c_str());
+		top += rows[i] * kRowHeight + kThreadSpacing;
+	}
+
+	// 区間を深さごとの段に並べる（フレームの外にはみ出した分は切る）
+	const ImVec2 mouse = ImGui::GetIO().MousePos;
+	const CapturedEvent* hovered = nullptr;
+	for (const CapturedEvent& captured : snapshot_) {
+		const ProfileEvent& event = captured.event;
+		const double begin = static_cast<double>(std::max(event.begin, snapshotBegin_) - snapshotBegin_) / frameTicks;
+		const double end = static_cast<double>(std::min(event.end, snapshotEnd_) - snapshotBegin_) / frameTicks;
+
+		const ImVec2 min(origin.x + kLabelWidth + static_cast<float>(begin) * width, rowTops[captured.threadId] + event.depth * kRowHeight);
+		const ImVec2 max(std::max(origin.x + kLabelWidth + static_cast<float>(end) * width, min.x + 1.0f), min.y + kRowHeight - 1.0f);
+
+		// 名前ごとに色を変える
+		const float hue = static_cast<float>(std::hash<std::string_view>()(event.name) % 360) / 360.0f;
+		drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.8f));
+		if (max.x - min.x > 30.0f) {
+			drawList->PushClipRect(min, max, true);
+			drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32(0, 0, 0, 255), event.name);
+			drawList->PopClipRect();
+		}
+		if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+			hovered = &captured;
+		}
+	}
+	ImGui::Dummy(ImVec2(kLabelWidth + width, top - origin.y));
+
+	if (hovered) {
+		ImGui::SetTooltip("%s\n%.3f ms", hovered->event.name, ToMilliseconds(hovered->event.end - hovered->event.begin));
+	}
+
+	// 名前ごとの合計（入れ子の内側も含む時間）
+	struct Total {
+		double milliseconds = 0.0;
+		uint32_t calls = 0;
+	};
+	std::pmr::unordered_map<std::string_view, Total> totals(frameArena);
+	for (const CapturedEvent& captured : snapshot_) {
+		Total& total = totals[captured.event.name];
+		total.milliseconds += ToMilliseconds(captured.event.end - captured.event.begin);
+		++total.calls;
+	}
+	std::pmr::vector<std::pair<std::string_view, Total>> sorted(totals.begin(), totals.end(), frameArena);
+	std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.milliseconds > b.second.milliseconds; });
+
+	ImGui::Text("Frame %.3f ms", ToMilliseconds(snapshotEnd_ - snapshotBegin_));
+	if (ImGui::BeginTable("zones", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+		ImGui::TableSetupColumn("Zone");
+		ImGui::TableSetupColumn("ms");
+		ImGui::TableSetupColumn("calls");
+		ImGui::TableHeadersRow();
+		for (const auto& [name, total] : sorted) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(name.data(), name.data() + name.size());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", total.milliseconds);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", total.calls);
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+#endif
+}
+
+bool Profiler::WriteChromeTrace(const std::string& filePath) {
+
+	Calibrate();
+
+	std::vector<CapturedEvent> events;
+	Capture(0, UINT64_MAX, events);
+
+	std::ofstream file(filePath, std::ios_base::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	const double ticksPerMicrosecond = ticksPerMicrosecond_.load(std::memory_order_relaxed);
+	auto toMicroseconds = [&](uint64_t timestamp) { return static_cast<double>(static_cast<int64_t>(timestamp - startTimestamp_)) / ticksPerMicrosecond; };
+
+	char line[256];
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	// スレッドの名前
+	bool first = true;
+	{
+		std::scoped_lock lock(mutex_);
+		for (ThreadBuffer* buffer : threads_) {
+			file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":\"";
+			WriteEscaped(file, buffer->name);
+			file << "\"}}";
+			first = false;
+		}
+	}
+
+	// 区間（ph:X は開始と長さで表す）
+	for (const CapturedEvent& captured : events) {
+		file << (first ? "" : ",\n") << "{\"name\":\"";
+		WriteEscaped(file, captured.event.name);
+		std::snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", captured.threadId, toMicroseconds(captured.event.begin),
+		              static_cast<double>(captured.event.end - captured.event.begin) / ticksPerMicrosecond);
+		file << line;
+		first = false;
+	}
+
+	// フレームの境目（全体に引く線）
+	const uint64_t frameCount = std::min<uint64_t>(frameCount_, kFrameHistory);
+	for (uint64_t i = frameCount_ - frameCount; i < frameCount_; ++i) {
+		std::snprintf(line, sizeof(line), "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}", toMicroseconds(frames_[i % kFrameHistory]));
+		file << (first ? "" : ",\n") << line;
+		first = false;
+	}
+
+	file << "\n]}\n";
+	return static_cast<bool>(file);
+}
+
+ProfileZone::ProfileZone(const char* name) : name_(name), begin_(Profiler::GetTimestamp()), depth_(tDepth++) {}
+
+ProfileZone::~ProfileZone() {
+
+	const uint64_t end = Profiler::GetTimestamp();
+	--tDepth;
+	Profiler::GetInstance()->Record(name_, begin_, end, depth_);
+}
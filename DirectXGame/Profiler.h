@@ -0,0 +1,163 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 計測した1区間
+/// </summary>
+struct ProfileEvent {
+	// 区間の名前（文字列リテラル）
+	const char* name = nullptr;
+	// 開始と終了のタイムスタンプ（Profiler::GetTimestamp）
+	uint64_t begin = 0;
+	uint64_t end = 0;
+	// 入れ子の深さ（0が一番外）
+	uint32_t depth = 0;
+};
+
+/// <summary>
+/// 区間の計測器
+/// PROFILE_ZONE で囲んだ区間の開始と終了をスレッドごとのリングに書き、確保もロックもしない
+/// フレームの境目は BeginFrame で印を付け、ImGui の表示（Debug のみ）と Chrome のトレース形式の書き出しに使う
+/// 古い区間はリングが一周すると上書きされる
+/// </summary>
+class Profiler {
+public:
+	// 1スレッドのリングに残す区間の数
+	static constexpr uint32_t kEventsPerThread = 1 << 14;
+	// フレームの境目を残す数
+	static constexpr uint32_t kFrameHistory = 256;
+
+	static Profiler* GetInstance();
+
+	/// <summary>
+	/// 今のタイムスタンプ（rdtsc）
+	/// </summary>
+	static uint64_t GetTimestamp();
+
+	/// <summary>
+	/// フレームの始まりに印を付ける（メインスレッドから毎フレーム呼ぶ）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 呼んだスレッドの名前（トレースと表示に使う）
+	/// </summary>
+	void SetThreadName(const std::string& name);
+
+	/// <summary>
+	/// 区間を書き込む（ProfileZone から呼ばれる）
+	/// </summary>
+	void Record(const char* name, uint64_t begin, uint64_t end, uint32_t depth);
+
+	/// <summary>
+	/// タイムスタンプの差をミリ秒にする
+	/// </summary>
+	double ToMilliseconds(uint64_t ticks) const;
+
+	/// <summary>
+	/// 直前のフレームのタイムラインと区間ごとの合計を ImGui で表示する（USE_IMGUI の時だけ）
+	/// </summary>
+	void DrawOverlay();
+
+	/// <summary>
+	/// 残っている区間を Chrome のトレース形式（chrome://tracing や Perfetto で開ける JSON）で書き出す
+	/// </summary>
+	/// <param name="filePath">出力先</param>
+	/// <returns>書き出せたか</returns>
+	bool WriteChromeTrace(const std::string& filePath);
+
+private:
+	Profiler();
+	~Profiler();
+	Profiler(const Profiler&) = delete;
+	const Profiler& operator=(const Profiler&) = delete;
+
+	/// <summary>
+	/// スレッドごとのリング（書くのは持ち主のスレッドだけ）
+	/// スレッドが終わると空きに戻り、中身を残したまま次のスレッドが使い回す
+	/// </summary>
+	struct ThreadBuffer {
+		std::string name;
+		// トレースでのスレッド番号
+		uint32_t id = 0;
+		std::vector<ProfileEvent> events;
+		// 書き終えた区間の数（読む側はここまでを読む）
+		std::atomic<uint64_t> writeCount = 0;
+		bool inUse = false;
+	};
+
+	/// <summary>
+	/// 読み出した区間（どのスレッドのものか）
+	/// </summary>
+	struct CapturedEvent {
+		ProfileEvent event;
+		uint32_t threadId;
+	};
+
+	/// <summary>
+	/// 呼んだスレッドのリング（初めてなら空きを借りるか作る）
+	/// </summary>
+	ThreadBuffer* GetThreadBuffer();
+
+	/// <summary>
+	/// スレッドが終わった時にリングを空きに戻す
+	/// </summary>
+	void ReleaseThreadBuffer(ThreadBuffer* buffer);
+
+	/// <summary>
+	/// [begin, end) と重なる区間を全スレッドのリングから集める
+	/// </summary>
+	void Capture(uint64_t begin, uint64_t end, std::vector<CapturedEvent>& output);
+
+	/// <summary>
+	/// タイムスタンプと時計の進み方の比を測り直す
+	/// </summary>
+	void Calibrate();
+
+	friend struct ProfilerThreadSlot;
+
+	std::mutex mutex_;
+	std::vector<ThreadBuffer*> threads_;
+
+	// 測り始めのタイムスタンプと時刻（マイクロ秒）
+	uint64_t startTimestamp_ = 0;
+	double startMicroseconds_ = 0.0;
+	// 1マイクロ秒あたりのタイムスタンプ
+	std::atomic<double> ticksPerMicrosecond_ = 1000.0;
+
+	// フレームの始まり
+	uint64_t frames_[kFrameHistory] = {};
+	uint64_t frameCount_ = 0;
+
+	// 表示を止めて見比べる
+	bool paused_ = false;
+	std::vector<CapturedEvent> snapshot_;
+	uint64_t snapshotBegin_ = 0;
+	uint64_t snapshotEnd_ = 0;
+};
+
+/// <summary>
+/// 区間の計測（作ってから壊れるまで）
+/// </summary>
+class ProfileZone {
+public:
+	explicit ProfileZone(const char* name);
+	~ProfileZone();
+	ProfileZone(const ProfileZone&) = delete;
+	ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+	const char* name_;
+	uint64_t begin_;
+	uint32_t depth_;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// この行からスコープの終わりまでを name（文字列リテラル）として計測する
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
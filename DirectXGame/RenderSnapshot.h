@@ -0,0 +1,99 @@
+#pragma once
+#include "DrawListRecorder.h"
+#include "KamataEngine.h"
+#include <cstdint>
+#include <vector>
+
+class OptimizedModel;
+
+/// <summary>
+/// 1ティック分の描画に要る状態の写し
+/// 更新側が1ティックの終わりに作り、描画スレッドはこれだけを見て描画命令を作る（シーンのオブジェクトには触らない）
+/// モデルはシーンの間は解放されないのでポインタで持ち、行列と色は値で持つ
+/// </summary>
+struct RenderSnapshot {
+	// モデルのテクスチャのまま描く
+	static constexpr uint32_t kModelTexture = UINT32_MAX;
+
+	/// <summary>
+	/// モデル1つ分の描画
+	/// </summary>
+	struct ModelDraw {
+		// どちらか一方
+		KamataEngine::Model* model = nullptr;
+		OptimizedModel* optimizedModel = nullptr;
+		KamataEngine::Matrix4x4 matWorld;
+		// 貼り替えるテクスチャ（kModelTexture なら貼り替えない）
+		uint32_t textureHandle = kModelTexture;
+		// ObjectColor で乗せる色（hasColor の時だけ）
+		KamataEngine::Vector4 color = {1.0f, 1.0f, 1.0f, 1.0f};
+		bool hasColor = false;
+		// 描く前に Model::SetAlpha で設定する値（負なら設定しない）
+		float modelAlpha = -1.0f;
+		// 記録するリストの種類
+		RenderPass pass = RenderPass::kBlocks;
+	};
+
+	// カメラ
+	KamataEngine::Matrix4x4 matView;
+	KamataEngine::Matrix4x4 matProjection;
+	KamataEngine::Vector3 cameraRotation;
+	KamataEngine::Vector3 cameraTranslation;
+
+	// 描く順に並べたモデル（リストに分ける時は種類ごとにこの順を保つ）
+	std::vector<ModelDraw> models;
+	// これから追加するモデルの種類
+	RenderPass currentPass = RenderPass::kBlocks;
+
+	// フェードの黒いスプライト
+	bool fadeVisible = false;
+	float fadeAlpha = 0.0f;
+
+	/// <summary>
+	/// 中身を空にする（容量は残す）
+	/// </summary>
+	void Clear() {
+		models.clear();
+		currentPass = RenderPass::kBlocks;
+		fadeVisible = false;
+		fadeAlpha = 0.0f;
+	}
+
+	/// <summary>
+	/// カメラを写す（行列は更新済みであること）
+	/// </summary>
+	void SetCamera(const KamataEngine::Camera& camera) {
+		matView = camera.matView;
+		matProjection = camera.matProjection;
+		cameraRotation = camera.rotation_;
+		cameraTranslation = camera.translation_;
+	}
+
+	/// <summary>
+	/// これから追加するモデルの種類を設定する
+	/// </summary>
+	void SetPass(RenderPass pass) { currentPass = pass; }
+
+	/// <summary>
+	/// モデルを追加する
+	/// </summary>
+	ModelDraw& AddModel(KamataEngine::Model* model, const KamataEngine::Matrix4x4& matWorld, uint32_t textureHandle = kModelTexture) {
+		ModelDraw& draw = models.emplace_back();
+		draw.model = model;
+		draw.matWorld = matWorld;
+		draw.textureHandle = textureHandle;
+		draw.pass = currentPass;
+		return draw;
+	}
+
+	/// <summary>
+	/// 最適化済みモデルを追加する
+	/// </summary>
+	ModelDraw& AddModel(OptimizedModel* optimizedModel, const KamataEngine::Matrix4x4& matWorld) {
+		ModelDraw& draw = models.emplace_back();
+		draw.optimizedModel = optimizedModel;
+		draw.matWorld = matWorld;
+		draw.pass = currentPass;
+		return draw;
+	}
+};
@@ -0,0 +1,72 @@
+#include "RenderThread.h"
+#include "Profiler.h"
+#include <cassert>
+
+RenderThread* RenderThread::GetInstance() {
+	static RenderThread instance;
+	return &instance;
+}
+
+void RenderThread::Initialize() {
+
+	assert(!thread_.joinable());
+	exit_ = false;
+	thread_ = std::thread(&RenderThread::Run, this);
+}
+
+void RenderThread::Finalize() {
+
+	if (!thread_.joinable()) {
+		return;
+	}
+
+	Wait();
+	{
+		std::scoped_lock lock(mutex_);
+		exit_ = true;
+	}
+	condition_.notify_all();
+	thread_.join();
+}
+
+void RenderThread::Kick(void (*invoke)(void*), void* context) {
+
+	{
+		std::scoped_lock lock(mutex_);
+		assert(!invoke_);
+		invoke_ = invoke;
+		context_ = context;
+	}
+	condition_.notify_all();
+}
+
+void RenderThread::Wait() {
+
+	PROFILE_ZONE("RenderThread::Wait");
+
+	std::unique_lock lock(mutex_);
+	condition_.wait(lock, [this] { return !invoke_; });
+}
+
+void RenderThread::Run() {
+
+	Profiler::GetInstance()->SetThreadName("Render");
+
+	std::unique_lock lock(mutex_);
+	while (true) {
+		condition_.wait(lock, [this] { return invoke_ || exit_; });
+		if (exit_) {
+			break;
+		}
+
+		void (*invoke)(void*) = invoke_;
+		void* context = context_;
+		lock.unlock();
+		invoke(context);
+		lock.lock();
+
+		invoke_ = nullptr;
+		context_ = nullptr;
+		condition_.notify_all();
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// 描画命令を作るスレッド
+/// メインスレッドが次のティックを更新している間に、前のティックのスナップショットから描画命令を作る
+/// （モデルはジョブがバンドルに並列に記録し、ここではそれを順に実行する）
+/// フレームごとに Kick で1つの処理を渡し、PostDraw の前に Wait で終わりを待つ
+/// </summary>
+class RenderThread {
+public:
+	static RenderThread* GetInstance();
+
+	/// <summary>
+	/// 初期化（スレッドを立てる）
+	/// </summary>
+	void Initialize();
+
+	/// <summary>
+	/// 終了処理（処理中なら終わるのを待ってスレッドを止める）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 処理を始めさせる（前の処理は Wait 済みであること）
+	/// </summary>
+	/// <param name="function">引数なしで呼べる関数オブジェクト（Wait が返るまで生きていること）</param>
+	template<typename Function>
+	void Kick(Function& function) {
+		Kick([](void* context) { (*static_cast<Function*>(context))(); }, &function);
+	}
+
+	/// <summary>
+	/// Kick した処理が終わるまで待つ
+	/// </summary>
+	void Wait();
+
+private:
+	RenderThread() = default;
+	~RenderThread() = default;
+	RenderThread(const RenderThread&) = delete;
+	const RenderThread& operator=(const RenderThread&) = delete;
+
+	void Kick(void (*invoke)(void*), void* context);
+
+	/// <summary>
+	/// スレッド本体
+	/// </summary>
+	void Run();
+
+	std::thread thread_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+
+	// 渡された処理（終わったら nullptr に戻す）
+	void (*invoke_)(void*) = nullptr;
+	void* context_ = nullptr;
+	bool exit_ = false;
+};
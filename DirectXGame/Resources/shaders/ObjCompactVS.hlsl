@@ -0,0 +1,40 @@
+#include "Obj.hlsli"
+
+// 量子化の復元用パラメータ（メッシュごと、VertexQuantization::Params と同じ値）
+cbuffer Quantization : register(b5) {
+	float4 q_position_min;   // xyz: 座標の最小値（メッシュのAABB）
+	float4 q_position_scale; // xyz: AABBの大きさ
+	float4 q_uv;             // xy: uvの最小値 zw: uvの範囲
+};
+
+// 八面体エンコードされた法線を復元する（VertexQuantization::DecodeOctahedral と同じ式）
+float3 DecodeOctahedral(float2 encoded) {
+	float3 normal = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+	// 下半球の折り返しを戻す
+	if (normal.z < 0.0f) {
+		float2 signs = float2(normal.x >= 0.0f ? 1.0f : -1.0f, normal.y >= 0.0f ? 1.0f : -1.0f);
+		normal.xy = (1.0f - abs(normal.yx)) * signs;
+	}
+	return normalize(normal);
+}
+
+// 座標は R16G16B16A16_UNORM、法線は R16G16_SNORM、uvは R16G16_UNORM で入ってくる
+VSOutput main(float4 qpos : POSITION, float2 qnormal : NORMAL, float2 quv : TEXCOORD) {
+	float4 pos = float4(q_position_min.xyz + qpos.xyz * q_position_scale.xyz, 1.0f);
+	float3 normal = DecodeOctahedral(qnormal);
+	float2 uv = q_uv.xy + quv * q_uv.zw;
+
+	// 以降は ObjVS と同じ
+	// ※スケーリングが一様な場合のみ正しい
+	float4 worldNormal = normalize(mul(float4(normal, 0), world));
+	float4 worldPos = mul(pos, world);
+
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(pos, mul(world, mul(view, projection)));
+
+	output.worldpos = worldPos;
+	output.normal = worldNormal.xyz;
+	output.uv = uv;
+
+	return output;
+}
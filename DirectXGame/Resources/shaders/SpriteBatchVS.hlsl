@@ -0,0 +1,9 @@
+#include "SpriteBatch.hlsli"
+
+VSOutput main(float2 pos : POSITION, float2 uv : TEXCOORD, float4 color : COLOR) {
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(float4(pos, 0.0f, 1.0f), projection);
+	output.uv = uv;
+	output.color = color;
+	return output;
+}
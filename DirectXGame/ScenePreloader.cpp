@@ -0,0 +1,91 @@
+#include "ScenePreloader.h"
+#include "Profiler.h"
+
+using namespace KamataEngine;
+
+ScenePreloader::~ScenePreloader() { Reset(); }
+
+void ScenePreloader::Start(const AssetManifest& manifest) {
+
+	// 前回分が残っていれば片付ける
+	Reset();
+
+	manifest_ = manifest;
+	totalCount_ = static_cast<uint32_t>(manifest_.models.size() + manifest_.optimizedModels.size() + manifest_.textures.size());
+	loadedCount_ = 0;
+	started_ = true;
+
+	// 読み込み結果の格納先はワーカー開始前に確保しておく
+	models_.reserve(manifest_.models.size());
+	optimizedModels_.reserve(manifest_.optimizedModels.size());
+	textures_.reserve(manifest_.textures.size());
+
+	worker_ = std::thread(&ScenePreloader::Load, this);
+}
+
+bool ScenePreloader::IsCompleted() const { return started_ && loadedCount_.load(std::memory_order_acquire) >= totalCount_; }
+
+float ScenePreloader::GetProgress() const {
+
+	if (!started_) {
+		return 0.0f;
+	}
+
+	if (totalCount_ == 0) {
+		return 1.0f;
+	}
+
+	return static_cast<float>(loadedCount_.load(std::memory_order_acquire)) / static_cast<float>(totalCount_);
+}
+
+void ScenePreloader::Reset() {
+
+	if (worker_.joinable()) {
+		worker_.join();
+	}
+
+	// 先読みの参照を返す（シーン側が取得済みなら参照は残る）
+	AssetManager* assetManager = AssetManager::GetInstance();
+	for (Model* model : models_) {
+		assetManager->ReleaseModel(model);
+	}
+	for (OptimizedModel* model : optimizedModels_) {
+		assetManager->ReleaseOptimizedModel(model);
+	}
+	for (uint32_t handle : textures_) {
+		assetManager->ReleaseTexture(handle);
+	}
+
+	models_.clear();
+	optimizedModels_.clear();
+	textures_.clear();
+	manifest_ = {};
+	totalCount_ = 0;
+	loadedCount_ = 0;
+	started_ = false;
+}
+
+void ScenePreloader::Load() {
+
+	// KamataEngineの読み込み処理は同時実行を想定していないため、
+	// 1本のワーカーで順に読み込み、メインスレッドのフェード処理と並行させる
+	AssetManager* assetManager = AssetManager::GetInstance();
+
+	Profiler::GetInstance()->SetThreadName("Scene Preloader");
+	PROFILE_ZONE("ScenePreloader::Load");
+
+	for (const auto& [name, smoothing] : manifest_.models) {
+		models_.push_back(assetManager->AcquireModel(name, smoothing));
+		loadedCount_.fetch_add(1, std::memory_order_release);
+	}
+
+	for (const auto& [name, smoothing] : manifest_.optimizedModels) {
+		optimizedModels_.push_back(assetManager->AcquireOptimizedModel(name, smoothing));
+		loadedCount_.fetch_add(1, std::memory_order_release);
+	}
+
+	for (const std::string& fileName : manifest_.textures) {
+		textures_.push_back(assetManager->AcquireTexture(fileName));
+		loadedCount_.fetch_add(1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "AssetManager.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// 次のシーンのアセット先読み
+/// フェードアウト開始時にワーカースレッドで読み込みを始め、
+/// シーン切り替えは読み込み完了まで待つ
+/// </summary>
+class ScenePreloader {
+public:
+	/// <summary>
+	/// デストラクタ（読み込み中なら完了を待つ）
+	/// </summary>
+	~ScenePreloader();
+
+	/// <summary>
+	/// 先読み開始
+	/// </summary>
+	/// <param name="manifest">次のシーンのアセット一覧</param>
+	void Start(const AssetManifest& manifest);
+
+	/// <summary>
+	/// 先読みを開始済みか
+	/// </summary>
+	bool IsStarted() const { return started_; }
+
+	/// <summary>
+	/// 先読みが完了したか
+	/// </summary>
+	bool IsCompleted() const;
+
+	/// <summary>
+	/// 進捗（0.0f〜1.0f）
+	/// </summary>
+	float GetProgress() const;
+
+	/// <summary>
+	/// 先読みで確保した参照を手放す
+	/// 次のシーンの初期化（自前の参照を取得）が終わってから呼ぶ
+	/// </summary>
+	void Reset();
+
+private:
+	/// <summary>
+	/// ワーカースレッド本体
+	/// </summary>
+	void Load();
+
+	// 読み込み対象
+	AssetManifest manifest_;
+
+	// 読み込みスレッド
+	std::thread worker_;
+
+	// 先読みで確保した参照
+	std::vector<KamataEngine::Model*> models_;
+	std::vector<OptimizedModel*> optimizedModels_;
+	std::vector<uint32_t> textures_;
+
+	// 読み込み済み数/総数
+	std::atomic<uint32_t> loadedCount_ = 0;
+	uint32_t totalCount_ = 0;
+
+	bool started_ = false;
+};
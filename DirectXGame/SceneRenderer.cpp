@@ -0,0 +1,182 @@
+#include "SceneRenderer.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+#include "OptimizedModel.h"
+#include "OptimizedModelPipeline.h"
+#include "Profiler.h"
+#include <cassert>
+#include <memory_resource>
+
+using namespace KamataEngine;
+
+namespace {
+
+// リストごとのパイプライン（最適化済みモデルは量子化頂点なので、別のリストに分けて別のパイプラインで描く）
+enum ListPipeline : uint8_t {
+	kModelPipeline,          // Model::PreDraw のパイプライン
+	kOptimizedModelPipeline, // OptimizedModelPipeline
+};
+
+} // namespace
+
+void SceneRenderer::Initialize() {
+
+	camera_.Initialize();
+
+	lightGroup_ = LightGroup::Create();
+	lightGroup_->Update();
+}
+
+SceneRenderer::~SceneRenderer() {
+
+	// 記録中のジョブが残っていないこと
+	recorder_.Wait();
+
+	for (Bundle* bundle : bundles_) {
+		for (WorldTransform* worldTransform : bundle->worldTransforms) {
+			delete worldTransform;
+		}
+		for (ObjectColor* objectColor : bundle->objectColors) {
+			delete objectColor;
+		}
+		delete bundle;
+	}
+	bundles_.clear();
+
+	delete lightGroup_;
+}
+
+void SceneRenderer::Kick(const RenderSnapshot& snapshot) {
+
+	PROFILE_ZONE("SceneRenderer::Kick");
+
+	snapshot_ = &snapshot;
+
+	// カメラ
+	camera_.matView = snapshot.matView;
+	camera_.matProjection = snapshot.matProjection;
+	camera_.rotation_ = snapshot.cameraRotation;
+	camera_.translation_ = snapshot.cameraTranslation;
+	camera_.TransferMatrix();
+
+	// アルファはモデルのマテリアルに書くので、並列に記録する前にここで書いておく
+	// （定数バッファは1つなので、同じモデルに違う値を書いた時は前と同じく最後の値で描かれる）
+	std::pmr::vector<RenderPass> passes(FrameArena::GetInstance());
+	std::pmr::vector<uint8_t> pipelines(FrameArena::GetInstance());
+	passes.reserve(snapshot.models.size());
+	pipelines.reserve(snapshot.models.size());
+	for (const RenderSnapshot::ModelDraw& draw : snapshot.models) {
+		if (draw.modelAlpha >= 0.0f) {
+			if (draw.optimizedModel) {
+				draw.optimizedModel->SetAlpha(draw.modelAlpha);
+			} else {
+				draw.model->SetAlpha(draw.modelAlpha);
+			}
+		}
+		passes.push_back(draw.pass);
+		pipelines.push_back(draw.optimizedModel ? kOptimizedModelPipeline : kModelPipeline);
+	}
+
+	recorder_.Kick(passes, this, pipelines);
+}
+
+void SceneRenderer::Draw() {
+
+	PROFILE_ZONE("Model::Draw");
+
+	recorder_.Submit();
+}
+
+void SceneRenderer::BeginLists(uint32_t listCount) {
+
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	while (bundles_.size() < listCount) {
+		Bundle* bundle = new Bundle();
+		HRESULT result = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_BUNDLE, IID_PPV_ARGS(&bundle->commandAllocator));
+		assert(SUCCEEDED(result));
+		result = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_BUNDLE, bundle->commandAllocator.Get(), nullptr, IID_PPV_ARGS(&bundle->commandList));
+		assert(SUCCEEDED(result));
+		bundle->commandList->Close();
+		bundles_.push_back(bundle);
+	}
+
+	// 前のフレームの実行は PostDraw で終わっているので、そのまま記録し直せる
+	// パイプラインとルートシグネチャは Model::PreDraw に積ませる（ModelCommon は1本ずつしか扱えないので、ここで順に行う）
+	// 最適化済みモデルだけのリストは OptimizedModelPipeline のものを積む
+	const std::vector<DrawListRecorder::DrawList>& lists = recorder_.GetLists();
+	for (uint32_t i = 0; i < listCount; ++i) {
+		Bundle* bundle = bundles_[i];
+		HRESULT result = bundle->commandAllocator->Reset();
+		assert(SUCCEEDED(result));
+		result = bundle->commandList->Reset(bundle->commandAllocator.Get(), nullptr);
+		assert(SUCCEEDED(result));
+
+		if (lists[i].pipeline == kOptimizedModelPipeline) {
+			OptimizedModelPipeline::GetInstance()->SetPipeline(bundle->commandList.Get());
+		} else {
+			Model::PreDraw(bundle->commandList.Get());
+			Model::PostDraw();
+		}
+	}
+}
+
+void SceneRenderer::RecordList(uint32_t listIndex, RenderPass, std::span<const uint32_t> drawIndices) {
+
+	MemoryTagScope memoryTag(MemoryTag::kGameScene);
+
+	Bundle& bundle = *bundles_[listIndex];
+	ID3D12GraphicsCommandList* commandList = bundle.commandList.Get();
+
+	// カメラとライトはリスト全体で共通
+	commandList->SetGraphicsRootConstantBufferView(static_cast<UINT>(Model::RoomParameter::kCamera), camera_.GetConstBuffer()->GetGPUVirtualAddress());
+	lightGroup_->Draw(commandList, static_cast<UINT>(Model::RoomParameter::kLight));
+
+	size_t colorCount = 0;
+	for (size_t i = 0; i < drawIndices.size(); ++i) {
+		const RenderSnapshot::ModelDraw& draw = snapshot_->models[drawIndices[i]];
+
+		// 行列
+		if (i >= bundle.worldTransforms.size()) {
+			WorldTransform* worldTransform = new WorldTransform();
+			worldTransform->Initialize();
+			bundle.worldTransforms.push_back(worldTransform);
+		}
+		WorldTransform& worldTransform = *bundle.worldTransforms[i];
+		worldTransform.matWorld_ = draw.matWorld;
+		worldTransform.TransferMatrix();
+		commandList->SetGraphicsRootConstantBufferView(static_cast<UINT>(Model::RoomParameter::kWorldTransform), worldTransform.GetConstBuffer()->GetGPUVirtualAddress());
+
+		// 色
+		const ObjectColor* objectColor = ModelCommon::GetInstance()->GetObjectColor();
+		if (draw.hasColor) {
+			if (colorCount >= bundle.objectColors.size()) {
+				ObjectColor* newObjectColor = new ObjectColor();
+				newObjectColor->Initialize();
+				bundle.objectColors.push_back(newObjectColor);
+			}
+			bundle.objectColors[colorCount]->SetColor(draw.color);
+			objectColor = bundle.objectColors[colorCount++];
+		}
+		objectColor->SetGraphicsCommand(commandList, static_cast<UINT>(Model::RoomParameter::kObjectColor));
+
+		// 最適化済みモデルは別のリストに分けてある
+		if (draw.optimizedModel) {
+			draw.optimizedModel->DrawMeshes(commandList);
+			continue;
+		}
+
+		for (const std::unique_ptr<Mesh>& mesh : draw.model->GetMeshes()) {
+			if (draw.textureHandle != RenderSnapshot::kModelTexture) {
+				mesh->Draw(commandList, static_cast<UINT>(Model::RoomParameter::kMaterial), static_cast<UINT>(Model::RoomParameter::kTexture), draw.textureHandle);
+			} else {
+				mesh->Draw(commandList, static_cast<UINT>(Model::RoomParameter::kMaterial), static_cast<UINT>(Model::RoomParameter::kTexture));
+			}
+		}
+	}
+
+	HRESULT result = commandList->Close();
+	assert(SUCCEEDED(result));
+}
+
+void SceneRenderer::SubmitList(uint32_t listIndex) { DirectXCommon::GetInstance()->GetCommandList()->ExecuteBundle(bundles_[listIndex]->commandList.Get()); }
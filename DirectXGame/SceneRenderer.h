@@ -0,0 +1,71 @@
+#pragma once
+#include "DrawListRecorder.h"
+#include "KamataEngine.h"
+#include "RenderSnapshot.h"
+#include <d3d12.h>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// スナップショットのモデルを描画する
+/// モデルは種類ごとのバンドルにジョブで並列に記録し、描画スレッドが描画コマンドリストから種類の順に実行する
+/// （Model::Draw は ModelCommon の1本のコマンドリストにしか積めないので、ルートパラメータとメッシュの描画はここで直接積む）
+/// 行列と色の定数バッファは更新側のオブジェクトのものを使わず、バンドルごとに持つものに写してから描く
+/// （更新側が次のティックで書き換えても、記録中の描画命令が指す中身は変わらない）
+/// </summary>
+class SceneRenderer : public DrawListBackend {
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	void Initialize();
+
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
+	~SceneRenderer() override;
+
+	/// <summary>
+	/// モデルの記録を始める（メインスレッドから、描画スレッドに Draw を渡す前に呼ぶ）
+	/// </summary>
+	/// <param name="snapshot">描画するスナップショット（Draw が返るまで書き換えないこと）</param>
+	void Kick(const RenderSnapshot& snapshot);
+
+	/// <summary>
+	/// 記録が終わるまで、他のジョブを実行しながら待つ（メインスレッドから呼ぶ）
+	/// </summary>
+	void Wait() { recorder_.Wait(); }
+
+	/// <summary>
+	/// 記録したバンドルを種類の順に実行する（Model::PreDraw 〜 Model::PostDraw の間で呼ぶ）
+	/// </summary>
+	void Draw();
+
+	void BeginLists(uint32_t listCount) override;
+	void RecordList(uint32_t listIndex, RenderPass pass, std::span<const uint32_t> drawIndices) override;
+	void SubmitList(uint32_t listIndex) override;
+
+private:
+	/// <summary>
+	/// 1本のリストの記録先
+	/// </summary>
+	struct Bundle {
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
+		// モデルごとに使い回すワールド変換と色（足りなくなったら増やす）
+		std::vector<KamataEngine::WorldTransform*> worldTransforms;
+		std::vector<KamataEngine::ObjectColor*> objectColors;
+	};
+
+	// 描画用のカメラとライト
+	KamataEngine::Camera camera_;
+	KamataEngine::LightGroup* lightGroup_ = nullptr;
+
+	// リストごとのバンドル（足りなくなったら増やす）
+	std::vector<Bundle*> bundles_;
+
+	DrawListRecorder recorder_;
+
+	// 記録中のスナップショット
+	const RenderSnapshot* snapshot_ = nullptr;
+};
@@ -0,0 +1,38 @@
+#include "ShaderCompiler.h"
+#include <Windows.h>
+#include <cassert>
+#include <d3dcompiler.h>
+#include <string>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+using Microsoft::WRL::ComPtr;
+
+namespace ShaderCompiler {
+
+ComPtr<ID3DBlob> Compile(const wchar_t* filePath, const char* target) {
+
+	// 最適化を切ってデバッグ情報を付けるのはデバッグビルドだけ
+#ifdef _DEBUG
+	const UINT compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+	const UINT compileFlags = D3DCOMPILE_OPTIMIZATION_LEVEL3;
+#endif
+
+	ComPtr<ID3DBlob> blob;
+	ComPtr<ID3DBlob> errorBlob;
+	HRESULT result = D3DCompileFromFile(filePath, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target, compileFlags, 0, &blob, &errorBlob);
+
+	if (FAILED(result)) {
+		// エラー内容を出力ウィンドウに表示
+		if (errorBlob) {
+			std::string error(static_cast<const char*>(errorBlob->GetBufferPointer()), errorBlob->GetBufferSize());
+			OutputDebugStringA(error.c_str());
+		}
+		assert(0);
+	}
+
+	return blob;
+}
+
+} // namespace ShaderCompiler
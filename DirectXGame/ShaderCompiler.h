@@ -0,0 +1,18 @@
+#pragma once
+#include <d3dcommon.h>
+#include <wrl.h>
+
+/// <summary>
+/// HLSL のコンパイル（SpriteBatch と OptimizedModel の自前のパイプライン用）
+/// </summary>
+namespace ShaderCompiler {
+
+/// <summary>
+/// シェーダーファイルを読み込んでコンパイルする（失敗したらエラー内容を出力ウィンドウに出して止める）
+/// </summary>
+/// <param name="filePath">ファイルパス</param>
+/// <param name="target">シェーダーモデル（"vs_5_0" など）</param>
+/// <returns>コンパイル結果</returns>
+Microsoft::WRL::ComPtr<ID3DBlob> Compile(const wchar_t* filePath, const char* target);
+
+} // namespace ShaderCompiler
@@ -1,14 +1,16 @@
 #include "Skydome.h"
+#include "AssetManager.h"
 
 using namespace KamataEngine;
 
-void Skydome::Initialize(Model* model) {
+void Skydome::Initialize(OptimizedModel* model) {
 
 	// カメラの初期化
 	camera_.Initialize();
 
 	// モデルの生成
 	model_ = model;
+	bounds_ = AssetManager::GetInstance()->GetBounds(model);
 
 	// ワールドトランスフォームの初期化
 	worldTransform_ = new WorldTransform();
@@ -17,22 +19,18 @@ void Skydome::Initialize(Model* model) {
 
 void Skydome::Update() { WorldTransformUpdate(*worldTransform_); }
 
-void Skydome::Draw(Camera& camera) {
+void Skydome::AddToSnapshot(RenderSnapshot& snapshot, const Frustum& frustum) const {
 
-	// DirectXCommonインスタンスの生成
-	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
+	// 画面外なら描画しない
+	if (bounds_ && !frustum.IsVisible(*bounds_, worldTransform_->matWorld_)) {
+		return;
+	}
 
-	Model::PreDraw(dxCommon->GetCommandList());
-
-	// 3Dモデル描画
-	model_->Draw(*worldTransform_, camera);
-
-	Model::PostDraw();
+	snapshot.AddModel(model_, worldTransform_->matWorld_);
 }
 
 Skydome::~Skydome() {
 
-	delete model_;
-
+	// モデルはAssetManagerが所有するのでここでは解放しない
 	delete worldTransform_;
 }
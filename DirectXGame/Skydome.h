@@ -1,5 +1,7 @@
 #pragma once
+#include "Culling.h"
 #include "KamataEngine.h"
+#include "RenderSnapshot.h"
 #include "WorldMatrixTransform.h"
 
 class Skydome {
@@ -8,7 +10,7 @@ public:
 	/// <summary>
 	/// 初期化
 	/// </summary>
-	void Initialize(KamataEngine::Model* model);
+	void Initialize(OptimizedModel* model);
 
 	/// <summary>
 	/// 更新処理
@@ -16,9 +18,9 @@ public:
 	void Update();
 
 	/// <summary>
-	/// 描画
+	/// 描画するモデルをスナップショットに積む（視錐台の外なら何もしない）
 	/// </summary>
-	void Draw(KamataEngine::Camera &camera);
+	void AddToSnapshot(RenderSnapshot& snapshot, const Frustum& frustum) const;
 
 	/// <summary>
 	/// デストラクタ
@@ -30,7 +32,9 @@ private:
 	KamataEngine::WorldTransform* worldTransform_;
 
 	// モデル
-	KamataEngine::Model* model_ = nullptr;
+	OptimizedModel* model_ = nullptr;
+	// モデルの境界ボリューム
+	const ModelBounds* bounds_ = nullptr;
 
 	// カメラ
 	KamataEngine::Camera camera_;
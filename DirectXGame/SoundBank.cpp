@@ -0,0 +1,143 @@
+#define NOMINMAX
+#include "SoundBank.h"
+#include "ImaAdpcm.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+uint32_t AlignUp(uint32_t value, uint32_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+} // namespace
+
+bool SoundBank::Write(const std::string& filePath, const std::vector<Source>& sources) {
+
+	// 先に全て符号化して、目次のオフセットを決める
+	std::vector<std::vector<uint8_t>> payloads;
+	payloads.reserve(sources.size());
+	std::vector<Entry> entries(sources.size());
+
+	uint32_t offset = static_cast<uint32_t>(sizeof(FileHeader) + sizeof(Entry) * sources.size());
+	for (size_t i = 0; i < sources.size(); ++i) {
+		const AudioMixer::Sound* sound = sources[i].sound;
+		if (!sound || sound->encoding != AudioMixer::Encoding::kFloat || sound->channels < 1 || sound->channels > 2) {
+			return false;
+		}
+		entries[i].nameOffset = offset;
+		entries[i].nameLength = static_cast<uint32_t>(sources[i].name.size());
+		offset += entries[i].nameLength;
+	}
+
+	for (size_t i = 0; i < sources.size(); ++i) {
+		const AudioMixer::Sound* sound = sources[i].sound;
+		const uint32_t blockAlign = ImaAdpcm::GetDefaultBlockAlign(sound->channels);
+		payloads.push_back(ImaAdpcm::Encode(sound->samples.data(), sound->frameCount, sound->channels, blockAlign));
+
+		Entry& entry = entries[i];
+		entry.sampleRate = sound->sampleRate;
+		entry.channels = static_cast<uint16_t>(sound->channels);
+		entry.blockAlign = static_cast<uint16_t>(blockAlign);
+		entry.frameCount = sound->frameCount;
+		entry.dataOffset = AlignUp(offset, kDataAlignment);
+		entry.dataSize = static_cast<uint32_t>(payloads.back().size());
+		offset = entry.dataOffset + entry.dataSize;
+	}
+
+	std::ofstream file(filePath, std::ios_base::binary | std::ios_base::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	FileHeader header;
+	header.soundCount = static_cast<uint32_t>(sources.size());
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries.data()), sizeof(Entry) * entries.size());
+	for (const Source& source : sources) {
+		file.write(source.name.data(), source.name.size());
+	}
+
+	static const char kPadding[kDataAlignment] = {};
+	for (size_t i = 0; i < payloads.size(); ++i) {
+		const uint32_t position = static_cast<uint32_t>(file.tellp());
+		file.write(kPadding, entries[i].dataOffset - position);
+		file.write(reinterpret_cast<const char*>(payloads[i].data()), payloads[i].size());
+	}
+	return static_cast<bool>(file);
+}
+
+bool SoundBank::Load(const std::string& filePath) {
+
+	Unload();
+
+	std::ifstream file(filePath, std::ios_base::binary | std::ios_base::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	const std::streamoff size = file.tellg();
+	if (size < static_cast<std::streamoff>(sizeof(FileHeader)) || size > UINT32_MAX) {
+		return false;
+	}
+
+	// ファイル全体を1回で読む
+	data_.resize(static_cast<size_t>(size));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(data_.data()), size)) {
+		Unload();
+		return false;
+	}
+
+	FileHeader header;
+	std::memcpy(&header, data_.data(), sizeof(header));
+	if (header.magic != kMagic || header.version != kVersion || header.soundCount > (data_.size() - sizeof(FileHeader)) / sizeof(Entry)) {
+		Unload();
+		return false;
+	}
+
+	sounds_.resize(header.soundCount);
+	names_.resize(header.soundCount);
+	indices_.reserve(header.soundCount);
+
+	const uint64_t fileSize = data_.size();
+	for (uint32_t i = 0; i < header.soundCount; ++i) {
+		Entry entry;
+		std::memcpy(&entry, data_.data() + sizeof(FileHeader) + sizeof(Entry) * i, sizeof(entry));
+
+		// 壊れたファイルで範囲外を読まないように確かめる
+		const bool validFormat = (entry.channels == 1 || entry.channels == 2) && entry.blockAlign > 4u * entry.channels && entry.blockAlign % (4u * entry.channels) == 0;
+		const uint64_t samplesPerBlock = validFormat ? ImaAdpcm::GetSamplesPerBlock(entry.blockAlign, entry.channels) : 1;
+		const uint64_t requiredSize = (entry.frameCount + samplesPerBlock - 1) / samplesPerBlock * entry.blockAlign;
+		if (!validFormat || entry.sampleRate == 0 || uint64_t(entry.nameOffset) + entry.nameLength > fileSize || uint64_t(entry.dataOffset) + entry.dataSize > fileSize ||
+		    entry.dataSize < requiredSize) {
+			Unload();
+			return false;
+		}
+
+		AudioMixer::Sound& sound = sounds_[i];
+		sound.sampleRate = entry.sampleRate;
+		sound.channels = entry.channels;
+		sound.frameCount = entry.frameCount;
+		sound.encoding = AudioMixer::Encoding::kImaAdpcm;
+		sound.blocks = data_.data() + entry.dataOffset;
+		sound.blockAlign = entry.blockAlign;
+
+		names_[i] = std::string_view(reinterpret_cast<const char*>(data_.data()) + entry.nameOffset, entry.nameLength);
+		indices_.emplace(names_[i], i);
+	}
+	return true;
+}
+
+void SoundBank::Unload() {
+
+	indices_.clear();
+	names_.clear();
+	sounds_.clear();
+	data_.clear();
+	data_.shrink_to_fit();
+}
+
+const AudioMixer::Sound* SoundBank::Find(std::string_view name) const {
+
+	auto it = indices_.find(name);
+	return it != indices_.end() ? &sounds_[it->second] : nullptr;
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include "AudioMixer.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// サウンドバンク（効果音をまとめた1つのファイル）
+/// 先頭に目次、続けて名前と IMA-ADPCM のデータを並べ、ファイル全体を1回で読み込む
+/// データは読み込んだバッファのまま AudioMixer::Sound から指し、ミキサーが鳴らす時に必要な分だけ復号する
+/// 16bit PCM の約1/4の大きさで、オフセットは全てファイル先頭からなのでマップしてもそのまま使える
+/// </summary>
+class SoundBank {
+public:
+	// ファイルの識別子と版
+	static constexpr uint32_t kMagic = 'S' | 'B' << 8 | 'N' << 16 | 'K' << 24;
+	static constexpr uint32_t kVersion = 1;
+	// データの並びの揃え
+	static constexpr uint32_t kDataAlignment = 16;
+
+	/// <summary>
+	/// ファイルの先頭
+	/// </summary>
+	struct FileHeader {
+		uint32_t magic = kMagic;
+		uint32_t version = kVersion;
+		uint32_t soundCount = 0;
+		uint32_t reserved = 0;
+	};
+
+	/// <summary>
+	/// 目次の1項目（オフセットはファイル先頭から）
+	/// </summary>
+	struct Entry {
+		uint32_t nameOffset = 0;
+		uint32_t nameLength = 0;
+		uint32_t sampleRate = 0;
+		uint16_t channels = 0;
+		uint16_t blockAlign = 0;
+		uint32_t frameCount = 0;
+		uint32_t dataOffset = 0;
+		uint32_t dataSize = 0;
+	};
+
+	static_assert(sizeof(FileHeader) == 16 && sizeof(Entry) == 28, "SoundBank layout must not have padding");
+
+	/// <summary>
+	/// 書き出す音
+	/// </summary>
+	struct Source {
+		std::string name;
+		// float の音（LoadWave で読んだもの）
+		const AudioMixer::Sound* sound = nullptr;
+	};
+
+	/// <summary>
+	/// 音を IMA-ADPCM に変換してバンクを書き出す
+	/// </summary>
+	/// <param name="filePath">出力先</param>
+	/// <param name="sources">書き出す音（名前は重ならないこと）</param>
+	/// <returns>書き出せたか</returns>
+	static bool Write(const std::string& filePath, const std::vector<Source>& sources);
+
+	SoundBank() = default;
+	~SoundBank() = default;
+	SoundBank(const SoundBank&) = delete;
+	SoundBank& operator=(const SoundBank&) = delete;
+
+	/// <summary>
+	/// 読み込み（ファイル全体を1回で読む）
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>読めて中身が正しかったか</returns>
+	bool Load(const std::string& filePath);
+
+	/// <summary>
+	/// 解放（鳴っているボイスが無いこと）
+	/// </summary>
+	void Unload();
+
+	/// <summary>
+	/// 名前から音を探す
+	/// </summary>
+	/// <param name="name">バンクを作った時の名前</param>
+	/// <returns>見つからなければ nullptr</returns>
+	const AudioMixer::Sound* Find(std::string_view name) const;
+
+	/// <summary>
+	/// 音の数
+	/// </summary>
+	uint32_t GetSoundCount() const { return static_cast<uint32_t>(sounds_.size()); }
+
+	/// <summary>
+	/// 音の名前
+	/// </summary>
+	std::string_view GetName(uint32_t index) const { return names_[index]; }
+
+	/// <summary>
+	/// 音
+	/// </summary>
+	const AudioMixer::Sound* GetSound(uint32_t index) const { return &sounds_[index]; }
+
+	/// <summary>
+	/// 使っているメモリ（読み込んだファイルの大きさ）
+	/// </summary>
+	size_t GetMemorySize() const { return data_.size(); }
+
+private:
+	// 名前 → sounds_ の番号（名前は data_ の中を指す）
+	struct NameHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+	};
+
+	// ファイルの中身（音のデータはここを指す）
+	std::vector<uint8_t> data_;
+	std::vector<AudioMixer::Sound> sounds_;
+	std::vector<std::string_view> names_;
+	std::unordered_map<std::string_view, uint32_t, NameHash, std::equal_to<>> indices_;
+};
@@ -0,0 +1,427 @@
+#define NOMINMAX
+#include "SpriteBatch.h"
+#include "AssetManager.h"
+#include "ShaderCompiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdarg>
+#include <cstdio>
+#include <d3dx12.h>
+
+using namespace KamataEngine;
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+// ブレンドモードごとの設定（Sprite と同じ式）
+D3D12_RENDER_TARGET_BLEND_DESC MakeBlendDesc(SpriteBatch::BlendMode blendMode) {
+
+	D3D12_RENDER_TARGET_BLEND_DESC desc = {};
+	desc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	desc.BlendEnable = true;
+	desc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	desc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	desc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	switch (blendMode) {
+	case SpriteBatch::BlendMode::kNone:
+		desc.BlendEnable = false;
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_ONE;
+		desc.DestBlend = D3D12_BLEND_ZERO;
+		break;
+	case SpriteBatch::BlendMode::kNormal:
+	default:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		desc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		break;
+	case SpriteBatch::BlendMode::kAdd:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		desc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case SpriteBatch::BlendMode::kSubtract:
+		desc.BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;
+		desc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		desc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case SpriteBatch::BlendMode::kMultiply:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_ZERO;
+		desc.DestBlend = D3D12_BLEND_SRC_COLOR;
+		break;
+	case SpriteBatch::BlendMode::kScreen:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		desc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case SpriteBatch::BlendMode::kExclusion:
+		desc.BlendOp = D3D12_BLEND_OP_ADD;
+		desc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		desc.DestBlend = D3D12_BLEND_INV_SRC_COLOR;
+		break;
+	}
+
+	return desc;
+}
+
+// ルートパラメータ番号
+enum class RootParameter {
+	kProjection, // 射影行列（ルート定数）
+	kTexture,    // テクスチャ
+	kCount,
+};
+
+} // namespace
+
+SpriteBatch* SpriteBatch::GetInstance() {
+	static SpriteBatch instance;
+	return &instance;
+}
+
+void SpriteBatch::Initialize(ID3D12Device* device, int windowWidth, int windowHeight) {
+
+	assert(device);
+
+	// スクリーン座標 → クリップ座標（左上原点、Y下向き）
+	matProjection_ = {};
+	matProjection_.m[0][0] = 2.0f / static_cast<float>(windowWidth);
+	matProjection_.m[1][1] = -2.0f / static_cast<float>(windowHeight);
+	matProjection_.m[2][2] = 1.0f;
+	matProjection_.m[3][0] = -1.0f;
+	matProjection_.m[3][1] = 1.0f;
+	matProjection_.m[3][3] = 1.0f;
+
+	CreatePipelines(device);
+	CreateBuffers(device, DirectXCommon::GetInstance()->GetBackBufferCount());
+
+	// 描画待ちの矩形は上限まで先に取っておき、以降は確保しない
+	quads_.reserve(kMaxQuadCount);
+	entries_.reserve(kMaxQuadCount);
+	order_.reserve(kMaxQuadCount);
+
+	// デバッグ文字列のフォント
+	if (const TextureAtlas::Region* region = TextureAtlas::GetInstance()->Find("debugfont.png")) {
+		fontRegion_ = *region;
+	} else {
+		fontTextureHandle_ = AssetManager::GetInstance()->AcquireTexture("debugfont.png");
+		fontRegion_ = TextureAtlas::MakeRegion(fontTextureHandle_);
+	}
+}
+
+void SpriteBatch::Finalize() {
+
+	if (fontTextureHandle_ != TextureAtlas::kInvalidHandle) {
+		AssetManager::GetInstance()->ReleaseTexture(fontTextureHandle_);
+		fontTextureHandle_ = TextureAtlas::kInvalidHandle;
+	}
+
+	for (ComPtr<ID3D12Resource>& vertBuff : vertBuffs_) {
+		vertBuff->Unmap(0, nullptr);
+	}
+	vertBuffs_.clear();
+	vertMaps_.clear();
+	indexBuff_.Reset();
+	for (ComPtr<ID3D12PipelineState>& pipelineState : pipelineStates_) {
+		pipelineState.Reset();
+	}
+	rootSignature_.Reset();
+}
+
+void SpriteBatch::BeginFrame() {
+
+	frameIndex_ = (frameIndex_ + 1) % vertBuffs_.size();
+	writtenQuadCount_ = 0;
+}
+
+void SpriteBatch::PreDraw(ID3D12GraphicsCommandList* commandList) {
+
+	// PreDrawとPostDrawがペアで呼ばれていなければエラー
+	assert(commandList_ == nullptr);
+
+	commandList_ = commandList;
+}
+
+void SpriteBatch::PostDraw() {
+
+	assert(commandList_);
+
+	drawCallCount_ = 0;
+
+	// 今のフレームの残り容量に収まる分だけ描画する
+	size_t count = std::min(quads_.size(), kMaxQuadCount - writtenQuadCount_);
+	assert(count == quads_.size());
+
+	if (count == 0) {
+		ClearQueue();
+		commandList_ = nullptr;
+		return;
+	}
+
+	// 描画順 > ブレンドモード > テクスチャでまとめる（同じキー内は追加順）
+	order_.resize(quads_.size());
+	for (uint32_t i = 0; i < order_.size(); ++i) {
+		order_[i] = i;
+	}
+	std::sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) { return entries_[a].key < entries_[b].key; });
+
+	// 頂点をまとめて書き込む
+	SpriteGeometry::GenerateVertices(quads_.data(), order_.data(), count, vertMaps_[frameIndex_] + writtenQuadCount_ * 4);
+
+	// 共通の設定
+	D3D12_VERTEX_BUFFER_VIEW vbView = {};
+	vbView.BufferLocation = vertBuffs_[frameIndex_]->GetGPUVirtualAddress();
+	vbView.SizeInBytes = static_cast<UINT>(sizeof(Vertex) * 4 * kMaxQuadCount);
+	vbView.StrideInBytes = sizeof(Vertex);
+
+	commandList_->SetGraphicsRootSignature(rootSignature_.Get());
+	commandList_->SetGraphicsRoot32BitConstants(static_cast<UINT>(RootParameter::kProjection), 16, &matProjection_, 0);
+	commandList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList_->IASetVertexBuffers(0, 1, &vbView);
+	commandList_->IASetIndexBuffer(&ibView_);
+
+	// 状態が変わるところで区切って描画
+	size_t runBegin = 0;
+	BlendMode currentBlendMode = BlendMode::kCountOfBlendMode;
+	uint32_t currentTexture = UINT32_MAX;
+
+	for (size_t i = 0; i <= count; ++i) {
+		const bool isEnd = i == count;
+		const Entry* entry = isEnd ? nullptr : &entries_[order_[i]];
+
+		if (!isEnd && entry->blendMode == currentBlendMode && entry->textureHandle == currentTexture) {
+			continue;
+		}
+
+		// ここまでの分を描画
+		if (i > runBegin) {
+			UINT startIndex = static_cast<UINT>((writtenQuadCount_ + runBegin) * 6);
+			commandList_->DrawIndexedInstanced(static_cast<UINT>((i - runBegin) * 6), 1, startIndex, 0, 0);
+			++drawCallCount_;
+		}
+		if (isEnd) {
+			break;
+		}
+
+		// 状態の切り替え
+		if (entry->blendMode != currentBlendMode) {
+			currentBlendMode = entry->blendMode;
+			commandList_->SetPipelineState(pipelineStates_[static_cast<size_t>(currentBlendMode)].Get());
+		}
+		if (entry->textureHandle != currentTexture) {
+			currentTexture = entry->textureHandle;
+			TextureManager::GetInstance()->SetGraphicsRootDescriptorTable(commandList_, static_cast<UINT>(RootParameter::kTexture), currentTexture);
+		}
+		runBegin = i;
+	}
+
+	writtenQuadCount_ += count;
+	ClearQueue();
+	commandList_ = nullptr;
+}
+
+void SpriteBatch::ClearQueue() {
+
+	// 容量は残して次のフレームで使い回す
+	quads_.clear();
+	entries_.clear();
+	order_.clear();
+}
+
+void SpriteBatch::Draw(uint32_t textureHandle, const Quad& quad, BlendMode blendMode, uint8_t layer) {
+
+	assert(commandList_);
+
+	if (quads_.size() >= kMaxQuadCount) {
+		return;
+	}
+
+	Entry entry;
+	entry.key = MakeSortKey(layer, blendMode, textureHandle, static_cast<uint32_t>(quads_.size()));
+	entry.textureHandle = textureHandle;
+	entry.blendMode = blendMode;
+
+	quads_.push_back(quad);
+	entries_.push_back(entry);
+}
+
+void SpriteBatch::Draw(const Sprite& sprite, BlendMode blendMode, uint8_t layer) { Draw(sprite, TextureAtlas::MakeRegion(sprite.GetTextureHandle()), blendMode, layer); }
+
+void SpriteBatch::Draw(const Sprite& sprite, const TextureAtlas::Region& region, BlendMode blendMode, uint8_t layer) {
+
+	Quad quad;
+	quad.position = sprite.GetPosition();
+	quad.size = sprite.GetSize();
+	quad.anchor = sprite.GetAnchorPoint();
+	quad.rotation = sprite.GetRotation();
+	quad.color = PackColor(sprite.GetColor());
+
+	// 反転はuvの入れ替えで表す
+	quad.uvMin = {sprite.GetIsFlipX() ? region.uvMax.x : region.uvMin.x, sprite.GetIsFlipY() ? region.uvMax.y : region.uvMin.y};
+	quad.uvMax = {sprite.GetIsFlipX() ? region.uvMin.x : region.uvMax.x, sprite.GetIsFlipY() ? region.uvMin.y : region.uvMax.y};
+
+	Draw(region.textureHandle, quad, blendMode, layer);
+}
+
+void SpriteBatch::Print(std::string_view text, float x, float y, float scale, uint8_t layer) {
+
+	// フォント画像の画素 → uv（アトラス上ならページ内の位置にずらす）
+	const float texelU = (fontRegion_.uvMax.x - fontRegion_.uvMin.x) / fontRegion_.texSize.x;
+	const float texelV = (fontRegion_.uvMax.y - fontRegion_.uvMin.y) / fontRegion_.texSize.y;
+
+	Quad quad;
+	quad.size = {DebugText::kFontWidth * scale, DebugText::kFontHeight * scale};
+	quad.anchor = {0.0f, 0.0f};
+
+	for (size_t i = 0; i < text.size(); ++i) {
+		// フォント画像は' 'から始まるASCII順に並んでいる（範囲外は空白）
+		const unsigned char character = static_cast<unsigned char>(text[i]);
+		const int fontIndex = (character < 0x20 || character >= 0x7f) ? 0 : character - 0x20;
+		const int fontIndexX = fontIndex % DebugText::kFontLineCount;
+		const int fontIndexY = fontIndex / DebugText::kFontLineCount;
+
+		quad.position = {x + quad.size.x * static_cast<float>(i), y};
+		quad.uvMin = {
+		    fontRegion_.uvMin.x + static_cast<float>(fontIndexX * DebugText::kFontWidth) * texelU, fontRegion_.uvMin.y + static_cast<float>(fontIndexY * DebugText::kFontHeight) * texelV};
+		quad.uvMax = {
+		    fontRegion_.uvMin.x + static_cast<float>((fontIndexX + 1) * DebugText::kFontWidth) * texelU,
+		    fontRegion_.uvMin.y + static_cast<float>((fontIndexY + 1) * DebugText::kFontHeight) * texelV};
+
+		Draw(fontRegion_.textureHandle, quad, BlendMode::kNormal, layer);
+	}
+}
+
+void SpriteBatch::Printf(float x, float y, const char* fmt, ...) {
+
+	char buffer[DebugText::kBufferSize];
+
+	va_list args;
+	va_start(args, fmt);
+	int length = vsnprintf(buffer, sizeof(buffer), fmt, args);
+	va_end(args);
+
+	if (length > 0) {
+		Print(std::string_view(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1)), x, y);
+	}
+}
+
+uint32_t SpriteBatch::PackColor(const Vector4& color) {
+
+	auto toByte = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+	return toByte(color.x) | (toByte(color.y) << 8) | (toByte(color.z) << 16) | (toByte(color.w) << 24);
+}
+
+uint64_t SpriteBatch::MakeSortKey(uint8_t layer, BlendMode blendMode, uint32_t textureHandle, uint32_t sequence) {
+
+	// 描画順8bit・ブレンドモード4bit・テクスチャ20bit・追加順32bit
+	return (static_cast<uint64_t>(layer) << 56) | (static_cast<uint64_t>(blendMode) << 52) | (static_cast<uint64_t>(textureHandle & 0xFFFFF) << 32) | sequence;
+}
+
+void SpriteBatch::CreatePipelines(ID3D12Device* device) {
+
+	[[maybe_unused]] HRESULT result = S_FALSE;
+
+	ComPtr<ID3DBlob> vsBlob = ShaderCompiler::Compile(L"Resources/shaders/SpriteBatchVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = ShaderCompiler::Compile(L"Resources/shaders/SpriteBatchPS.hlsl", "ps_5_0");
+
+	// ルートシグネチャ（射影行列はルート定数で渡す）
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0 レジスタ
+
+	CD3DX12_ROOT_PARAMETER rootParams[static_cast<size_t>(RootParameter::kCount)] = {};
+	rootParams[static_cast<size_t>(RootParameter::kProjection)].InitAsConstants(16, 0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	rootParams[static_cast<size_t>(RootParameter::kTexture)].InitAsDescriptorTable(1, &descRangeSRV, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc = CD3DX12_STATIC_SAMPLER_DESC(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR);
+	samplerDesc.AddressU = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+	samplerDesc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+	samplerDesc.AddressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(_countof(rootParams), rootParams, 1, &samplerDesc, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	result = D3DX12SerializeVersionedRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+
+	result = device->CreateRootSignature(0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	// 頂点レイアウト
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT,   0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,   0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"COLOR",    0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// グラフィックスパイプライン
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline = {};
+	gpipeline.pRootSignature = rootSignature_.Get();
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	gpipeline.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	// 2Dは常に手前に描く
+	gpipeline.DepthStencilState.DepthEnable = false;
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	gpipeline.NumRenderTargets = 1;
+	gpipeline.RTVFormats[0] = kRenderTargetFormat;
+	gpipeline.SampleDesc.Count = 1;
+
+	for (size_t i = 0; i < pipelineStates_.size(); ++i) {
+		gpipeline.BlendState.RenderTarget[0] = MakeBlendDesc(static_cast<BlendMode>(i));
+		result = device->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&pipelineStates_[i]));
+		assert(SUCCEEDED(result));
+	}
+}
+
+void SpriteBatch::CreateBuffers(ID3D12Device* device, size_t frameCount) {
+
+	[[maybe_unused]] HRESULT result = S_FALSE;
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+
+	// 頂点バッファ（フレームごと、書き込み続けるので Map したままにする）
+	CD3DX12_RESOURCE_DESC vertexDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(Vertex) * 4 * kMaxQuadCount);
+	vertBuffs_.resize(frameCount);
+	vertMaps_.resize(frameCount);
+	for (size_t i = 0; i < frameCount; ++i) {
+		result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &vertexDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&vertBuffs_[i]));
+		assert(SUCCEEDED(result));
+		result = vertBuffs_[i]->Map(0, nullptr, reinterpret_cast<void**>(&vertMaps_[i]));
+		assert(SUCCEEDED(result));
+	}
+
+	// インデックスバッファ（矩形ごとに 0,1,2 / 1,3,2 の固定パターン）
+	std::vector<uint16_t> indices(kMaxQuadCount * 6);
+	for (size_t i = 0; i < kMaxQuadCount; ++i) {
+		const uint16_t base = static_cast<uint16_t>(i * 4);
+		uint16_t* quadIndices = &indices[i * 6];
+		quadIndices[0] = base + 0;
+		quadIndices[1] = base + 1;
+		quadIndices[2] = base + 2;
+		quadIndices[3] = base + 1;
+		quadIndices[4] = base + 3;
+		quadIndices[5] = base + 2;
+	}
+
+	const size_t indexBytes = sizeof(uint16_t) * indices.size();
+	CD3DX12_RESOURCE_DESC indexDesc = CD3DX12_RESOURCE_DESC::Buffer(indexBytes);
+	result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &indexDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&indexBuff_));
+	assert(SUCCEEDED(result));
+
+	uint16_t* indexMap = nullptr;
+	result = indexBuff_->Map(0, nullptr, reinterpret_cast<void**>(&indexMap));
+	assert(SUCCEEDED(result));
+	std::copy(indices.begin(), indices.end(), indexMap);
+	indexBuff_->Unmap(0, nullptr);
+
+	ibView_.BufferLocation = indexBuff_->GetGPUVirtualAddress();
+	ibView_.Format = DXGI_FORMAT_R16_UINT;
+	ibView_.SizeInBytes = static_cast<UINT>(indexBytes);
+}
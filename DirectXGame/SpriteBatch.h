@@ -0,0 +1,178 @@
+#pragma once
+#include "KamataEngine.h"
+#include "SpriteGeometry.h"
+#include "TextureAtlas.h"
+#include <array>
+#include <cstdint>
+#include <d3d12.h>
+#include <string_view>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// スプライトのまとめ描画
+/// 1フレーム分の矩形を1つの動的頂点バッファに詰め、テクスチャとブレンドモードが変わる時だけ描画命令を出す
+/// （Sprite は1枚ごとに頂点/定数バッファを持ち、1枚1ドローになるため）
+/// </summary>
+class SpriteBatch {
+public:
+	using BlendMode = KamataEngine::Sprite::BlendMode;
+
+	// 1フレームに描画できる矩形の最大数（16bitインデックスに収まる数）
+	static constexpr size_t kMaxQuadCount = 8192;
+
+	// 描画先のフォーマット（エンジンのスプライト/モデルと同じ）
+	static constexpr DXGI_FORMAT kRenderTargetFormat = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+	using Vertex = SpriteGeometry::Vertex;
+	using Quad = SpriteGeometry::Quad;
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	static SpriteBatch* GetInstance();
+
+	/// <summary>
+	/// 初期化（エンジンの初期化後に呼ぶ）
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="windowWidth">画面幅</param>
+	/// <param name="windowHeight">画面高さ</param>
+	void Initialize(ID3D12Device* device, int windowWidth, int windowHeight);
+
+	/// <summary>
+	/// 終了処理（AssetManager::Finalize より前に呼ぶ）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// フレームの開始（頂点バッファの書き込み位置を戻す）
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 描画前処理
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト</param>
+	void PreDraw(ID3D12GraphicsCommandList* commandList);
+
+	/// <summary>
+	/// 描画後処理（溜めた矩形をまとめて描画する）
+	/// </summary>
+	void PostDraw();
+
+	/// <summary>
+	/// 矩形の追加
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	/// <param name="quad">描画情報</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="layer">描画順（小さいほど先に描画、同じなら追加順）</param>
+	void Draw(uint32_t textureHandle, const Quad& quad, BlendMode blendMode = BlendMode::kNormal, uint8_t layer = 0);
+
+	/// <summary>
+	/// スプライトの設定で矩形を追加（テクスチャ全体を貼る）
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="layer">描画順</param>
+	void Draw(const KamataEngine::Sprite& sprite, BlendMode blendMode = BlendMode::kNormal, uint8_t layer = 0);
+
+	/// <summary>
+	/// スプライトの設定で矩形を追加（アトラス上の範囲を貼る）
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="region">アトラス上の範囲</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="layer">描画順</param>
+	void Draw(const KamataEngine::Sprite& sprite, const TextureAtlas::Region& region, BlendMode blendMode = BlendMode::kNormal, uint8_t layer = 0);
+
+	/// <summary>
+	/// デバッグ文字列の追加（DebugText と同じフォント画像・配置）
+	/// </summary>
+	/// <param name="text">文字列</param>
+	/// <param name="x">左上X</param>
+	/// <param name="y">左上Y</param>
+	/// <param name="scale">倍率</param>
+	/// <param name="layer">描画順</param>
+	void Print(std::string_view text, float x, float y, float scale = 1.0f, uint8_t layer = UINT8_MAX);
+
+	/// <summary>
+	/// 書式付きデバッグ文字列の追加
+	/// </summary>
+	void Printf(float x, float y, const char* fmt, ...);
+
+	/// <summary>
+	/// 前回のPostDrawで発行した描画命令の数
+	/// </summary>
+	size_t GetDrawCallCount() const { return drawCallCount_; }
+
+	/// <summary>
+	/// 色をRGBA8に詰める
+	/// </summary>
+	static uint32_t PackColor(const KamataEngine::Vector4& color);
+
+private:
+	SpriteBatch() = default;
+	~SpriteBatch() = default;
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	// ソートキー（描画順 > ブレンドモード > テクスチャ > 追加順）
+	static uint64_t MakeSortKey(uint8_t layer, BlendMode blendMode, uint32_t textureHandle, uint32_t sequence);
+
+	/// <summary>
+	/// パイプラインの生成
+	/// </summary>
+	void CreatePipelines(ID3D12Device* device);
+
+	/// <summary>
+	/// 頂点/インデックスバッファの生成
+	/// </summary>
+	void CreateBuffers(ID3D12Device* device, size_t frameCount);
+
+	// 描画待ちの矩形
+	struct Entry {
+		uint64_t key;
+		uint32_t textureHandle;
+		BlendMode blendMode;
+	};
+
+	// ルートシグネチャ
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	// ブレンドモードごとのパイプライン
+	std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, static_cast<size_t>(BlendMode::kCountOfBlendMode)> pipelineStates_;
+	// フレームごとの頂点バッファ（GPUが読んでいる間に上書きしないようバックバッファ数だけ持つ）
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> vertBuffs_;
+	std::vector<Vertex*> vertMaps_;
+	// インデックスバッファ（全フレーム共通）
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff_;
+	D3D12_INDEX_BUFFER_VIEW ibView_ = {};
+	// 射影行列
+	KamataEngine::Matrix4x4 matProjection_ = {};
+
+	// コマンドリスト
+	ID3D12GraphicsCommandList* commandList_ = nullptr;
+	// 今のフレームの頂点バッファ番号
+	size_t frameIndex_ = 0;
+	// 今のフレームで書き込み済みの矩形数
+	size_t writtenQuadCount_ = 0;
+
+	/// <summary>
+	/// 描画待ちの矩形を空にする
+	/// </summary>
+	void ClearQueue();
+
+	// 描画待ちの矩形（FrameArena はフレームの区切りで巻き戻されるので、フレームをまたいで持つここでは使わない）
+	std::vector<Quad> quads_;
+	std::vector<Entry> entries_;
+	// ソート用
+	std::vector<uint32_t> order_;
+
+	// デバッグ文字列のフォント（アトラスに無い時だけ自前で読み込む）
+	TextureAtlas::Region fontRegion_;
+	uint32_t fontTextureHandle_ = TextureAtlas::kInvalidHandle;
+
+	// 前回の描画命令数
+	size_t drawCallCount_ = 0;
+};
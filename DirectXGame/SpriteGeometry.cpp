@@ -0,0 +1,48 @@
+#include "SpriteGeometry.h"
+#include <cmath>
+#include <emmintrin.h>
+
+namespace SpriteGeometry {
+
+void GenerateVertices(const Quad* quads, const uint32_t* order, size_t count, Vertex* vertices) {
+
+	// 4頂点（左上・右上・左下・右下）を4レーンで同時に計算する
+	const __m128 cornerX = _mm_setr_ps(0.0f, 1.0f, 0.0f, 1.0f);
+	const __m128 cornerY = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+
+	alignas(16) float positionX[4];
+	alignas(16) float positionY[4];
+	alignas(16) float texcoordU[4];
+	alignas(16) float texcoordV[4];
+
+	for (size_t i = 0; i < count; ++i) {
+		const Quad& quad = quads[order[i]];
+
+		// アンカーポイント基準のローカル座標
+		const __m128 localX = _mm_mul_ps(_mm_sub_ps(cornerX, _mm_set1_ps(quad.anchor.x)), _mm_set1_ps(quad.size.x));
+		const __m128 localY = _mm_mul_ps(_mm_sub_ps(cornerY, _mm_set1_ps(quad.anchor.y)), _mm_set1_ps(quad.size.y));
+
+		// 回転して平行移動
+		const __m128 cosine = _mm_set1_ps(std::cos(quad.rotation));
+		const __m128 sine = _mm_set1_ps(std::sin(quad.rotation));
+		const __m128 x = _mm_add_ps(_mm_set1_ps(quad.position.x), _mm_sub_ps(_mm_mul_ps(localX, cosine), _mm_mul_ps(localY, sine)));
+		const __m128 y = _mm_add_ps(_mm_set1_ps(quad.position.y), _mm_add_ps(_mm_mul_ps(localX, sine), _mm_mul_ps(localY, cosine)));
+		_mm_store_ps(positionX, x);
+		_mm_store_ps(positionY, y);
+
+		// uvは角ごとに min/max を選ぶ
+		const __m128 u = _mm_add_ps(_mm_set1_ps(quad.uvMin.x), _mm_mul_ps(cornerX, _mm_set1_ps(quad.uvMax.x - quad.uvMin.x)));
+		const __m128 v = _mm_add_ps(_mm_set1_ps(quad.uvMin.y), _mm_mul_ps(cornerY, _mm_set1_ps(quad.uvMax.y - quad.uvMin.y)));
+		_mm_store_ps(texcoordU, u);
+		_mm_store_ps(texcoordV, v);
+
+		Vertex* out = vertices + i * 4;
+		for (size_t corner = 0; corner < 4; ++corner) {
+			out[corner].pos = {positionX[corner], positionY[corner]};
+			out[corner].uv = {texcoordU[corner], texcoordV[corner]};
+			out[corner].color = quad.color;
+		}
+	}
+}
+
+} // namespace SpriteGeometry
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <math/Vector2.h>
+
+/// <summary>
+/// スプライトの矩形から頂点を作る（SpriteBatch の頂点生成部分）
+/// D3D12 やエンジンの描画機能に依存しないので、ベンチマークからも検証できる
+/// </summary>
+namespace SpriteGeometry {
+
+/// <summary>
+/// 頂点データ
+/// </summary>
+struct Vertex {
+	KamataEngine::Vector2 pos; // スクリーン座標
+	KamataEngine::Vector2 uv;  // uv座標
+	uint32_t color;            // 色（RGBA8）
+};
+
+/// <summary>
+/// 矩形1枚分の描画情報
+/// </summary>
+struct Quad {
+	KamataEngine::Vector2 position; // アンカーポイントの座標
+	KamataEngine::Vector2 size;     // 幅、高さ
+	KamataEngine::Vector2 anchor;   // アンカーポイント（0〜1）
+	KamataEngine::Vector2 uvMin;    // 左上のuv
+	KamataEngine::Vector2 uvMax;    // 右下のuv
+	float rotation = 0.0f;          // Z軸回りの回転角
+	uint32_t color = 0xFFFFFFFF;    // 色（RGBA8）
+};
+
+/// <summary>
+/// 矩形から頂点を生成する（1矩形4頂点、左上・右上・左下・右下の順）
+/// </summary>
+/// <param name="quads">矩形配列</param>
+/// <param name="order">生成する順番（quads の添え字）</param>
+/// <param name="count">生成する数</param>
+/// <param name="vertices">出力先（count * 4 頂点）</param>
+void GenerateVertices(const Quad* quads, const uint32_t* order, size_t count, Vertex* vertices);
+
+} // namespace SpriteGeometry
@@ -0,0 +1,372 @@
+#define NOMINMAX
+#include "StreamingAudio.h"
+#include "MemoryTracker.h"
+#include "WaveFile.h"
+#include <algorithm>
+#include <cassert>
+
+#pragma comment(lib, "xaudio2.lib")
+
+StreamingAudio* StreamingAudio::GetInstance() {
+	static StreamingAudio instance;
+	return &instance;
+}
+
+void StreamingAudio::Initialize(const std::string& directoryPath) {
+
+	directoryPath_ = directoryPath;
+
+	[[maybe_unused]] HRESULT result = XAudio2Create(&xAudio2_, 0, XAUDIO2_DEFAULT_PROCESSOR);
+	assert(SUCCEEDED(result));
+
+	result = xAudio2_->CreateMasteringVoice(&masteringVoice_);
+	assert(SUCCEEDED(result));
+
+	quit_ = false;
+	worker_ = std::thread(&StreamingAudio::Run, this);
+
+	// 効果音はミキサーでまとめて1本のボイスで鳴らす
+	mixer_ = new AudioMixer(kMixerSampleRate);
+	Stream* stream = new Stream();
+	stream->fileName = "(mixer)";
+	stream->mixer = mixer_;
+	mixerHandle_ = Register(stream);
+}
+
+void StreamingAudio::Finalize() {
+
+	if (worker_.joinable()) {
+		{
+			std::scoped_lock lock(mutex_);
+			quit_ = true;
+		}
+		condition_.notify_one();
+		worker_.join();
+	}
+
+	for (auto& [handle, stream] : streams_) {
+		Close(stream);
+		delete stream;
+	}
+	streams_.clear();
+
+	delete mixer_;
+	mixer_ = nullptr;
+	mixerHandle_ = kInvalidHandle;
+	soundBank_.Unload();
+
+	if (masteringVoice_) {
+		masteringVoice_->DestroyVoice();
+		masteringVoice_ = nullptr;
+	}
+	xAudio2_.Reset();
+}
+
+bool StreamingAudio::LoadSoundBank(const std::string& fileName) {
+
+	// 鳴っているボイスが古いバンクを指さないよう、読み込むのは鳴らし始める前の1回だけ
+	assert(soundBank_.GetSoundCount() == 0);
+	MemoryTagScope memoryTag(MemoryTag::kAudio);
+	return soundBank_.Load(directoryPath_ + fileName);
+}
+
+uint32_t StreamingAudio::PlaySoundEffect(std::string_view name, float volume, float pitch, bool loopFlag) {
+
+	const AudioMixer::Sound* sound = soundBank_.Find(name);
+	if (!sound || !mixer_) {
+		return AudioMixer::kInvalidVoice;
+	}
+	uint32_t voice = mixer_->Play(sound, volume, pitch, loopFlag);
+	// 鳴らすものが無くて止まっているミキサーのストリームを起こす
+	Notify();
+	return voice;
+}
+
+uint32_t StreamingAudio::Play(const std::string& fileName, bool loopFlag, float volume) {
+
+	Stream* stream = new Stream();
+	stream->fileName = directoryPath_ + fileName;
+	stream->loopFlag = loopFlag;
+	stream->volume = volume;
+	return Register(stream);
+}
+
+uint32_t StreamingAudio::Register(Stream* stream) {
+
+	stream->callback.owner = this;
+	stream->callback.stream = stream;
+
+	uint32_t handle = kInvalidHandle;
+	{
+		std::scoped_lock lock(mutex_);
+		handle = nextHandle_++;
+		streams_[handle] = stream;
+		hasWork_ = true;
+	}
+	condition_.notify_one();
+	return handle;
+}
+
+void StreamingAudio::Stop(uint32_t handle) {
+
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = streams_.find(handle);
+		if (it == streams_.end()) {
+			return;
+		}
+		it->second->stopRequested = true;
+		hasWork_ = true;
+	}
+	condition_.notify_one();
+}
+
+bool StreamingAudio::IsPlaying(uint32_t handle) {
+
+	std::scoped_lock lock(mutex_);
+	auto it = streams_.find(handle);
+	return it != streams_.end() && !it->second->stopRequested && it->second->state != State::kFinished;
+}
+
+void StreamingAudio::SetVolume(uint32_t handle, float volume) {
+
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = streams_.find(handle);
+		if (it == streams_.end()) {
+			return;
+		}
+		it->second->volume = volume;
+		it->second->volumeChanged = true;
+		hasWork_ = true;
+	}
+	condition_.notify_one();
+}
+
+void StreamingAudio::VoiceCallback::OnStreamEnd() {
+	stream->streamEnded = true;
+	owner->Notify();
+}
+
+void StreamingAudio::VoiceCallback::OnBufferEnd([[maybe_unused]] void* pBufferContext) {
+	stream->freeBufferCount.fetch_add(1, std::memory_order_release);
+	owner->Notify();
+}
+
+void StreamingAudio::Notify() {
+	{
+		std::scoped_lock lock(mutex_);
+		hasWork_ = true;
+	}
+	condition_.notify_one();
+}
+
+void StreamingAudio::Run() {
+
+	std::vector<std::pair<uint32_t, Stream*>> streams;
+	std::vector<uint32_t> finishedHandles;
+
+	while (true) {
+		// 処理対象を写してからロックを外す（ディスクを読んでいる間も Play や Stop を止めない）
+		// ストリームを消すのはこのスレッドだけなので、写したポインタはこの周回の間有効
+		{
+			std::unique_lock lock(mutex_);
+			condition_.wait(lock, [this] { return hasWork_ || quit_; });
+			if (quit_) {
+				break;
+			}
+			hasWork_ = false;
+
+			streams.assign(streams_.begin(), streams_.end());
+		}
+
+		finishedHandles.clear();
+		for (auto& [handle, stream] : streams) {
+
+			if (stream->stopRequested) {
+				stream->state = State::kFinished;
+			}
+
+			switch (stream->state) {
+			case State::kOpening:
+				if (!Open(stream)) {
+					stream->state = State::kFinished;
+				}
+				break;
+
+			case State::kPlaying:
+				// 空いた分だけ読み込んで積む
+				// ミキサーは鳴らすものが無ければ積まない（積んだ分を鳴らし切ったら止まり、PlaySoundEffect で起こされる）
+				while (stream->state == State::kPlaying && stream->freeBufferCount.load(std::memory_order_acquire) > 0 && !(stream->mixer && stream->mixer->IsIdle())) {
+					stream->freeBufferCount.fetch_sub(1, std::memory_order_relaxed);
+					SubmitNextBuffer(stream);
+				}
+				break;
+
+			case State::kDraining:
+				if (stream->streamEnded) {
+					stream->state = State::kFinished;
+				}
+				break;
+
+			default:
+				break;
+			}
+
+			if (stream->state != State::kFinished && stream->volumeChanged.exchange(false) && stream->sourceVoice) {
+				stream->sourceVoice->SetVolume(stream->volume);
+			}
+
+			if (stream->state == State::kFinished) {
+				Close(stream);
+				finishedHandles.push_back(handle);
+			}
+		}
+
+		// 終わったものを片付ける（ボイスは Close 済みなのでコールバックはもう来ない）
+		if (!finishedHandles.empty()) {
+			std::vector<Stream*> finishedStreams;
+			{
+				std::scoped_lock lock(mutex_);
+				for (uint32_t handle : finishedHandles) {
+					auto it = streams_.find(handle);
+					finishedStreams.push_back(it->second);
+					streams_.erase(it);
+				}
+			}
+			for (Stream* stream : finishedStreams) {
+				delete stream;
+			}
+		}
+	}
+}
+
+bool StreamingAudio::Open(Stream* stream) {
+
+	if (stream->mixer) {
+		// ミキサーの出力は float ステレオ
+		WAVEFORMATEX format{};
+		format.wFormatTag = WaveFile::kFormatFloat;
+		format.nChannels = AudioMixer::kOutputChannels;
+		format.nSamplesPerSec = stream->mixer->GetSampleRate();
+		format.wBitsPerSample = sizeof(float) * 8;
+		format.nBlockAlign = AudioMixer::kOutputChannels * sizeof(float);
+		format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+		stream->format.assign(reinterpret_cast<const uint8_t*>(&format), reinterpret_cast<const uint8_t*>(&format) + sizeof(format));
+		stream->chunkSize = kMixerBlockFrames * format.nBlockAlign;
+	} else {
+		stream->file.open(stream->fileName, std::ios_base::binary);
+		if (!stream->file.is_open()) {
+			return false;
+		}
+
+		WaveFile::Header header;
+		if (!WaveFile::ReadHeader(stream->file, header)) {
+			return false;
+		}
+		stream->format = std::move(header.format);
+		stream->dataOffset = header.dataOffset;
+		stream->dataSize = header.dataSize;
+
+		const WAVEFORMATEX* format = reinterpret_cast<const WAVEFORMATEX*>(stream->format.data());
+		stream->chunkSize = kBufferSize / format->nBlockAlign * format->nBlockAlign;
+	}
+
+	const WAVEFORMATEX* format = reinterpret_cast<const WAVEFORMATEX*>(stream->format.data());
+	HRESULT result = xAudio2_->CreateSourceVoice(&stream->sourceVoice, format, 0, XAUDIO2_DEFAULT_FREQ_RATIO, &stream->callback);
+	if (FAILED(result)) {
+		stream->sourceVoice = nullptr;
+		return false;
+	}
+	stream->sourceVoice->SetVolume(stream->volume);
+	stream->volumeChanged = false;
+
+	for (std::vector<uint8_t>& buffer : stream->buffers) {
+		buffer.resize(stream->chunkSize);
+	}
+
+	// 全バッファを積んでから鳴らす
+	stream->state = State::kPlaying;
+	for (uint32_t i = 0; i < kBufferCount && stream->state == State::kPlaying; ++i) {
+		SubmitNextBuffer(stream);
+	}
+	stream->sourceVoice->Start();
+	return true;
+}
+
+void StreamingAudio::SubmitNextBuffer(Stream* stream) {
+
+	std::vector<uint8_t>& buffer = stream->buffers[stream->nextBuffer];
+	stream->nextBuffer = (stream->nextBuffer + 1) % kBufferCount;
+
+	XAUDIO2_BUFFER xAudio2Buffer{};
+	xAudio2Buffer.pAudioData = buffer.data();
+
+	// ミキサーは終わりが無いので、次のブロックをミックスして積むだけ
+	if (stream->mixer) {
+		stream->mixer->Mix(reinterpret_cast<float*>(buffer.data()), kMixerBlockFrames);
+		xAudio2Buffer.AudioBytes = stream->chunkSize;
+		[[maybe_unused]] HRESULT result = stream->sourceVoice->SubmitSourceBuffer(&xAudio2Buffer);
+		assert(SUCCEEDED(result));
+		return;
+	}
+
+	// ループなら末尾で先頭に戻り、バッファを最後まで埋める
+	uint32_t filled = 0;
+	while (filled < stream->chunkSize && stream->dataSize > 0) {
+		if (stream->readPosition >= stream->dataSize) {
+			if (!stream->loopFlag) {
+				break;
+			}
+			stream->readPosition = 0;
+		}
+		stream->file.clear();
+		stream->file.seekg(stream->dataOffset + stream->readPosition);
+
+		uint32_t size = std::min(stream->chunkSize - filled, stream->dataSize - stream->readPosition);
+		stream->file.read(reinterpret_cast<char*>(buffer.data() + filled), size);
+		uint32_t readSize = static_cast<uint32_t>(stream->file.gcount());
+		filled += readSize;
+		stream->readPosition += readSize;
+
+		// data チャンクの大きさよりファイルが短い時はそこを末尾とする
+		if (readSize < size) {
+			stream->dataSize = stream->readPosition;
+		}
+	}
+
+	const bool endOfStream = !stream->loopFlag && stream->readPosition >= stream->dataSize;
+
+	if (filled == 0) {
+		if (!endOfStream) {
+			// ループ再生で読める中身が無い
+			stream->state = State::kFinished;
+			return;
+		}
+		// ファイルが data チャンクより短く、前のバッファで読み終えていた時は、終端の印を付けるために無音を1ブロック積む
+		const WAVEFORMATEX* format = reinterpret_cast<const WAVEFORMATEX*>(stream->format.data());
+		filled = format->nBlockAlign;
+		std::fill_n(buffer.begin(), filled, uint8_t(format->wBitsPerSample == 8 ? 0x80 : 0x00));
+	}
+
+	xAudio2Buffer.AudioBytes = filled;
+	xAudio2Buffer.Flags = endOfStream ? XAUDIO2_END_OF_STREAM : 0;
+
+	[[maybe_unused]] HRESULT result = stream->sourceVoice->SubmitSourceBuffer(&xAudio2Buffer);
+	assert(SUCCEEDED(result));
+
+	if (endOfStream) {
+		stream->state = State::kDraining;
+	}
+}
+
+void StreamingAudio::Close(Stream* stream) {
+
+	if (stream->sourceVoice) {
+		// DestroyVoice は処理中のコールバックが終わるまで待つので、この後はストリームを消してよい
+		stream->sourceVoice->Stop();
+		stream->sourceVoice->DestroyVoice();
+		stream->sourceVoice = nullptr;
+	}
+	stream->file.close();
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include "AudioMixer.h"
+#include "SoundBank.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
+#include <xaudio2.h>
+
+/// <summary>
+/// BGM用のストリーミング再生
+/// WAVを全て読み込まず、小さいバッファのリングに少しずつ読み込んで再生する
+/// ファイルを開く・読む・バッファを積むのはワーカースレッドで行い、再生終わりのバッファは OnBufferEnd で戻ってくる
+/// 効果音はソフトウェアミキサーでまとめ、ミックス済みの1本を同じ仕組みで流す
+/// 効果音のデータはサウンドバンクから IMA-ADPCM のまま鳴らす
+/// KamataEngine::Audio は XAudio2 を外に出していないので、ゲーム側で別に XAudio2 を持つ
+/// </summary>
+class StreamingAudio {
+public:
+	// リングのバッファ数
+	static constexpr uint32_t kBufferCount = 3;
+	// 1バッファの大きさ（44.1kHz 16bit ステレオで約0.37秒）
+	static constexpr uint32_t kBufferSize = 64 * 1024;
+	// 無効なハンドル
+	static constexpr uint32_t kInvalidHandle = 0;
+	// ミキサーの出力レート
+	static constexpr uint32_t kMixerSampleRate = 48000;
+	// ミキサーの1バッファのフレーム数（3バッファで約32msの遅れ）
+	static constexpr uint32_t kMixerBlockFrames = 512;
+
+	static StreamingAudio* GetInstance();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="directoryPath">サウンド格納ディレクトリ</param>
+	void Initialize(const std::string& directoryPath = "Resources/");
+
+	/// <summary>
+	/// 終了処理（再生中のものは全て止める）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 再生
+	/// ファイルを開くのはワーカースレッドなので、ここではディスクを待たない
+	/// </summary>
+	/// <param name="fileName">WAVファイル名</param>
+	/// <param name="loopFlag">ループ再生フラグ</param>
+	/// <param name="volume">ボリューム</param>
+	/// <returns>再生ハンドル</returns>
+	uint32_t Play(const std::string& fileName, bool loopFlag = false, float volume = 1.0f);
+
+	/// <summary>
+	/// 停止
+	/// </summary>
+	/// <param name="handle">再生ハンドル</param>
+	void Stop(uint32_t handle);
+
+	/// <summary>
+	/// 再生中か（開いている途中も再生中とみなす）
+	/// </summary>
+	/// <param name="handle">再生ハンドル</param>
+	bool IsPlaying(uint32_t handle);
+
+	/// <summary>
+	/// 音量設定
+	/// </summary>
+	/// <param name="handle">再生ハンドル</param>
+	/// <param name="volume">ボリューム</param>
+	void SetVolume(uint32_t handle, float volume);
+
+	/// <summary>
+	/// 効果音のサウンドバンクを読み込む（効果音を鳴らし始める前に1回だけ呼ぶ）
+	/// </summary>
+	/// <param name="fileName">バンクのファイル名</param>
+	/// <returns>読み込めたか</returns>
+	bool LoadSoundBank(const std::string& fileName);
+
+	/// <summary>
+	/// サウンドバンクの効果音を鳴らす
+	/// </summary>
+	/// <param name="name">バンクの中の名前（例: "fanfare.wav"）</param>
+	/// <param name="volume">ボリューム</param>
+	/// <param name="pitch">ピッチ</param>
+	/// <param name="loopFlag">ループ再生フラグ</param>
+	/// <returns>ミキサーのボイス（見つからなければ AudioMixer::kInvalidVoice）</returns>
+	uint32_t PlaySoundEffect(std::string_view name, float volume = 1.0f, float pitch = 1.0f, bool loopFlag = false);
+
+	/// <summary>
+	/// 効果音のミキサー（停止や音量の操作用。鳴らすのは止まっているストリームを起こす PlaySoundEffect で）
+	/// </summary>
+	AudioMixer* GetMixer() { return mixer_; }
+
+	/// <summary>
+	/// 効果音のサウンドバンク
+	/// </summary>
+	const SoundBank& GetSoundBank() const { return soundBank_; }
+
+private:
+	StreamingAudio() = default;
+	~StreamingAudio() = default;
+	StreamingAudio(const StreamingAudio&) = delete;
+	const StreamingAudio& operator=(const StreamingAudio&) = delete;
+
+	struct Stream;
+
+	/// <summary>
+	/// ストリームごとのコールバック（XAudio2のスレッドから呼ばれるので、数を数えてワーカーを起こすだけ）
+	/// </summary>
+	class VoiceCallback : public IXAudio2VoiceCallback {
+	public:
+		StreamingAudio* owner = nullptr;
+		Stream* stream = nullptr;
+
+		// ボイス処理パスの開始時
+		STDMETHOD_(void, OnVoiceProcessingPassStart)([[maybe_unused]] THIS_ UINT32 BytesRequired) {}
+		// ボイス処理パスの終了時
+		STDMETHOD_(void, OnVoiceProcessingPassEnd)(THIS) {}
+		// バッファストリームの再生が終了した時
+		STDMETHOD_(void, OnStreamEnd)(THIS);
+		// バッファの使用開始時
+		STDMETHOD_(void, OnBufferStart)([[maybe_unused]] THIS_ void* pBufferContext) {}
+		// バッファの末尾に達した時
+		STDMETHOD_(void, OnBufferEnd)(THIS_ void* pBufferContext);
+		// 再生がループ位置に達した時
+		STDMETHOD_(void, OnLoopEnd)([[maybe_unused]] THIS_ void* pBufferContext) {}
+		// ボイスの実行エラー時
+		STDMETHOD_(void, OnVoiceError)([[maybe_unused]] THIS_ void* pBufferContext, [[maybe_unused]] HRESULT Error) {}
+	};
+
+	// ストリームの状態
+	enum class State {
+		kOpening,  // ワーカーが開くのを待っている
+		kPlaying,  // 再生中（空いたバッファに読み込んで積む）
+		kDraining, // 最後のバッファを積んだので鳴り終わるのを待つ
+		kFinished, // 鳴り終わった（ワーカーが片付ける）
+	};
+
+	/// <summary>
+	/// 再生中のストリーム（ワーカーだけが作り直し・削除する）
+	/// </summary>
+	struct Stream {
+		std::string fileName;
+		bool loopFlag = false;
+		// ファイルの代わりにミキサーの出力を流す
+		AudioMixer* mixer = nullptr;
+
+		std::ifstream file;
+		// 波形フォーマット（WAVEFORMATEXTENSIBLE まで入る大きさ）
+		std::vector<uint8_t> format;
+		// data チャンクの位置と大きさ
+		uint32_t dataOffset = 0;
+		uint32_t dataSize = 0;
+		// data チャンク内の読み込み位置
+		uint32_t readPosition = 0;
+		// 1回に読む大きさ（ブロック境界に揃える）
+		uint32_t chunkSize = 0;
+
+		std::array<std::vector<uint8_t>, kBufferCount> buffers;
+		// 次に読み込むバッファ
+		uint32_t nextBuffer = 0;
+
+		IXAudio2SourceVoice* sourceVoice = nullptr;
+		VoiceCallback callback;
+
+		std::atomic<State> state = State::kOpening;
+		// 再生が終わって空いたバッファの数（コールバックで増え、ワーカーが減らす）
+		std::atomic<uint32_t> freeBufferCount = 0;
+		std::atomic<bool> streamEnded = false;
+		std::atomic<bool> stopRequested = false;
+		std::atomic<float> volume = 1.0f;
+		std::atomic<bool> volumeChanged = false;
+	};
+
+	/// <summary>
+	/// ワーカースレッド本体
+	/// </summary>
+	void Run();
+
+	/// <summary>
+	/// ワーカーを起こす
+	/// </summary>
+	void Notify();
+
+	/// <summary>
+	/// ストリームを登録してワーカーに渡す
+	/// </summary>
+	uint32_t Register(Stream* stream);
+
+	/// <summary>
+	/// ファイルを開いてボイスを作り、全バッファを積んで再生を始める
+	/// </summary>
+	bool Open(Stream* stream);
+
+	/// <summary>
+	/// 次のバッファに読み込んで積む
+	/// </summary>
+	void SubmitNextBuffer(Stream* stream);
+
+	/// <summary>
+	/// ボイスを止めて破棄する
+	/// </summary>
+	void Close(Stream* stream);
+
+	// XAudio2のインスタンス
+	Microsoft::WRL::ComPtr<IXAudio2> xAudio2_;
+	IXAudio2MasteringVoice* masteringVoice_ = nullptr;
+
+	// 効果音のミキサーと、その出力を流すストリーム
+	AudioMixer* mixer_ = nullptr;
+	uint32_t mixerHandle_ = kInvalidHandle;
+	// 効果音のデータ（ミキサーのボイスが中を指すので、ミキサーより後に解放する）
+	SoundBank soundBank_;
+
+	// サウンド格納ディレクトリ
+	std::string directoryPath_;
+
+	// 再生ハンドル → ストリーム
+	std::unordered_map<uint32_t, Stream*> streams_;
+	// 次に使う再生ハンドル
+	uint32_t nextHandle_ = 1;
+
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	std::thread worker_;
+	bool hasWork_ = false;
+	bool quit_ = false;
+};
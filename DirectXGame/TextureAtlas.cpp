@@ -0,0 +1,389 @@
+#define NOMINMAX
+#include "TextureAtlas.h"
+#include "AssetManager.h"
+#include <DirectXTex.h>
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+// imgui_draw.cpp の実装は STBRP_STATIC で閉じているので、こちらでも翻訳単位内に実装を持つ
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+using namespace KamataEngine;
+
+namespace {
+
+// Resources/ からの相対パス → 実際のパス
+std::filesystem::path MakeResourcePath(const std::string& fileName) { return std::filesystem::path(ConvertStringMultiByteToWide("Resources/" + fileName)); }
+
+// パスからファイル名部分を取り出す（mtl のテクスチャ名は絶対パスのこともある）
+std::string GetFileName(const std::string& path) {
+	size_t separator = path.find_last_of("/\\");
+	return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+
+// 4の倍数に切り上げる（ブロック圧縮やミップマップで端数が出ないようにする）
+uint32_t AlignUp4(uint32_t value) { return (value + 3) & ~3u; }
+
+} // namespace
+
+TextureAtlas* TextureAtlas::GetInstance() {
+	static TextureAtlas instance;
+	return &instance;
+}
+
+void TextureAtlas::Build(const std::string& atlasName, const std::vector<std::string>& fileNames) {
+
+	std::vector<PageSize> pages;
+	std::vector<Placement> placements;
+
+	// 元画像が更新されていなければ前回の結果を使う
+	if (!LoadTable(atlasName, fileNames, pages, placements)) {
+		Pack(atlasName, fileNames, pages, placements);
+	}
+
+	// ページを読み込む（参照は Finalize まで持つ）
+	AssetManager* assetManager = AssetManager::GetInstance();
+	std::vector<uint32_t> handles;
+	handles.reserve(pages.size());
+	for (size_t page = 0; page < pages.size(); ++page) {
+		handles.push_back(assetManager->AcquireTexture(MakePageFileName(atlasName, page)));
+	}
+	pageHandles_.insert(pageHandles_.end(), handles.begin(), handles.end());
+
+	// 対応表を登録
+	for (const Placement& placement : placements) {
+		const PageSize& page = pages[placement.page];
+		const float pageWidth = static_cast<float>(page.width);
+		const float pageHeight = static_cast<float>(page.height);
+
+		Region region;
+		region.textureHandle = handles[placement.page];
+		region.texBase = {static_cast<float>(placement.x), static_cast<float>(placement.y)};
+		region.texSize = {static_cast<float>(placement.width), static_cast<float>(placement.height)};
+		region.uvMin = {region.texBase.x / pageWidth, region.texBase.y / pageHeight};
+		region.uvMax = {(region.texBase.x + region.texSize.x) / pageWidth, (region.texBase.y + region.texSize.y) / pageHeight};
+		regions_[placement.fileName] = region;
+	}
+}
+
+void TextureAtlas::Finalize() {
+
+	AssetManager* assetManager = AssetManager::GetInstance();
+	for (uint32_t handle : pageHandles_) {
+		assetManager->ReleaseTexture(handle);
+	}
+	pageHandles_.clear();
+	regions_.clear();
+}
+
+const TextureAtlas::Region* TextureAtlas::Find(const std::string& fileName) const {
+
+	auto it = regions_.find(fileName);
+	if (it == regions_.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+Sprite* TextureAtlas::CreateSprite(const std::string& fileName, const Vector2& position) const {
+
+	const Region* region = Find(fileName);
+	assert(region);
+
+	Sprite* sprite = Sprite::Create(region->textureHandle, position);
+	sprite->SetTextureRect(region->texBase, region->texSize);
+	sprite->SetSize(region->texSize);
+	return sprite;
+}
+
+uint32_t TextureAtlas::ApplyToModel(Model* model, const std::string& modelName) const {
+
+	// uvが範囲外だと繰り返しが隣の画像にはみ出すので付け替えない（誤差は許容する）
+	constexpr float kEpsilon = 1.0e-4f;
+
+	uint32_t textureHandle = kInvalidHandle;
+	std::vector<std::pair<Material*, const Region*>> remaps;
+
+	for (const std::unique_ptr<Mesh>& mesh : model->GetMeshes()) {
+		Material* material = mesh->GetMaterial();
+		if (!material) {
+			return kInvalidHandle;
+		}
+
+		const Region* region = Find(modelName + "/" + GetFileName(material->textureFilename_));
+		if (!region) {
+			return kInvalidHandle;
+		}
+
+		// 1回の描画で差し替えられるテクスチャは1枚だけ
+		if (textureHandle != kInvalidHandle && textureHandle != region->textureHandle) {
+			return kInvalidHandle;
+		}
+		textureHandle = region->textureHandle;
+
+		for (const Mesh::VertexPosNormalUv& vertex : mesh->GetVertices()) {
+			if (vertex.uv.x < -kEpsilon || vertex.uv.x > 1.0f + kEpsilon || vertex.uv.y < -kEpsilon || vertex.uv.y > 1.0f + kEpsilon) {
+				return kInvalidHandle;
+			}
+		}
+
+		remaps.emplace_back(material, region);
+	}
+
+	// メッシュ間でマテリアルを共有していることがあるので、付け替えは全て確認してからまとめて行う
+	std::unordered_set<Material*> applied;
+	for (auto& [material, region] : remaps) {
+		if (!applied.insert(material).second) {
+			continue;
+		}
+		material->uvScale_ = {region->uvMax.x - region->uvMin.x, region->uvMax.y - region->uvMin.y, 1.0f};
+		material->uvOffset_ = {region->uvMin.x, region->uvMin.y, 0.0f};
+		material->Update();
+	}
+
+	return textureHandle;
+}
+
+uint32_t TextureAtlas::ApplyToModelData(ObjFile::ModelData& model, const std::string& modelName) const {
+
+	// uvが範囲外だと繰り返しが隣の画像にはみ出すので書き換えない（誤差は許容する）
+	constexpr float kEpsilon = 1.0e-4f;
+
+	uint32_t textureHandle = kInvalidHandle;
+	std::vector<const Region*> regions;
+
+	for (const ObjFile::MeshData& mesh : model.meshes) {
+		const Region* region = Find(modelName + "/" + GetFileName(model.materials[mesh.material].textureFileName));
+		if (!region) {
+			return kInvalidHandle;
+		}
+
+		// 1回の描画で使うテクスチャは1枚だけ
+		if (textureHandle != kInvalidHandle && textureHandle != region->textureHandle) {
+			return kInvalidHandle;
+		}
+		textureHandle = region->textureHandle;
+
+		for (const MeshOptimizer::Vertex& vertex : mesh.vertices) {
+			if (vertex.uv.x < -kEpsilon || vertex.uv.x > 1.0f + kEpsilon || vertex.uv.y < -kEpsilon || vertex.uv.y > 1.0f + kEpsilon) {
+				return kInvalidHandle;
+			}
+		}
+
+		regions.push_back(region);
+	}
+
+	// 頂点はメッシュごとに持っているので、全て確認してからメッシュごとに書き換える
+	// （マテリアルの uvScale/uvOffset で付け替えるのと同じ結果になり、量子化するuvの範囲も狭まる）
+	for (size_t i = 0; i < model.meshes.size(); ++i) {
+		const Region& region = *regions[i];
+		for (MeshOptimizer::Vertex& vertex : model.meshes[i].vertices) {
+			vertex.uv.x = region.uvMin.x + vertex.uv.x * (region.uvMax.x - region.uvMin.x);
+			vertex.uv.y = region.uvMin.y + vertex.uv.y * (region.uvMax.y - region.uvMin.y);
+		}
+	}
+
+	return textureHandle;
+}
+
+TextureAtlas::Region TextureAtlas::MakeRegion(uint32_t textureHandle) {
+
+	D3D12_RESOURCE_DESC desc = TextureManager::GetInstance()->GetResoureDesc(textureHandle);
+
+	Region region;
+	region.textureHandle = textureHandle;
+	region.texBase = {0.0f, 0.0f};
+	region.texSize = {static_cast<float>(desc.Width), static_cast<float>(desc.Height)};
+	region.uvMin = {0.0f, 0.0f};
+	region.uvMax = {1.0f, 1.0f};
+	return region;
+}
+
+bool TextureAtlas::LoadTable(const std::string& atlasName, const std::vector<std::string>& fileNames, std::vector<PageSize>& pages, std::vector<Placement>& placements) {
+
+	namespace fs = std::filesystem;
+	std::error_code error;
+
+	const fs::path tablePath = MakeResourcePath(MakeTableFileName(atlasName));
+	const fs::file_time_type tableTime = fs::last_write_time(tablePath, error);
+	if (error) {
+		return false;
+	}
+
+	// 元画像が対応表より新しければ詰め直す
+	for (const std::string& fileName : fileNames) {
+		fs::file_time_type sourceTime = fs::last_write_time(MakeResourcePath(fileName), error);
+		if (error || sourceTime > tableTime) {
+			return false;
+		}
+	}
+
+	std::ifstream file(tablePath);
+	if (!file) {
+		return false;
+	}
+
+	// page <番号> <幅> <高さ>
+	// image <ページ番号> <x> <y> <幅> <高さ> <ファイル名>
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream stream(line);
+		std::string kind;
+		stream >> kind;
+
+		if (kind == "page") {
+			size_t index = 0;
+			PageSize page;
+			stream >> index >> page.width >> page.height;
+			if (index != pages.size()) {
+				return false;
+			}
+			pages.push_back(page);
+		} else if (kind == "image") {
+			Placement placement;
+			stream >> placement.page >> placement.x >> placement.y >> placement.width >> placement.height >> std::ws;
+			std::getline(stream, placement.fileName);
+			placements.push_back(placement);
+		}
+	}
+
+	// 詰める画像の組み合わせが変わっていれば詰め直す
+	std::unordered_set<std::string> requested(fileNames.begin(), fileNames.end());
+	if (placements.size() != requested.size()) {
+		return false;
+	}
+	for (const Placement& placement : placements) {
+		if (!requested.contains(placement.fileName) || placement.page >= pages.size()) {
+			return false;
+		}
+	}
+	for (size_t page = 0; page < pages.size(); ++page) {
+		if (!fs::exists(MakeResourcePath(MakePageFileName(atlasName, page)), error)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void TextureAtlas::Pack(const std::string& atlasName, const std::vector<std::string>& fileNames, std::vector<PageSize>& pages, std::vector<Placement>& placements) {
+
+	pages.clear();
+	placements.clear();
+
+	// 元画像をRGBA8で読み込む
+	std::vector<DirectX::ScratchImage> images(fileNames.size());
+	for (size_t i = 0; i < fileNames.size(); ++i) {
+		DirectX::ScratchImage loaded;
+		HRESULT result = DirectX::LoadFromWICFile(MakeResourcePath(fileNames[i]).wstring().c_str(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, loaded);
+		assert(SUCCEEDED(result));
+
+		if (loaded.GetMetadata().format == DXGI_FORMAT_R8G8B8A8_UNORM) {
+			images[i] = std::move(loaded);
+		} else {
+			result = DirectX::Convert(*loaded.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, images[i]);
+			assert(SUCCEEDED(result));
+		}
+	}
+
+	// 余白込みの矩形
+	std::vector<stbrp_rect> pending(fileNames.size());
+	for (size_t i = 0; i < fileNames.size(); ++i) {
+		const DirectX::TexMetadata& metadata = images[i].GetMetadata();
+		pending[i] = {};
+		pending[i].id = static_cast<int>(i);
+		pending[i].w = static_cast<stbrp_coord>(metadata.width + kPadding * 2);
+		pending[i].h = static_cast<stbrp_coord>(metadata.height + kPadding * 2);
+
+		// 1ページに収まらない画像はアトラスに入れられない
+		assert(pending[i].w <= static_cast<stbrp_coord>(kMaxPageSize) && pending[i].h <= static_cast<stbrp_coord>(kMaxPageSize));
+	}
+
+	std::vector<stbrp_node> nodes(kMaxPageSize);
+	placements.resize(fileNames.size());
+
+	// 入りきらなかった分は次のページへ
+	while (!pending.empty()) {
+		stbrp_context context;
+		stbrp_init_target(&context, kMaxPageSize, kMaxPageSize, nodes.data(), static_cast<int>(nodes.size()));
+		stbrp_pack_rects(&context, pending.data(), static_cast<int>(pending.size()));
+
+		const uint32_t pageIndex = static_cast<uint32_t>(pages.size());
+		PageSize page;
+		std::vector<stbrp_rect> rest;
+		std::vector<stbrp_rect> packed;
+		for (const stbrp_rect& rect : pending) {
+			if (!rect.was_packed) {
+				rest.push_back(rect);
+				continue;
+			}
+			packed.push_back(rect);
+			page.width = std::max(page.width, static_cast<uint32_t>(rect.x + rect.w));
+			page.height = std::max(page.height, static_cast<uint32_t>(rect.y + rect.h));
+		}
+		assert(!packed.empty());
+
+		// 使った範囲だけのページにする
+		page.width = AlignUp4(page.width);
+		page.height = AlignUp4(page.height);
+
+		DirectX::ScratchImage pageImage;
+		HRESULT result = pageImage.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, page.width, page.height, 1, 1);
+		assert(SUCCEEDED(result));
+		const DirectX::Image* destination = pageImage.GetImage(0, 0, 0);
+		std::fill(destination->pixels, destination->pixels + destination->slicePitch, static_cast<uint8_t>(0));
+
+		for (const stbrp_rect& rect : packed) {
+			const DirectX::Image* source = images[rect.id].GetImage(0, 0, 0);
+			const int sourceWidth = static_cast<int>(source->width);
+			const int sourceHeight = static_cast<int>(source->height);
+			const int padding = static_cast<int>(kPadding);
+
+			// 余白には端の画素を引き伸ばして書く
+			for (int y = 0; y < rect.h; ++y) {
+				const int sourceY = std::clamp(y - padding, 0, sourceHeight - 1);
+				const uint32_t* sourceRow = reinterpret_cast<const uint32_t*>(source->pixels + sourceY * source->rowPitch);
+				uint32_t* destinationRow = reinterpret_cast<uint32_t*>(destination->pixels + (rect.y + y) * destination->rowPitch) + rect.x;
+				for (int x = 0; x < rect.w; ++x) {
+					destinationRow[x] = sourceRow[std::clamp(x - padding, 0, sourceWidth - 1)];
+				}
+			}
+
+			Placement& placement = placements[rect.id];
+			placement.fileName = fileNames[rect.id];
+			placement.page = pageIndex;
+			placement.x = rect.x + kPadding;
+			placement.y = rect.y + kPadding;
+			placement.width = static_cast<uint32_t>(sourceWidth);
+			placement.height = static_cast<uint32_t>(sourceHeight);
+		}
+
+		// ページ画像の書き出し
+		std::filesystem::create_directories(MakeResourcePath(kDirectoryPath));
+		result = DirectX::SaveToWICFile(
+		    *destination, DirectX::WIC_FLAGS_IGNORE_SRGB, DirectX::GetWICCodec(DirectX::WIC_CODEC_PNG), MakeResourcePath(MakePageFileName(atlasName, pageIndex)).wstring().c_str());
+		assert(SUCCEEDED(result));
+
+		pages.push_back(page);
+		pending = std::move(rest);
+	}
+
+	// 対応表の書き出し（ページ画像より後に書くことで、途中で失敗した時は次回詰め直しになる）
+	std::ofstream file(MakeResourcePath(MakeTableFileName(atlasName)));
+	for (size_t page = 0; page < pages.size(); ++page) {
+		file << "page " << page << " " << pages[page].width << " " << pages[page].height << "\n";
+	}
+	for (const Placement& placement : placements) {
+		file << "image " << placement.page << " " << placement.x << " " << placement.y << " " << placement.width << " " << placement.height << " " << placement.fileName << "\n";
+	}
+}
+
+std::string TextureAtlas::MakePageFileName(const std::string& atlasName, size_t page) { return std::string(kDirectoryPath) + atlasName + "_" + std::to_string(page) + ".png"; }
+
+std::string TextureAtlas::MakeTableFileName(const std::string& atlasName) { return std::string(kDirectoryPath) + atlasName + ".txt"; }
@@ -0,0 +1,138 @@
+#pragma once
+#include "KamataEngine.h"
+#include "ObjFile.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// テクスチャアトラス
+/// 小さな画像を stb_rectpack で数枚のページに詰め、ページ画像と UV の対応表を Resources/atlas/ に書き出す
+/// 元画像より対応表が新しければ詰め直さずに対応表を読むだけにする
+/// （TextureManager のディスクリプタ数には上限があり、テクスチャが変わるたびに描画をまとめられなくなるため）
+/// </summary>
+class TextureAtlas {
+public:
+	// ページの最大サイズ（実際のページは使った範囲に切り詰める）
+	static constexpr uint32_t kMaxPageSize = 2048;
+
+	// 画像の周囲に複製する画素数（バイリニア補間で隣の画像が混ざらないようにする）
+	static constexpr uint32_t kPadding = 2;
+
+	// 無効なテクスチャハンドル
+	static constexpr uint32_t kInvalidHandle = UINT32_MAX;
+
+	// アトラスの書き出し先（Resources/ からの相対パス）
+	static constexpr const char* kDirectoryPath = "atlas/";
+
+	/// <summary>
+	/// ページ内の画像1枚分の範囲
+	/// </summary>
+	struct Region {
+		uint32_t textureHandle = kInvalidHandle; // ページのテクスチャハンドル
+		KamataEngine::Vector2 texBase;           // 左上の画素座標（Sprite::SetTextureRect 用）
+		KamataEngine::Vector2 texSize;           // 画素数
+		KamataEngine::Vector2 uvMin;             // 左上のuv
+		KamataEngine::Vector2 uvMax;             // 右下のuv
+	};
+
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	static TextureAtlas* GetInstance();
+
+	/// <summary>
+	/// アトラスの構築（シーンの初期化より前に呼ぶ）
+	/// </summary>
+	/// <param name="atlasName">アトラス名（書き出すファイル名に使う）</param>
+	/// <param name="fileNames">詰める画像（Resources/ からの相対パス、モデルのテクスチャは "モデル名/ファイル名"）</param>
+	void Build(const std::string& atlasName, const std::vector<std::string>& fileNames);
+
+	/// <summary>
+	/// 終了処理（AssetManager::Finalize より前に呼ぶ）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 画像の範囲を探す
+	/// </summary>
+	/// <param name="fileName">Build に渡したファイル名</param>
+	/// <returns>範囲（アトラスに無ければnullptr）</returns>
+	const Region* Find(const std::string& fileName) const;
+
+	/// <summary>
+	/// アトラス上の画像を貼ったスプライトの生成（大きさは元画像と同じ）
+	/// </summary>
+	/// <param name="fileName">Build に渡したファイル名</param>
+	/// <param name="position">座標</param>
+	/// <returns>生成されたスプライト</returns>
+	KamataEngine::Sprite* CreateSprite(const std::string& fileName, const KamataEngine::Vector2& position) const;
+
+	/// <summary>
+	/// モデルのマテリアルのuvをアトラス上の範囲に付け替える
+	/// 全メッシュのテクスチャが同じページにあり、uvが0〜1に収まっている時だけ付け替える
+	/// 付け替えたモデルは Model::Draw にページのテクスチャハンドルを渡して描画すること
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="modelName">モデル名</param>
+	/// <returns>ページのテクスチャハンドル（付け替えなかった場合はkInvalidHandle）</returns>
+	uint32_t ApplyToModel(KamataEngine::Model* model, const std::string& modelName) const;
+
+	/// <summary>
+	/// 解析済みOBJの頂点のuvをアトラス上の範囲に書き換える（付け替える条件は ApplyToModel と同じ）
+	/// 書き換えたモデルは全マテリアルのテクスチャをページのテクスチャにして OptimizedModel::Create すること
+	/// </summary>
+	/// <param name="model">ObjFile で読み込んだモデル</param>
+	/// <param name="modelName">モデル名</param>
+	/// <returns>ページのテクスチャハンドル（書き換えなかった場合はkInvalidHandle）</returns>
+	uint32_t ApplyToModelData(ObjFile::ModelData& model, const std::string& modelName) const;
+
+	/// <summary>
+	/// テクスチャ全体を表す範囲（アトラスに入っていないテクスチャ用）
+	/// </summary>
+	static Region MakeRegion(uint32_t textureHandle);
+
+private:
+	TextureAtlas() = default;
+	~TextureAtlas() = default;
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	// 画像1枚の配置（余白を除いた画素範囲）
+	struct Placement {
+		std::string fileName;
+		uint32_t page = 0;
+		uint32_t x = 0;
+		uint32_t y = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	// ページの大きさ
+	struct PageSize {
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	/// <summary>
+	/// 書き出し済みの対応表を読む（元画像より古ければ false）
+	/// </summary>
+	static bool LoadTable(const std::string& atlasName, const std::vector<std::string>& fileNames, std::vector<PageSize>& pages, std::vector<Placement>& placements);
+
+	/// <summary>
+	/// 画像を詰めてページ画像と対応表を書き出す
+	/// </summary>
+	static void Pack(const std::string& atlasName, const std::vector<std::string>& fileNames, std::vector<PageSize>& pages, std::vector<Placement>& placements);
+
+	// ページのファイル名（Resources/ からの相対パス）
+	static std::string MakePageFileName(const std::string& atlasName, size_t page);
+
+	// 対応表のファイル名（Resources/ からの相対パス）
+	static std::string MakeTableFileName(const std::string& atlasName);
+
+	// ファイル名 → 範囲
+	std::unordered_map<std::string, Region> regions_;
+	// 読み込んだページ
+	std::vector<uint32_t> pageHandles_;
+};
@@ -1,11 +1,15 @@
 #include "TitleScene.h"
+#include "AssetManager.h"
+#include "StreamingAudio.h"
 #include <numbers>
 
 void TitleScene::Initialize() {
 
-	model_ = Model::CreateFromOBJ("title", true);
+	AssetManager* assetManager = AssetManager::GetInstance();
 
-	startModel_ = Model::CreateFromOBJ("start", true);
+	model_ = assetManager->AcquireOptimizedModel("title", true);
+
+	startModel_ = assetManager->AcquireOptimizedModel("start", true);
 
 	worldTransform_.Initialize();
 	worldTransform_.translation_ = {-3.0f, 1.0f, 3.0f};
@@ -20,7 +24,7 @@ void TitleScene::Initialize() {
 	fade_->Initialize();
 	fade_->Start(Fade::Status::FadeIn, kFadeDuration);
 
-	backgroundModel_ = Model::CreateFromOBJ("background", true);
+	backgroundModel_ = assetManager->AcquireOptimizedModel("background", true);
 
 	worldTransformBack_.Initialize();
 	worldTransformBack_.translation_ = {0.0f, 0.0f, 15.0f};
@@ -50,6 +54,7 @@ void TitleScene::Update() {
 		showPress_ = (std::sin(blinkT_ * 6.0f) > 0.0f);
 
 		if (Input::GetInstance()->PushKey(DIK_SPACE)) {
+			StreamingAudio::GetInstance()->PlaySoundEffect("mokugyo.wav");
 			fade_->Start(Fade::Status::FadeOut, kFadeDuration);
 			phase_ = Phase::kFadeOut;
 		}
@@ -85,8 +90,25 @@ void TitleScene::Draw() {
 	Model::PostDraw();
 }
 
+AssetManifest TitleScene::GetAssetManifest() {
+
+	// Initializeで取得するアセットと揃えること
+	AssetManifest manifest;
+	manifest.optimizedModels = {
+	    {"background", true},
+	    {"title",      true},
+	    {"start",      true},
+	};
+	return manifest;
+}
+
 TitleScene::~TitleScene() {
-	delete model_;
-	delete backgroundModel_;
+
+	// モデルの参照を返す（実際の解放はAssetManagerが判断する）
+	AssetManager* assetManager = AssetManager::GetInstance();
+	assetManager->ReleaseOptimizedModel(model_);
+	assetManager->ReleaseOptimizedModel(startModel_);
+	assetManager->ReleaseOptimizedModel(backgroundModel_);
+
 	delete fade_;
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include "AssetManager.h"
 #include "Fade.h"
 #include "KamataEngine.h"
 #include "WorldMatrixTransform.h"
@@ -14,6 +15,14 @@ public:
 
 	bool IsFinished() const { return finished_; }
 
+	// フェードアウト中か（次シーンの先読み開始に使う）
+	bool IsFadingOut() const { return phase_ == Phase::kFadeOut; }
+
+	/// <summary>
+	/// このシーンで使うアセット一覧
+	/// </summary>
+	static AssetManifest GetAssetManifest();
+
 	~TitleScene();
 
 private:
@@ -26,8 +35,9 @@ private:
 	// 現在のフェーズ
 	Phase phase_ = Phase::kFadeIn;
 
-	Model* model_ = nullptr;
-	Model* startModel_ = nullptr;
+	// 平滑化するモデルは全て最適化済みモデルを使う
+	OptimizedModel* model_ = nullptr;
+	OptimizedModel* startModel_ = nullptr;
 
 	WorldTransform worldTransform_;
 	WorldTransform startWorldTransform_;
@@ -44,7 +54,7 @@ private:
 	float blinkT_ = 0.0f;
 	bool showPress_ = true; // 描画フラグ
 
-	Model* backgroundModel_ = nullptr;
+	OptimizedModel* backgroundModel_ = nullptr;
 	WorldTransform worldTransformBack_;
 
 	Model* titleEnemy_ = nullptr;
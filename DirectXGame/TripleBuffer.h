@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// 書き込み1スレッド・読み出し1スレッドの3面バッファ（ロックフリー）
+/// 書き込み側と読み出し側がそれぞれ1面ずつ持ち、残りの1面を atomic の入れ替えで受け渡す
+/// 読み出し側は常に最後に出来上がった面を取り、どちらも相手を待たない
+/// </summary>
+/// <typeparam name="T">1面分のデータ（使い回すので、中の容量はそのまま残る）</typeparam>
+template<typename T>
+class TripleBuffer {
+public:
+	TripleBuffer() = default;
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	/// <summary>
+	/// 書き込み中の面（書き込み側だけ）
+	/// </summary>
+	T& GetWriteBuffer() { return buffers_[writeIndex_]; }
+
+	/// <summary>
+	/// 書き込んだ面を渡して、次に書く面を受け取る（書き込み側だけ）
+	/// </summary>
+	void Publish() { writeIndex_ = shared_.exchange(writeIndex_ | kFreshBit, std::memory_order_acq_rel) & kIndexMask; }
+
+	/// <summary>
+	/// 新しい面があれば受け取る（読み出し側だけ）
+	/// </summary>
+	/// <returns>受け取ったか（false なら前の面のまま）</returns>
+	bool Acquire() {
+
+		if (!(shared_.load(std::memory_order_relaxed) & kFreshBit)) {
+			return false;
+		}
+		readIndex_ = shared_.exchange(readIndex_, std::memory_order_acq_rel) & kIndexMask;
+		return true;
+	}
+
+	/// <summary>
+	/// 読み出し中の面（読み出し側だけ、一度も受け取っていなければ空の面）
+	/// </summary>
+	const T& GetReadBuffer() const { return buffers_[readIndex_]; }
+
+private:
+	// 受け渡し中の面の番号と、読み出し側がまだ受け取っていない印
+	static constexpr uint32_t kIndexMask = 0x3;
+	static constexpr uint32_t kFreshBit = 0x4;
+	// 書き込み側・受け渡し・読み出し側の番号を離す幅
+	static constexpr size_t kCacheLineSize = 64;
+
+	T buffers_[3];
+	// 書き込み側の面（書き込み側だけが触る）
+	uint32_t writeIndex_ = 0;
+	// 受け渡し中の面（隣の変数と同じキャッシュラインにしないよう、前後に1本分の詰め物を置く）
+	// alignas で揃えると GameScene まで詰め物が入り、/W4 の C4324 になる
+	unsigned char writePadding_[kCacheLineSize];
+	std::atomic<uint32_t> shared_ = 1;
+	unsigned char sharedPadding_[kCacheLineSize];
+	// 読み出し側の面（読み出し側だけが触る）
+	uint32_t readIndex_ = 2;
+};
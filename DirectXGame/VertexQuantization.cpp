@@ -0,0 +1,186 @@
+#define NOMINMAX
+#include "VertexQuantization.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+using namespace KamataEngine;
+
+namespace {
+
+constexpr float kUnorm16Max = 65535.0f;
+constexpr float kSnorm16Max = 32767.0f;
+
+// 16bit八面体エンコードの角度誤差上限（度）
+// 格子間隔 2/65534 の半対角を球面に写したときの最大値に余裕を持たせた値
+constexpr float kOctahedralErrorDegrees = 0.01f;
+
+// 0 を正として扱う符号
+float SignNotZero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+// [min, min + scale] を 16bit 正規化整数へ
+uint16_t ToUnorm16(float value, float min, float scale) {
+	if (scale <= 0.0f) {
+		return 0;
+	}
+	float t = std::clamp((value - min) / scale, 0.0f, 1.0f);
+	return static_cast<uint16_t>(std::lround(t * kUnorm16Max));
+}
+
+float FromUnorm16(uint16_t value, float min, float scale) { return min + static_cast<float>(value) / kUnorm16Max * scale; }
+
+// 量子化の半ステップ（floatの丸め分を上乗せ）
+float HalfStep(float min, float scale) {
+	float magnitude = std::max(std::abs(min), std::abs(min + scale));
+	return scale * 0.5f / kUnorm16Max + magnitude * 1.0e-6f;
+}
+
+} // namespace
+
+namespace VertexQuantization {
+
+void EncodeOctahedral(const Vector3& normal, int16_t encoded[2]) {
+
+	float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (l1 <= 0.0f) {
+		// 長さ0の法線は+Zとして扱う
+		encoded[0] = 0;
+		encoded[1] = 0;
+		return;
+	}
+
+	// 八面体へ投影
+	float x = normal.x / l1;
+	float y = normal.y / l1;
+
+	// 下半球は折り返す
+	if (normal.z < 0.0f) {
+		float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+		float foldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+		x = foldedX;
+		y = foldedY;
+	}
+
+	encoded[0] = static_cast<int16_t>(std::lround(std::clamp(x, -1.0f, 1.0f) * kSnorm16Max));
+	encoded[1] = static_cast<int16_t>(std::lround(std::clamp(y, -1.0f, 1.0f) * kSnorm16Max));
+}
+
+Vector3 DecodeOctahedral(const int16_t encoded[2]) {
+
+	float x = std::max(static_cast<float>(encoded[0]) / kSnorm16Max, -1.0f);
+	float y = std::max(static_cast<float>(encoded[1]) / kSnorm16Max, -1.0f);
+	float z = 1.0f - std::abs(x) - std::abs(y);
+
+	// 下半球の折り返しを戻す
+	if (z < 0.0f) {
+		float unfoldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+		float unfoldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+		x = unfoldedX;
+		y = unfoldedY;
+	}
+
+	float length = std::sqrt(x * x + y * y + z * z);
+	return {x / length, y / length, z / length};
+}
+
+CompactMesh Quantize(const std::vector<Vertex>& vertices) {
+
+	CompactMesh mesh;
+	if (vertices.empty()) {
+		return mesh;
+	}
+
+	// AABBとUV範囲を求める
+	Vector3 positionMin = vertices[0].pos;
+	Vector3 positionMax = vertices[0].pos;
+	Vector2 uvMin = vertices[0].uv;
+	Vector2 uvMax = vertices[0].uv;
+	for (const Vertex& vertex : vertices) {
+		positionMin = {std::min(positionMin.x, vertex.pos.x), std::min(positionMin.y, vertex.pos.y), std::min(positionMin.z, vertex.pos.z)};
+		positionMax = {std::max(positionMax.x, vertex.pos.x), std::max(positionMax.y, vertex.pos.y), std::max(positionMax.z, vertex.pos.z)};
+		uvMin = {std::min(uvMin.x, vertex.uv.x), std::min(uvMin.y, vertex.uv.y)};
+		uvMax = {std::max(uvMax.x, vertex.uv.x), std::max(uvMax.y, vertex.uv.y)};
+	}
+
+	Params& params = mesh.params;
+	params.positionMin = positionMin;
+	params.positionScale = {positionMax.x - positionMin.x, positionMax.y - positionMin.y, positionMax.z - positionMin.z};
+	params.uvMin = uvMin;
+	params.uvScale = {uvMax.x - uvMin.x, uvMax.y - uvMin.y};
+
+	mesh.vertices.resize(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const Vertex& source = vertices[i];
+		CompactVertex& compact = mesh.vertices[i];
+
+		compact.position[0] = ToUnorm16(source.pos.x, params.positionMin.x, params.positionScale.x);
+		compact.position[1] = ToUnorm16(source.pos.y, params.positionMin.y, params.positionScale.y);
+		compact.position[2] = ToUnorm16(source.pos.z, params.positionMin.z, params.positionScale.z);
+		compact.position[3] = 0;
+
+		EncodeOctahedral(source.normal, compact.normal);
+
+		compact.uv[0] = ToUnorm16(source.uv.x, params.uvMin.x, params.uvScale.x);
+		compact.uv[1] = ToUnorm16(source.uv.y, params.uvMin.y, params.uvScale.y);
+	}
+
+	return mesh;
+}
+
+Vertex Decode(const CompactVertex& vertex, const Params& params) {
+
+	Vertex result;
+	result.pos.x = FromUnorm16(vertex.position[0], params.positionMin.x, params.positionScale.x);
+	result.pos.y = FromUnorm16(vertex.position[1], params.positionMin.y, params.positionScale.y);
+	result.pos.z = FromUnorm16(vertex.position[2], params.positionMin.z, params.positionScale.z);
+	result.normal = DecodeOctahedral(vertex.normal);
+	result.uv.x = FromUnorm16(vertex.uv[0], params.uvMin.x, params.uvScale.x);
+	result.uv.y = FromUnorm16(vertex.uv[1], params.uvMin.y, params.uvScale.y);
+	return result;
+}
+
+Error GetErrorBound(const Params& params) {
+
+	Error bound;
+	bound.position = std::max(
+	    {HalfStep(params.positionMin.x, params.positionScale.x), HalfStep(params.positionMin.y, params.positionScale.y), HalfStep(params.positionMin.z, params.positionScale.z)});
+	bound.normalDegrees = kOctahedralErrorDegrees;
+	bound.uv = std::max(HalfStep(params.uvMin.x, params.uvScale.x), HalfStep(params.uvMin.y, params.uvScale.y));
+	return bound;
+}
+
+Error Measure(const std::vector<Vertex>& vertices, const CompactMesh& mesh) {
+
+	Error error;
+
+	for (size_t i = 0; i < vertices.size() && i < mesh.vertices.size(); ++i) {
+		const Vertex& source = vertices[i];
+		Vertex decoded = Decode(mesh.vertices[i], mesh.params);
+
+		error.position = std::max({error.position, std::abs(decoded.pos.x - source.pos.x), std::abs(decoded.pos.y - source.pos.y), std::abs(decoded.pos.z - source.pos.z)});
+		error.uv = std::max({error.uv, std::abs(decoded.uv.x - source.uv.x), std::abs(decoded.uv.y - source.uv.y)});
+
+		// 長さ0の法線は比較しない
+		float length = std::sqrt(source.normal.x * source.normal.x + source.normal.y * source.normal.y + source.normal.z * source.normal.z);
+		if (length > 1.0e-6f) {
+			// 1 付近の acos は float だと精度が足りないので外積の長さ（sin）と内積から求める
+			double crossX = static_cast<double>(decoded.normal.y) * source.normal.z - static_cast<double>(decoded.normal.z) * source.normal.y;
+			double crossY = static_cast<double>(decoded.normal.z) * source.normal.x - static_cast<double>(decoded.normal.x) * source.normal.z;
+			double crossZ = static_cast<double>(decoded.normal.x) * source.normal.y - static_cast<double>(decoded.normal.y) * source.normal.x;
+			double dot = static_cast<double>(decoded.normal.x) * source.normal.x + static_cast<double>(decoded.normal.y) * source.normal.y + static_cast<double>(decoded.normal.z) * source.normal.z;
+			double radians = std::atan2(std::sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot);
+			error.normalDegrees = std::max(error.normalDegrees, static_cast<float>(radians * 180.0 / std::numbers::pi));
+		}
+	}
+
+	return error;
+}
+
+bool Validate(const std::vector<Vertex>& vertices, const CompactMesh& mesh) {
+
+	Error bound = GetErrorBound(mesh.params);
+	Error error = Measure(vertices, mesh);
+	return error.position <= bound.position && error.normalDegrees <= bound.normalDegrees && error.uv <= bound.uv;
+}
+
+} // namespace VertexQuantization
@@ -0,0 +1,94 @@
+#pragma once
+#include "MeshOptimizer.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 頂点の量子化（32byte の頂点を 16byte に詰める、OptimizedModel が GPU に送る頂点の形式）
+/// 座標はメッシュのAABB基準の16bit正規化整数、法線は八面体エンコードの16bit×2、
+/// UVはメッシュのUV範囲基準の16bit正規化整数で持つ
+/// </summary>
+namespace VertexQuantization {
+
+using Vertex = MeshOptimizer::Vertex;
+
+/// <summary>
+/// 量子化済み頂点
+/// </summary>
+struct CompactVertex {
+	uint16_t position[4]; // xyz（UNORM16、AABB基準）、wは未使用
+	int16_t normal[2];    // 八面体エンコード（SNORM16）
+	uint16_t uv[2];       // UNORM16、UV範囲基準
+};
+
+static_assert(sizeof(CompactVertex) == 16, "CompactVertex must be 16 bytes");
+
+/// <summary>
+/// 復元用パラメータ
+/// </summary>
+struct Params {
+	KamataEngine::Vector3 positionMin;   // AABB最小点
+	KamataEngine::Vector3 positionScale; // AABBの大きさ
+	KamataEngine::Vector2 uvMin;         // UV最小値
+	KamataEngine::Vector2 uvScale;       // UV範囲
+};
+
+/// <summary>
+/// 誤差
+/// </summary>
+struct Error {
+	float position = 0.0f;      // 座標の最大誤差（各軸、ワールド単位）
+	float normalDegrees = 0.0f; // 法線の最大角度誤差（度）
+	float uv = 0.0f;            // UVの最大誤差
+};
+
+/// <summary>
+/// 量子化済みメッシュ
+/// </summary>
+struct CompactMesh {
+	Params params;
+	std::vector<CompactVertex> vertices;
+};
+
+/// <summary>
+/// 法線を八面体エンコードする
+/// </summary>
+/// <param name="normal">単位ベクトル</param>
+/// <param name="encoded">エンコード結果</param>
+void EncodeOctahedral(const KamataEngine::Vector3& normal, int16_t encoded[2]);
+
+/// <summary>
+/// 八面体エンコードされた法線を復元する
+/// </summary>
+KamataEngine::Vector3 DecodeOctahedral(const int16_t encoded[2]);
+
+/// <summary>
+/// 頂点配列を量子化する
+/// </summary>
+/// <param name="vertices">頂点配列</param>
+/// <returns>量子化済みメッシュ</returns>
+CompactMesh Quantize(const std::vector<Vertex>& vertices);
+
+/// <summary>
+/// 量子化済み頂点を復元する
+/// </summary>
+Vertex Decode(const CompactVertex& vertex, const Params& params);
+
+/// <summary>
+/// 量子化の理論上の誤差上限
+/// </summary>
+Error GetErrorBound(const Params& params);
+
+/// <summary>
+/// 実際の誤差を計測する
+/// </summary>
+/// <param name="vertices">元の頂点配列</param>
+/// <param name="mesh">量子化済みメッシュ</param>
+Error Measure(const std::vector<Vertex>& vertices, const CompactMesh& mesh);
+
+/// <summary>
+/// 実際の誤差が理論上の上限に収まっているか
+/// </summary>
+bool Validate(const std::vector<Vertex>& vertices, const CompactMesh& mesh);
+
+} // namespace VertexQuantization
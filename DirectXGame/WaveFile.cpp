@@ -0,0 +1,71 @@
+#define NOMINMAX
+#include "WaveFile.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// チャンクヘッダ
+struct ChunkHeader {
+	char id[4];
+	uint32_t size;
+};
+
+// WAVEFORMATEX の大きさ（cbSize まで）
+constexpr size_t kWaveFormatExSize = 18;
+// WAVEFORMATEXTENSIBLE のサブフォーマットの位置
+constexpr size_t kSubFormatOffset = 24;
+
+} // namespace
+
+namespace WaveFile {
+
+uint16_t Header::GetSampleFormatTag() const {
+
+	const Format& waveFormat = GetFormat();
+	if (waveFormat.formatTag != kFormatExtensible || format.size() < kSubFormatOffset + sizeof(uint16_t)) {
+		return waveFormat.formatTag;
+	}
+
+	// サブフォーマットの GUID は先頭2バイトが波形の種類
+	uint16_t subFormat = 0;
+	std::memcpy(&subFormat, format.data() + kSubFormatOffset, sizeof(subFormat));
+	return subFormat;
+}
+
+bool ReadHeader(std::istream& stream, Header& header) {
+
+	header = {};
+
+	// RIFF ヘッダ
+	ChunkHeader riff{};
+	char waveId[4]{};
+	stream.read(reinterpret_cast<char*>(&riff), sizeof(riff));
+	stream.read(waveId, sizeof(waveId));
+	if (!stream || std::strncmp(riff.id, "RIFF", 4) != 0 || std::strncmp(waveId, "WAVE", 4) != 0) {
+		return false;
+	}
+
+	// fmt と data のチャンクを探す（それ以外は読み飛ばす）
+	ChunkHeader chunk{};
+	while (stream.read(reinterpret_cast<char*>(&chunk), sizeof(chunk))) {
+		if (std::strncmp(chunk.id, "fmt ", 4) == 0) {
+			header.format.assign(std::max<size_t>(chunk.size, kWaveFormatExSize), 0);
+			stream.read(reinterpret_cast<char*>(header.format.data()), chunk.size);
+		} else if (std::strncmp(chunk.id, "data", 4) == 0) {
+			header.dataOffset = static_cast<uint32_t>(stream.tellg());
+			header.dataSize = chunk.size;
+			break;
+		} else {
+			stream.seekg(chunk.size, std::ios_base::cur);
+		}
+		// チャンクは2バイト境界に揃っている
+		if (chunk.size % 2 != 0) {
+			stream.seekg(1, std::ios_base::cur);
+		}
+	}
+
+	return header.format.size() >= sizeof(Format) && header.dataSize > 0 && header.GetFormat().blockAlign > 0;
+}
+
+} // namespace WaveFile
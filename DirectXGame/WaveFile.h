@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+/// <summary>
+/// WAVファイルのヘッダ読み込み（プラットフォームに依存しない）
+/// ストリーミング再生とミキサーで同じ解析を使う
+/// </summary>
+namespace WaveFile {
+
+// 波形の種類
+constexpr uint16_t kFormatPcm = 0x0001;
+constexpr uint16_t kFormatFloat = 0x0003;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+/// <summary>
+/// fmt チャンクの先頭（WAVEFORMATEX と同じ並び）
+/// </summary>
+struct Format {
+	uint16_t formatTag;
+	uint16_t channels;
+	uint32_t samplesPerSec;
+	uint32_t avgBytesPerSec;
+	uint16_t blockAlign;
+	uint16_t bitsPerSample;
+};
+
+/// <summary>
+/// ヘッダの解析結果
+/// </summary>
+struct Header {
+	// fmt チャンクの中身（そのまま WAVEFORMATEX として渡せるよう、最低でも WAVEFORMATEX の大きさにしてある）
+	std::vector<uint8_t> format;
+	// data チャンクの位置と大きさ
+	uint32_t dataOffset = 0;
+	uint32_t dataSize = 0;
+
+	/// <summary>
+	/// fmt チャンクの先頭
+	/// </summary>
+	const Format& GetFormat() const { return *reinterpret_cast<const Format*>(format.data()); }
+
+	/// <summary>
+	/// サンプルの種類（WAVE_FORMAT_EXTENSIBLE ならサブフォーマットから取る）
+	/// </summary>
+	uint16_t GetSampleFormatTag() const;
+};
+
+/// <summary>
+/// RIFF ヘッダを読み、fmt と data のチャンクを探す
+/// 成功すると stream は data チャンクの先頭を指す
+/// </summary>
+/// <returns>WAVとして読めたか</returns>
+bool ReadHeader(std::istream& stream, Header& header);
+
+} // namespace WaveFile
@@ -1,7 +1,21 @@
+#include "AssetManager.h"
+#include "FrameArena.h"
+#include "FrameStats.h"
 #include "GameScene.h"
+#include "JobSystem.h"
 #include "KamataEngine.h"
+#include "MemoryTracker.h"
+#include "OptimizedModelPipeline.h"
+#include "Profiler.h"
+#include "RenderThread.h"
+#include "ScenePreloader.h"
+#include "SpriteBatch.h"
+#include "StreamingAudio.h"
+#include "TextureAtlas.h"
 #include "TitleScene.h"
 #include <Windows.h>
+#include <cassert>
+#include <string>
 
 using namespace KamataEngine;
 
@@ -16,14 +30,22 @@ enum class Scene {
 
 Scene scene = Scene::kUnknown;
 
+// 次シーンの先読み
+ScenePreloader scenePreloader;
+
+// フレーム時間の書き出し先
+const char* const kFrameStatsPath = "frame_stats.csv";
+
 void ChangeScene();
 
+std::string GetTracePath(const char* commandLine);
+
 void UpdateScene();
 
 void DrawScene();
 
 // Windowsアプリでのエントリーポイント(main関数)
-int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
+int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR lpCmdLine, _In_ int) {
 
 	// エンジンの初期化
 	KamataEngine::Initialize(L"LE2B_08_コジマ_ユウヤ_スライム疾駆");
@@ -31,6 +53,53 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 	// DirectXCommonインスタンスの取得
 	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
 
+	AssetManager* assetManager = AssetManager::GetInstance();
+
+	// 計測（起動引数に --trace <ファイル> があれば終了時に Chrome のトレース形式で書き出す）
+	Profiler* profiler = Profiler::GetInstance();
+	profiler->SetThreadName("Main");
+	std::string tracePath = GetTracePath(lpCmdLine);
+
+	// フレーム時間の記録（F9 か終了時に CSV で書き出す）
+	FrameStats* frameStats = FrameStats::GetInstance();
+
+	// タグごとのメモリ使用量（フレームごとの確保が残っていないかを見る）
+	MemoryTracker* memoryTracker = MemoryTracker::GetInstance();
+
+	// 1フレームだけ使う一時データの置き場（フレームの頭で捨てる）
+	FrameArena* frameArena = FrameArena::GetInstance();
+	frameArena->Initialize();
+
+	// ジョブシステム（メインスレッドが0番のワーカーになる）
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	jobSystem->Initialize();
+
+	// 描画スレッド（ゲームシーンは前のティックのスナップショットを描く間に、メインスレッドで次のティックを更新する）
+	RenderThread* renderThread = RenderThread::GetInstance();
+	renderThread->Initialize();
+	auto drawGameScene = [] { gameScene->Draw(); };
+
+	// BGMのストリーミング再生
+	StreamingAudio* streamingAudio = StreamingAudio::GetInstance();
+	streamingAudio->Initialize();
+	// 効果音は Tools/SoundBankBuilder でまとめたバンクを1回で読む（Resources/*.wav を足したら作り直す）
+	[[maybe_unused]] bool soundBankLoaded = streamingAudio->LoadSoundBank("sfx.sbnk");
+	assert(soundBankLoaded);
+
+	// 小さいテクスチャはアトラスにまとめる（ページは終了まで参照を持つので常駐扱い）
+	// モデルのテクスチャはモデルの読み込み時にuvが付け替えられるので、シーンの初期化より前に作る
+	TextureAtlas* textureAtlas = TextureAtlas::GetInstance();
+	textureAtlas->Build("ui", {"operator.png", "black1x1.png", "white1x1.png", "debugfont.png"});
+	textureAtlas->Build("model", {"enemy/enemy.png", "goal/goal.png", "hitEffect/hitEffect1.png"});
+
+	// スプライトのまとめ描画
+	SpriteBatch* spriteBatch = SpriteBatch::GetInstance();
+	spriteBatch->Initialize(dxCommon->GetDevice(), WinApp::kWindowWidth, WinApp::kWindowHeight);
+
+	// 最適化済みモデルの描画パイプライン
+	OptimizedModelPipeline* optimizedModelPipeline = OptimizedModelPipeline::GetInstance();
+	optimizedModelPipeline->Initialize(dxCommon->GetDevice());
+
 #ifdef _DEBUG
 	scene = Scene::kGame;
 	gameScene = new GameScene();
@@ -43,40 +112,100 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 
 	// メインループ
 	while (true) {
+		frameArena->Reset();
+		profiler->BeginFrame();
+		frameStats->BeginFrame();
+		memoryTracker->BeginFrame();
+
 		// エンジンの更新
-		if (KamataEngine::Update()) {
-			break;
+		{
+			PROFILE_ZONE("KamataEngine::Update");
+			if (KamataEngine::Update()) {
+				break;
+			}
 		}
 
 		ChangeScene();
 
-		UpdateScene();
-
 		// 描画開始
 		dxCommon->PreDraw();
+		spriteBatch->BeginFrame();
+
+		// ゲームシーンのモデルはジョブで並列にバンドルへ記録し、描画スレッドがそれを順に実行する
+		// その間にメインスレッドは更新する（シーンの切り替えは両方が止まっている所で行う）
+		const bool isRenderThreadDrawing = scene == Scene::kGame;
+		if (isRenderThreadDrawing) {
+			gameScene->KickDraw();
+			renderThread->Kick(drawGameScene);
+		}
+
+		UpdateScene();
+
+		// 計測結果の表示（Debug のみ）
+		profiler->DrawOverlay();
+		frameStats->DrawOverlay();
+		memoryTracker->DrawOverlay();
+
+		if (Input::GetInstance()->TriggerKey(DIK_F9)) {
+			frameStats->WriteCsv(kFrameStatsPath);
+		}
+		frameStats->EndPhase(FrameStats::Phase::kUpdate);
+
+		if (isRenderThreadDrawing) {
+			gameScene->WaitDraw();
+			renderThread->Wait();
+		} else {
+			DrawScene();
+		}
+		frameStats->EndPhase(FrameStats::Phase::kDraw);
 
-		DrawScene();
+		// 描画終了（先読み中のGPUへの転送と重ならないように排他、OBJの解析中は待たない）
+		{
+			PROFILE_ZONE("DirectXCommon::PostDraw");
+			std::scoped_lock lock(assetManager->GetLoadMutex());
+			dxCommon->PostDraw();
+		}
+		frameStats->EndPhase(FrameStats::Phase::kPresent);
+	}
 
-		// 描画終了
-		dxCommon->PostDraw();
+	if (!tracePath.empty()) {
+		profiler->WriteChromeTrace(tracePath);
 	}
+	frameStats->WriteCsv(kFrameStatsPath);
 
 	// 解放処理
+	renderThread->Finalize();
+	scenePreloader.Reset();
+	delete titleScene;
+	delete gameScene;
+
+	// アセットの解放（エンジンより先に行う）
+	streamingAudio->Finalize();
+	spriteBatch->Finalize();
+	optimizedModelPipeline->Finalize();
+	textureAtlas->Finalize();
+	assetManager->Finalize();
+	jobSystem->Finalize();
+	frameArena->Finalize();
 
 	// エンジンの終了処理
 	KamataEngine::Finalize();
 
-	delete titleScene;
-	delete gameScene;
-
 	return 0;
 }
 
 void ChangeScene() {
 	switch (scene) {
 	case Scene::kTitle:
-		if (titleScene->IsFinished()) {
+		// フェードアウトが始まったら次シーンの先読みを開始
+		if (titleScene->IsFadingOut() && !scenePreloader.IsStarted()) {
+			scenePreloader.Start(GameScene::GetAssetManifest());
+		}
+
+		// フェードが終わっても読み込みが終わるまでは暗転のまま待つ
+		if (titleScene->IsFinished() && scenePreloader.IsCompleted()) {
 			// シーン変更
+			FrameStats::GetInstance()->AddMarker("ChangeScene");
 			scene = Scene::kGame;
 
 			// 旧シーンの解放
@@ -86,13 +215,23 @@ void ChangeScene() {
 			// 新シーンの生成と初期化
 			gameScene = new GameScene();
 			gameScene->Initialize();
+
+			// 先読みの参照を返し、新シーンで使われなかったアセットだけ解放
+			scenePreloader.Reset();
+			AssetManager::GetInstance()->CollectGarbage();
 		}
 		break;
 
 	case Scene::kGame:
+		// フェードアウトが始まったら次シーンの先読みを開始
+		if (gameScene->IsFadingOut() && !scenePreloader.IsStarted()) {
+			scenePreloader.Start(TitleScene::GetAssetManifest());
+		}
 
-		if (gameScene->IsFinished()) {
+		// フェードが終わっても読み込みが終わるまでは暗転のまま待つ
+		if (gameScene->IsFinished() && scenePreloader.IsCompleted()) {
 			// シーン変更
+			FrameStats::GetInstance()->AddMarker("ChangeScene");
 			scene = Scene::kTitle;
 
 			// 旧シーンの解放
@@ -102,6 +241,10 @@ void ChangeScene() {
 			// 新シーンの生成と初期化
 			titleScene = new TitleScene();
 			titleScene->Initialize();
+
+			// 先読みの参照を返し、新シーンで使われなかったアセットだけ解放
+			scenePreloader.Reset();
+			AssetManager::GetInstance()->CollectGarbage();
 		}
 
 		break;
@@ -135,4 +278,20 @@ void DrawScene() {
 	default:
 		break;
 	}
-}
\ No newline at end of file
+}
+
+std::string GetTracePath(const char* commandLine) {
+
+	// --trace の次の語をファイル名にする
+	std::string arguments = commandLine ? commandLine : "";
+	const std::string option = "--trace ";
+	size_t position = arguments.find(option);
+	if (position == std::string::npos) {
+		return {};
+	}
+	position = arguments.find_first_not_of(' ', position + option.size());
+	if (position == std::string::npos) {
+		return {};
+	}
+	return arguments.substr(position, arguments.find(' ', position) - position);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/// <summary>
+/// ベンチマークの登録と計測
+/// 各ベンチマークは BENCHMARK(名前) で定義すると main から名前で選んで実行できる
+/// </summary>
+namespace Benchmark {
+
+/// <summary>
+/// 登録されたベンチマーク
+/// </summary>
+struct Entry {
+	const char* name;
+	void (*function)();
+};
+
+/// <summary>
+/// 登録済みのベンチマーク一覧
+/// </summary>
+inline std::vector<Entry>& GetEntries() {
+	static std::vector<Entry> entries;
+	return entries;
+}
+
+/// <summary>
+/// 静的初期化で登録する
+/// </summary>
+struct Registrar {
+	Registrar(const char* name, void (*function)()) { GetEntries().push_back({name, function}); }
+};
+
+/// <summary>
+/// 経過時間の計測
+/// </summary>
+class Timer {
+public:
+	Timer() : start_(std::chrono::steady_clock::now()) {}
+
+	/// <summary>
+	/// 計測開始からの経過ミリ秒
+	/// </summary>
+	double GetMilliseconds() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count(); }
+
+private:
+	std::chrono::steady_clock::time_point start_;
+};
+
+/// <summary>
+/// 1行分の結果を出す
+/// </summary>
+/// <param name="label">計測内容</param>
+/// <param name="count">操作回数</param>
+/// <param name="milliseconds">かかった時間</param>
+inline void Report(const char* label, size_t count, double milliseconds) {
+	double nsPerOp = count > 0 ? milliseconds * 1000000.0 / static_cast<double>(count) : 0.0;
+	std::printf("  %-40s %8zu ops %10.3f ms %10.1f ns/op\n", label, count, milliseconds, nsPerOp);
+}
+
+} // namespace Benchmark
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+
+// ベンチマークの定義
+#define BENCHMARK(name)                                                                                                                                                                            \
+	static void Benchmark_##name();                                                                                                                                                                \
+	static Benchmark::Registrar BENCHMARK_CONCAT(benchmarkRegistrar_, name)(#name, &Benchmark_##name);                                                                                            \
+	static void Benchmark_##name()
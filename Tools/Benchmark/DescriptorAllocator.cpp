@@ -0,0 +1,117 @@
+#include "DescriptorAllocator.h"
+#include <bit>
+#include <cassert>
+
+DescriptorAllocator::DescriptorAllocator(uint32_t maxPageCount) : maxPageCount_(maxPageCount) {
+
+	assert(maxPageCount_ > 0);
+	AddPage();
+}
+
+uint32_t DescriptorAllocator::Allocate() {
+
+	// 解放済みの番号があればそれを使う
+	// フリーリストが空の時に空きビットに残っているのは一度も使っていない番号だけなので、両者が食い違うことはない
+	if (!freeList_.empty()) {
+		uint32_t slot = freeList_.back();
+		freeList_.pop_back();
+		MarkAllocated(slot);
+		return slot;
+	}
+
+	uint32_t slot = FindFirstFree();
+	if (slot == kInvalidSlot) {
+		// 全て使用中ならページを増やす
+		if (!AddPage()) {
+			return kInvalidSlot;
+		}
+		slot = FindFirstFree();
+	}
+
+	MarkAllocated(slot);
+	return slot;
+}
+
+void DescriptorAllocator::Free(uint32_t slot) {
+
+	assert(IsAllocated(slot));
+
+	const uint32_t wordIndex = slot / kBitsPerWord;
+	freeBits_[wordIndex] |= uint64_t(1) << (slot % kBitsPerWord);
+	nonEmptyWords_[wordIndex / kBitsPerWord] |= uint64_t(1) << (wordIndex % kBitsPerWord);
+
+	freeList_.push_back(slot);
+	--allocatedCount_;
+}
+
+bool DescriptorAllocator::IsAllocated(uint32_t slot) const {
+
+	if (slot >= GetCapacity()) {
+		return false;
+	}
+	return (freeBits_[slot / kBitsPerWord] & (uint64_t(1) << (slot % kBitsPerWord))) == 0;
+}
+
+void DescriptorAllocator::Reset() {
+
+	for (uint64_t& word : freeBits_) {
+		word = ~uint64_t(0);
+	}
+	for (uint64_t& word : nonEmptyWords_) {
+		word = 0;
+	}
+	for (uint32_t wordIndex = 0; wordIndex < freeBits_.size(); ++wordIndex) {
+		nonEmptyWords_[wordIndex / kBitsPerWord] |= uint64_t(1) << (wordIndex % kBitsPerWord);
+	}
+
+	freeList_.clear();
+	allocatedCount_ = 0;
+}
+
+bool DescriptorAllocator::AddPage() {
+
+	if (pageCount_ >= maxPageCount_) {
+		return false;
+	}
+
+	const uint32_t firstWord = static_cast<uint32_t>(freeBits_.size());
+	freeBits_.resize(firstWord + kWordsPerPage, ~uint64_t(0));
+	nonEmptyWords_.resize((freeBits_.size() + kBitsPerWord - 1) / kBitsPerWord, 0);
+	for (uint32_t wordIndex = firstWord; wordIndex < freeBits_.size(); ++wordIndex) {
+		nonEmptyWords_[wordIndex / kBitsPerWord] |= uint64_t(1) << (wordIndex % kBitsPerWord);
+	}
+
+	// 次に確保する番号と同じ数だけ先に確保しておく（確保のたびに伸ばさない）
+	freeList_.reserve(freeBits_.size() * kBitsPerWord);
+
+	++pageCount_;
+	return true;
+}
+
+uint32_t DescriptorAllocator::FindFirstFree() const {
+
+	// 上位ビットマップ → 空きビットの順に countr_zero で下りる
+	// 上位1ワードで4096個分を見られるので、64ページでも16ワードしか見ない
+	for (uint32_t summaryIndex = 0; summaryIndex < nonEmptyWords_.size(); ++summaryIndex) {
+		uint64_t summary = nonEmptyWords_[summaryIndex];
+		if (summary == 0) {
+			continue;
+		}
+		const uint32_t wordIndex = summaryIndex * kBitsPerWord + static_cast<uint32_t>(std::countr_zero(summary));
+		return wordIndex * kBitsPerWord + static_cast<uint32_t>(std::countr_zero(freeBits_[wordIndex]));
+	}
+	return kInvalidSlot;
+}
+
+void DescriptorAllocator::MarkAllocated(uint32_t slot) {
+
+	const uint32_t wordIndex = slot / kBitsPerWord;
+	uint64_t& word = freeBits_[wordIndex];
+	assert(word & (uint64_t(1) << (slot % kBitsPerWord)));
+
+	word &= ~(uint64_t(1) << (slot % kBitsPerWord));
+	if (word == 0) {
+		nonEmptyWords_[wordIndex / kBitsPerWord] &= ~(uint64_t(1) << (wordIndex % kBitsPerWord));
+	}
+	++allocatedCount_;
+}
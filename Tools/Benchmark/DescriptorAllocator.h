@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ディスクリプタの空き番号管理
+/// 解放された番号はフリーリストから O(1) で再利用し、未使用の番号は空きビットの2段ビットマップから
+/// countr_zero で探す（1024個のビット列を先頭から走査しない）
+/// 足りなくなればページ単位で番号を増やす
+/// TextureSlotTable と同じく、ゲームには組み込まずベンチマークの中にだけ置く
+/// </summary>
+class DescriptorAllocator {
+public:
+	// 1ページの番号数
+	static constexpr uint32_t kPageSize = 1024;
+
+	// 無効な番号
+	static constexpr uint32_t kInvalidSlot = UINT32_MAX;
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="maxPageCount">ページ数の上限</param>
+	explicit DescriptorAllocator(uint32_t maxPageCount = 64);
+
+	/// <summary>
+	/// 番号の確保
+	/// </summary>
+	/// <returns>番号（上限に達していればkInvalidSlot）</returns>
+	uint32_t Allocate();
+
+	/// <summary>
+	/// 番号の解放
+	/// </summary>
+	/// <param name="slot">Allocateで確保した番号</param>
+	void Free(uint32_t slot);
+
+	/// <summary>
+	/// 確保済みか
+	/// </summary>
+	bool IsAllocated(uint32_t slot) const;
+
+	/// <summary>
+	/// 全て解放する（ページは残す）
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 確保済みの数
+	/// </summary>
+	uint32_t GetAllocatedCount() const { return allocatedCount_; }
+
+	/// <summary>
+	/// 今のページ数（ディスクリプタヒープをページ単位で作る時に使う）
+	/// </summary>
+	uint32_t GetPageCount() const { return pageCount_; }
+
+	/// <summary>
+	/// 番号の数（ページ数 × kPageSize）
+	/// </summary>
+	uint32_t GetCapacity() const { return pageCount_ * kPageSize; }
+
+	/// <summary>
+	/// 番号が属するページ
+	/// </summary>
+	static uint32_t GetPageIndex(uint32_t slot) { return slot / kPageSize; }
+
+	/// <summary>
+	/// ページ内の位置
+	/// </summary>
+	static uint32_t GetIndexInPage(uint32_t slot) { return slot % kPageSize; }
+
+private:
+	// 1ワードのビット数
+	static constexpr uint32_t kBitsPerWord = 64;
+	// 1ページのワード数
+	static constexpr uint32_t kWordsPerPage = kPageSize / kBitsPerWord;
+
+	/// <summary>
+	/// ページを1つ増やす
+	/// </summary>
+	bool AddPage();
+
+	/// <summary>
+	/// 空きビットの中で一番小さい番号
+	/// </summary>
+	uint32_t FindFirstFree() const;
+
+	/// <summary>
+	/// 確保済みにする
+	/// </summary>
+	void MarkAllocated(uint32_t slot);
+
+	// 空きビット（1が空き）
+	std::vector<uint64_t> freeBits_;
+	// 空きのあるワード（1ビットが freeBits_ の1ワードに対応）
+	std::vector<uint64_t> nonEmptyWords_;
+	// 解放された番号（後から解放したものほど先に使う）
+	std::vector<uint32_t> freeList_;
+
+	uint32_t pageCount_ = 0;
+	uint32_t maxPageCount_ = 0;
+	uint32_t allocatedCount_ = 0;
+};
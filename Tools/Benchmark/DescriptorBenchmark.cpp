@@ -0,0 +1,197 @@
+#include "Benchmark.h"
+#include "TextureSlotTable.h"
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+
+/// <summary>
+/// 以前の TextureManager と同じ探し方の表
+/// 空き番号はビット列を先頭のワードから、重複は名前を先頭から比較して探す
+/// </summary>
+class LegacySlotTable {
+public:
+	explicit LegacySlotTable(uint32_t capacity) : used_((capacity + 63) / 64, 0), names_(capacity) {}
+
+	uint32_t Load(const std::string& path) {
+
+		for (uint32_t i = 0; i < names_.size(); ++i) {
+			if (IsUsed(i) && names_[i] == path) {
+				return i;
+			}
+		}
+
+		uint32_t slot = FindFirst();
+		if (slot == UINT32_MAX) {
+			return UINT32_MAX;
+		}
+		used_[slot / 64] |= uint64_t(1) << (slot % 64);
+		names_[slot] = path;
+		return slot;
+	}
+
+	void Unload(uint32_t slot) {
+		used_[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+		names_[slot].clear();
+	}
+
+private:
+	bool IsUsed(uint32_t slot) const { return (used_[slot / 64] & (uint64_t(1) << (slot % 64))) != 0; }
+
+	uint32_t FindFirst() const {
+		for (uint32_t word = 0; word < used_.size(); ++word) {
+			if (used_[word] == ~uint64_t(0)) {
+				continue;
+			}
+			for (uint32_t bit = 0; bit < 64; ++bit) {
+				if ((used_[word] & (uint64_t(1) << bit)) == 0) {
+					uint32_t slot = word * 64 + bit;
+					return slot < names_.size() ? slot : UINT32_MAX;
+				}
+			}
+		}
+		return UINT32_MAX;
+	}
+
+	std::vector<uint64_t> used_;
+	std::vector<std::string> names_;
+};
+
+std::vector<std::string> MakePaths(uint32_t count) {
+	std::vector<std::string> paths;
+	paths.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		paths.push_back("stream/chunk" + std::to_string(i / 256) + "/texture" + std::to_string(i) + ".dds");
+	}
+	return paths;
+}
+
+// 一度に全部読み込んでから全部解放する
+constexpr uint32_t kBulkCount = 100000;
+// 以前の表は O(n^2) なので件数を減らして測る
+constexpr uint32_t kLegacyBulkCount = 10000;
+
+// 常駐数を保ったまま読み込みと解放を繰り返す（ストリーミングやアトラスの入れ替えを想定）
+constexpr uint32_t kChurnResident = 1000;
+constexpr uint32_t kChurnCount = 100000;
+constexpr uint32_t kChurnPathCount = 4000;
+
+// 入れ替えの手順（解放する常駐位置, 読み込むパス）の組を作る
+// 読み込むパスは常駐していないものを選ぶので、どちらの表でも毎回新規の読み込みになる
+std::vector<uint32_t> MakeChurnSequence() {
+	std::vector<uint32_t> residentPath(kChurnResident);
+	std::vector<bool> isResident(kChurnPathCount, false);
+	for (uint32_t i = 0; i < kChurnResident; ++i) {
+		residentPath[i] = i;
+		isResident[i] = true;
+	}
+
+	std::mt19937 random(1234);
+	std::vector<uint32_t> sequence;
+	sequence.reserve(kChurnCount * 2);
+	for (uint32_t i = 0; i < kChurnCount; ++i) {
+		uint32_t victim = random() % kChurnResident;
+		uint32_t path = random() % kChurnPathCount;
+		while (isResident[path]) {
+			path = random() % kChurnPathCount;
+		}
+		isResident[residentPath[victim]] = false;
+		isResident[path] = true;
+		residentPath[victim] = path;
+
+		sequence.push_back(victim);
+		sequence.push_back(path);
+	}
+	return sequence;
+}
+
+} // namespace
+
+BENCHMARK(DescriptorSlots) {
+
+	std::vector<std::string> paths = MakePaths(kBulkCount);
+	uint32_t checksum = 0;
+
+	// 一括読み込み・解放
+	{
+		TextureSlotTable table((kBulkCount + DescriptorAllocator::kPageSize - 1) / DescriptorAllocator::kPageSize);
+		std::vector<uint32_t> slots(kBulkCount);
+
+		Benchmark::Timer loadTimer;
+		for (uint32_t i = 0; i < kBulkCount; ++i) {
+			slots[i] = table.Insert(paths[i]).first;
+		}
+		Benchmark::Report("table: load (unique)", kBulkCount, loadTimer.GetMilliseconds());
+
+		Benchmark::Timer dedupTimer;
+		for (uint32_t i = 0; i < kBulkCount; ++i) {
+			checksum += table.Insert(paths[i]).first;
+		}
+		Benchmark::Report("table: load (already loaded)", kBulkCount, dedupTimer.GetMilliseconds());
+
+		Benchmark::Timer unloadTimer;
+		for (uint32_t i = 0; i < kBulkCount; ++i) {
+			table.Erase(slots[i]);
+		}
+		Benchmark::Report("table: unload", kBulkCount, unloadTimer.GetMilliseconds());
+		std::printf("  pages %u, capacity %u\n", table.GetCapacity() / DescriptorAllocator::kPageSize, table.GetCapacity());
+	}
+	{
+		LegacySlotTable table(kLegacyBulkCount);
+		std::vector<uint32_t> slots(kLegacyBulkCount);
+
+		Benchmark::Timer loadTimer;
+		for (uint32_t i = 0; i < kLegacyBulkCount; ++i) {
+			slots[i] = table.Load(paths[i]);
+		}
+		Benchmark::Report("legacy: load (unique)", kLegacyBulkCount, loadTimer.GetMilliseconds());
+
+		Benchmark::Timer dedupTimer;
+		for (uint32_t i = 0; i < kLegacyBulkCount; ++i) {
+			checksum += table.Load(paths[i]);
+		}
+		Benchmark::Report("legacy: load (already loaded)", kLegacyBulkCount, dedupTimer.GetMilliseconds());
+
+		Benchmark::Timer unloadTimer;
+		for (uint32_t i = 0; i < kLegacyBulkCount; ++i) {
+			table.Unload(slots[i]);
+		}
+		Benchmark::Report("legacy: unload", kLegacyBulkCount, unloadTimer.GetMilliseconds());
+	}
+
+	// 入れ替え（どちらも同じ乱数列で、以前の上限 1024 に収まる常駐数）
+	std::vector<uint32_t> churnPaths = MakeChurnSequence();
+	{
+		TextureSlotTable table(1);
+		std::vector<uint32_t> resident(kChurnResident);
+		for (uint32_t i = 0; i < kChurnResident; ++i) {
+			resident[i] = table.Insert(paths[i]).first;
+		}
+
+		Benchmark::Timer timer;
+		for (uint32_t i = 0; i < kChurnCount; ++i) {
+			uint32_t victim = churnPaths[i * 2];
+			table.Erase(resident[victim]);
+			resident[victim] = table.Insert(paths[churnPaths[i * 2 + 1]]).first;
+		}
+		Benchmark::Report("table: churn (unload + load)", kChurnCount, timer.GetMilliseconds());
+	}
+	{
+		LegacySlotTable table(1024);
+		std::vector<uint32_t> resident(kChurnResident);
+		for (uint32_t i = 0; i < kChurnResident; ++i) {
+			resident[i] = table.Load(paths[i]);
+		}
+
+		Benchmark::Timer timer;
+		for (uint32_t i = 0; i < kChurnCount; ++i) {
+			uint32_t victim = churnPaths[i * 2];
+			table.Unload(resident[victim]);
+			resident[victim] = table.Load(paths[churnPaths[i * 2 + 1]]);
+		}
+		Benchmark::Report("legacy: churn (unload + load)", kChurnCount, timer.GetMilliseconds());
+	}
+
+	std::printf("  checksum %u\n", checksum);
+}
@@ -0,0 +1,181 @@
+#define NOMINMAX
+#include "Benchmark.h"
+#include "DrawListRecorder.h"
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace {
+
+// 合成した描画の数（ブロック・敵・エフェクトが多く、UI は少し）
+constexpr uint32_t kDrawCount = 50000;
+constexpr uint32_t kFrameCount = 100;
+
+/// <summary>
+/// 記録に掛かる手間の代わりに、描画ごとに行列を1つ作る記録先（記録した内容は NullDrawListBackend に残す）
+/// </summary>
+class SimulatedDrawListBackend : public NullDrawListBackend {
+public:
+	void RecordList(uint32_t listIndex, RenderPass pass, std::span<const uint32_t> drawIndices) override {
+
+		// 定数バッファへの書き込みの代わり
+		float sum = 0.0f;
+		for (uint32_t drawIndex : drawIndices) {
+			float matrix[16];
+			for (uint32_t i = 0; i < 16; ++i) {
+				matrix[i] = static_cast<float>(drawIndex + i) * 0.25f;
+			}
+			for (uint32_t i = 0; i < 16; i += 5) {
+				sum += matrix[i];
+			}
+		}
+		sink_.fetch_add(static_cast<uint32_t>(sum), std::memory_order_relaxed);
+
+		NullDrawListBackend::RecordList(listIndex, pass, drawIndices);
+	}
+
+private:
+	std::atomic<uint32_t> sink_ = 0;
+};
+
+/// <summary>
+/// 描画の種類を作る（種類は混ざった順で追加され、UI は全体の1%）
+/// </summary>
+std::vector<RenderPass> MakePasses() {
+
+	std::mt19937 random(11);
+	std::uniform_int_distribution<uint32_t> kind(0, 99);
+
+	std::vector<RenderPass> passes(kDrawCount);
+	for (RenderPass& pass : passes) {
+		const uint32_t value = kind(random);
+		pass = value < 45 ? RenderPass::kBlocks : value < 75 ? RenderPass::kCharacters : value < 99 ? RenderPass::kEffects : RenderPass::kUI;
+	}
+	return passes;
+}
+
+/// <summary>
+/// 提出された順に並べた描画が、種類の順・同じ種類の中は追加した順になっているか
+/// </summary>
+bool IsSubmittedInOrder(const std::vector<RenderPass>& passes, const DrawListRecorder& recorder, const NullDrawListBackend& backend, uint32_t maxDrawsPerList) {
+
+	// 種類ごとに安定に並べた、期待する順
+	std::vector<uint32_t> expected(passes.size());
+	for (uint32_t i = 0; i < expected.size(); ++i) {
+		expected[i] = i;
+	}
+	std::stable_sort(expected.begin(), expected.end(), [&passes](uint32_t a, uint32_t b) { return passes[a] < passes[b]; });
+
+	const std::vector<uint32_t>& submitted = backend.GetSubmitted();
+	if (submitted.size() != recorder.GetLists().size()) {
+		return false;
+	}
+
+	size_t position = 0;
+	RenderPass previousPass = RenderPass::kBlocks;
+	for (uint32_t i = 0; i < submitted.size(); ++i) {
+		if (submitted[i] != i) {
+			return false;
+		}
+		const NullDrawListBackend::RecordedList& list = backend.GetLists()[i];
+		if (list.pass < previousPass || list.drawIndices.empty() || list.drawIndices.size() > maxDrawsPerList) {
+			return false;
+		}
+		previousPass = list.pass;
+
+		for (uint32_t drawIndex : list.drawIndices) {
+			if (position >= expected.size() || expected[position++] != drawIndex || passes[drawIndex] != list.pass) {
+				return false;
+			}
+		}
+	}
+	return position == expected.size();
+}
+
+/// <summary>
+/// パイプラインの番号が変わるところでリストが分かれ、種類ごとの順は変わらないか
+/// </summary>
+bool IsSplitByPipeline(const std::vector<RenderPass>& passes) {
+
+	// 最適化済みモデルが数個ずつ混ざる想定
+	std::vector<uint8_t> pipelines(passes.size());
+	for (uint32_t i = 0; i < pipelines.size(); ++i) {
+		pipelines[i] = (i / 7) % 3 == 0 ? 1 : 0;
+	}
+
+	DrawListRecorder recorder;
+	recorder.Partition(passes, pipelines);
+
+	std::vector<uint32_t> expected(passes.size());
+	for (uint32_t i = 0; i < expected.size(); ++i) {
+		expected[i] = i;
+	}
+	std::stable_sort(expected.begin(), expected.end(), [&passes](uint32_t a, uint32_t b) { return passes[a] < passes[b]; });
+
+	size_t position = 0;
+	for (const DrawListRecorder::DrawList& list : recorder.GetLists()) {
+		if (list.count == 0 || list.count > DrawListRecorder::kDefaultMaxDrawsPerList) {
+			return false;
+		}
+		for (uint32_t drawIndex : recorder.GetDrawIndices(list)) {
+			if (position >= expected.size() || expected[position++] != drawIndex || passes[drawIndex] != list.pass || pipelines[drawIndex] != list.pipeline) {
+				return false;
+			}
+		}
+	}
+	return position == expected.size();
+}
+
+} // namespace
+
+// 50000個の描画を種類ごとのリストに分けて並列に記録し、提出の順を確かめながら、1〜コア数のスレッドで伸び方を見る
+BENCHMARK(DrawLists) {
+
+	const std::vector<RenderPass> passes = MakePasses();
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	// 種類ごとに1本ずつのリストと、既定の数ずつに分けたリスト
+	const uint32_t listSizes[] = {kDrawCount, DrawListRecorder::kDefaultMaxDrawsPerList};
+	for (uint32_t maxDrawsPerList : listSizes) {
+		double baseline = 0.0;
+		for (uint32_t threads = 1; threads <= maxThreads; ++threads) {
+			jobSystem->Initialize(threads);
+
+			DrawListRecorder recorder;
+			recorder.SetMaxDrawsPerList(maxDrawsPerList);
+			SimulatedDrawListBackend backend;
+
+			// 記録先の容量を確保してから測る
+			recorder.Kick(passes, &backend);
+			recorder.Submit();
+
+			Benchmark::Timer timer;
+			for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+				Profiler::GetInstance()->BeginFrame();
+				MemoryTracker::GetInstance()->BeginFrame();
+
+				recorder.Kick(passes, &backend);
+				recorder.Wait();
+				recorder.Submit();
+			}
+			const double milliseconds = timer.GetMilliseconds();
+			const bool inOrder = IsSubmittedInOrder(passes, recorder, backend, maxDrawsPerList);
+			jobSystem->Finalize();
+
+			if (threads == 1) {
+				baseline = milliseconds;
+			}
+
+			char label[64];
+			std::snprintf(label, sizeof(label), "record %u draws, %u threads", kDrawCount, threads);
+			Benchmark::Report(label, kFrameCount, milliseconds);
+			std::printf("    -> %zu lists, %.3f ms/frame, x%.2f, order %s\n", recorder.GetLists().size(), milliseconds / kFrameCount, baseline / milliseconds, inOrder ? "ok" : "NG");
+		}
+	}
+
+	std::printf("    -> split by pipeline %s\n", IsSplitByPipeline(passes) ? "ok" : "NG");
+}
@@ -0,0 +1,128 @@
+#define NOMINMAX
+#include "Benchmark.h"
+#include "EnemyWalkBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+
+// 合成したステージの大きさ（MapChipField と同じく0行目が一番上）
+constexpr uint32_t kMapWidth = 4096;
+constexpr uint32_t kMapHeight = 20;
+constexpr uint32_t kWalkerCount = 100000;
+// 10秒分
+constexpr uint32_t kTickCount = 600;
+// 60Hz の1ティックの時間
+constexpr double kTickBudgetMilliseconds = 1000.0 / 60.0;
+
+using Walker = EnemyWalkBatch::Walker;
+using TileGrid = EnemyWalkBatch::TileGrid;
+
+/// <summary>
+/// 床と、ところどころに敵が折り返す柱のあるステージ
+/// </summary>
+TileGrid MakeStage() {
+
+	TileGrid tiles;
+	tiles.width = kMapWidth;
+	tiles.height = kMapHeight;
+	tiles.solid.assign(size_t(kMapWidth) * kMapHeight, 0);
+	for (uint32_t x = 0; x < kMapWidth; ++x) {
+		tiles.solid[size_t(kMapHeight - 1) * kMapWidth + x] = 1;
+		if (x % 23 == 0 || x == kMapWidth - 1) {
+			for (uint32_t y = kMapHeight - 4; y < kMapHeight - 1; ++y) {
+				tiles.solid[size_t(y) * kMapWidth + x] = 1;
+			}
+		}
+	}
+	return tiles;
+}
+
+/// <summary>
+/// 床の上に並べた敵（柱の中には置かない）
+/// </summary>
+std::vector<Walker> MakeWalkers() {
+
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> column(1.0f, kMapWidth - 3.0f);
+	std::uniform_real_distribution<float> timer(0.0f, EnemyWalkBatch::kWalkMotionTime);
+	std::uniform_int_distribution<uint32_t> direction(0, 1);
+
+	std::vector<Walker> walkers(kWalkerCount);
+	for (Walker& walker : walkers) {
+		do {
+			walker.x = column(random);
+		} while (std::fmod(walker.x, 23.0f) < 1.5f || std::fmod(walker.x, 23.0f) > 21.5f);
+		walker.y = 1.0f;
+		const bool right = direction(random) != 0;
+		walker.velocityX = right ? EnemyWalkBatch::kWalkSpeed : -EnemyWalkBatch::kWalkSpeed;
+		walker.rotationY = right ? -std::numbers::pi_v<float> * 2.0f : std::numbers::pi_v<float>;
+		walker.walkTimer = timer(random);
+	}
+	return walkers;
+}
+
+/// <summary>
+/// まとめて更新した結果が1体ずつの更新と同じか（向きの角度は sin の近似の分だけずれてよい）
+/// </summary>
+bool IsSameAsScalar(const std::vector<Walker>& expected, const EnemyWalkBatch& batch, float& maxPitchError) {
+
+	maxPitchError = 0.0f;
+	for (uint32_t i = 0; i < expected.size(); ++i) {
+		const Walker walker = batch.Get(i);
+		if (walker.x != expected[i].x || walker.velocityX != expected[i].velocityX || walker.rotationY != expected[i].rotationY) {
+			return false;
+		}
+		maxPitchError = std::max(maxPitchError, std::abs(walker.rotationX - expected[i].rotationX));
+	}
+	return maxPitchError < 1.0e-4f;
+}
+
+} // namespace
+
+// 100000体の歩く敵を1コアで、1体ずつの更新（EnemyWalkBatch::UpdateWalker）と SoA でまとめた更新で進めて比べる（近くの区画と、4ティックずつ進める遠くの区画）
+BENCHMARK(EnemyWalk) {
+
+	const TileGrid tiles = MakeStage();
+	const std::vector<Walker> initial = MakeWalkers();
+
+	const uint32_t tickSizes[] = {1, 4};
+	for (uint32_t ticks : tickSizes) {
+		const uint32_t updateCount = kTickCount / ticks;
+
+		std::vector<Walker> walkers = initial;
+		Benchmark::Timer scalarTimer;
+		for (uint32_t update = 0; update < updateCount; ++update) {
+			for (Walker& walker : walkers) {
+				EnemyWalkBatch::UpdateWalker(&tiles, walker, ticks);
+			}
+		}
+		const double scalarMilliseconds = scalarTimer.GetMilliseconds();
+
+		EnemyWalkBatch batch;
+		batch.SetTiles(&tiles);
+		for (const Walker& walker : initial) {
+			batch.Add(walker);
+		}
+		Benchmark::Timer batchTimer;
+		for (uint32_t update = 0; update < updateCount; ++update) {
+			batch.Update(ticks);
+		}
+		const double batchMilliseconds = batchTimer.GetMilliseconds();
+
+		float maxPitchError = 0.0f;
+		const bool same = IsSameAsScalar(walkers, batch, maxPitchError);
+
+		char label[64];
+		std::snprintf(label, sizeof(label), "scalar %u walkers, %u ticks", kWalkerCount, ticks);
+		Benchmark::Report(label, updateCount, scalarMilliseconds);
+		std::snprintf(label, sizeof(label), "batch %u walkers, %u ticks", kWalkerCount, ticks);
+		Benchmark::Report(label, updateCount, batchMilliseconds);
+
+		const double millisecondsPerUpdate = batchMilliseconds / updateCount;
+		std::printf("    -> %.3f ms/update (60Hz %s), x%.2f, match %s (pitch error %.2e)\n", millisecondsPerUpdate, millisecondsPerUpdate < kTickBudgetMilliseconds ? "ok" : "NG",
+		    scalarMilliseconds / batchMilliseconds, same ? "ok" : "NG", maxPitchError);
+	}
+}
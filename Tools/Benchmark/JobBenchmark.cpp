@@ -0,0 +1,301 @@
+#define NOMINMAX
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <thread>
+
+namespace {
+
+// 合成したゲームシーンの大きさ
+constexpr uint32_t kMapWidth = 2000;
+constexpr uint32_t kMapHeight = 20;
+constexpr uint32_t kEnemyCount = 10000;
+constexpr uint32_t kParticleCount = 20000;
+constexpr uint32_t kFrameCount = 200;
+
+// 1ジョブの要素数
+constexpr uint32_t kEnemiesPerJob = 256;
+constexpr uint32_t kRowsPerJob = 1;
+constexpr uint32_t kParticlesPerJob = 1024;
+
+// 敵の大きさと動き（Enemy と同じ値）
+constexpr float kBlockSize = 1.0f;
+constexpr float kWidth = 0.8f;
+constexpr float kHeight = 0.8f;
+constexpr float kEPS = 0.001f;
+constexpr float kWalkSpeed = 0.05f;
+constexpr float kWalkMotionTime = 1.0f;
+
+struct Vector3 {
+	float x, y, z;
+};
+
+struct Matrix4x4 {
+	float m[4][4];
+};
+
+/// <summary>
+/// WorldTransform の代わり（行列は定数バッファへの転送の代わりに別の配列へ書き出す）
+/// </summary>
+struct Transform {
+	Vector3 scale = {1.0f, 1.0f, 1.0f};
+	Vector3 rotation = {};
+	Vector3 translation = {};
+	Matrix4x4 matWorld = {};
+};
+
+struct Enemy {
+	Transform transform;
+	float velocityX = -kWalkSpeed;
+	float walkTimer = 0.0f;
+};
+
+struct Particle {
+	Transform transform;
+	Vector3 velocity = {};
+};
+
+// MakeAffineMatrix と同じ計算（スケール × X回転 × Y回転 × Z回転 × 平行移動）
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotation, const Vector3& translation) {
+
+	const float sx = std::sin(rotation.x), cx = std::cos(rotation.x);
+	const float sy = std::sin(rotation.y), cy = std::cos(rotation.y);
+	const float sz = std::sin(rotation.z), cz = std::cos(rotation.z);
+
+	Matrix4x4 result = {};
+	result.m[0][0] = scale.x * (cy * cz);
+	result.m[0][1] = scale.x * (cy * sz);
+	result.m[0][2] = scale.x * (-sy);
+	result.m[1][0] = scale.y * (sx * sy * cz - cx * sz);
+	result.m[1][1] = scale.y * (sx * sy * sz + cx * cz);
+	result.m[1][2] = scale.y * (sx * cy);
+	result.m[2][0] = scale.z * (cx * sy * cz + sx * sz);
+	result.m[2][1] = scale.z * (cx * sy * sz - sx * cz);
+	result.m[2][2] = scale.z * (cx * cy);
+	result.m[3][0] = translation.x;
+	result.m[3][1] = translation.y;
+	result.m[3][2] = translation.z;
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+/// <summary>
+/// ブロックの並んだ地形と、その上を歩く敵・ブロック・パーティクル
+/// </summary>
+class SyntheticScene {
+public:
+	SyntheticScene() {
+
+		std::mt19937 random(7);
+
+		// 床と天井、ところどころに敵が折り返す柱
+		tiles_.assign(size_t(kMapWidth) * kMapHeight, 0);
+		for (uint32_t x = 0; x < kMapWidth; ++x) {
+			tiles_[Index(x, 0)] = 1;
+			tiles_[Index(x, kMapHeight - 1)] = 1;
+			if (x % 23 == 0) {
+				for (uint32_t y = 1; y < 4; ++y) {
+					tiles_[Index(x, y)] = 1;
+				}
+			}
+		}
+
+		// ブロックの行列（GameScene と同じく行ごとに持つ）
+		blocks_.resize(kMapHeight);
+		for (uint32_t y = 0; y < kMapHeight; ++y) {
+			for (uint32_t x = 0; x < kMapWidth; ++x) {
+				if (tiles_[Index(x, y)]) {
+					Transform block;
+					block.translation = {x * kBlockSize, y * kBlockSize, 0.0f};
+					blocks_[y].push_back(block);
+				}
+			}
+		}
+
+		std::uniform_real_distribution<float> column(1.0f, kMapWidth - 2.0f);
+		std::uniform_real_distribution<float> timer(0.0f, kWalkMotionTime);
+		enemies_.resize(kEnemyCount);
+		for (Enemy& enemy : enemies_) {
+			enemy.transform.translation = {column(random), 1.5f, 0.0f};
+			enemy.transform.rotation.y = -std::numbers::pi_v<float>;
+			enemy.walkTimer = timer(random);
+		}
+
+		std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+		particles_.resize(kParticleCount);
+		for (Particle& particle : particles_) {
+			particle.transform.translation = {column(random), 5.0f, 0.0f};
+			particle.velocity = {direction(random) * 0.1f, direction(random) * 0.1f, 0.0f};
+		}
+	}
+
+	/// <summary>
+	/// 1フレーム分の更新（GameScene::Update の並列にできる部分）
+	/// </summary>
+	void Update(JobSystem* jobSystem) {
+
+		PROFILE_ZONE("SyntheticScene::Update");
+
+		{
+			PROFILE_ZONE("Enemies");
+			jobSystem->ParallelForEach(std::span<Enemy>(enemies_), kEnemiesPerJob, [this](Enemy& enemy) { UpdateEnemy(enemy); });
+		}
+
+		PROFILE_ZONE("Blocks and particles");
+		jobSystem->ParallelFor(kMapHeight, kRowsPerJob, [this](uint32_t begin, uint32_t end) {
+			for (uint32_t y = begin; y < end; ++y) {
+				for (Transform& block : blocks_[y]) {
+					UpdateTransform(block);
+				}
+			}
+		});
+
+		jobSystem->ParallelForEach(std::span<Particle>(particles_), kParticlesPerJob, [this](Particle& particle) {
+			particle.transform.translation.x += particle.velocity.x;
+			particle.transform.translation.y += particle.velocity.y;
+			particle.transform.rotation.z += 0.1f;
+			UpdateTransform(particle.transform);
+		});
+	}
+
+	/// <summary>
+	/// 結果が消されないように全体をまとめた値
+	/// </summary>
+	double GetChecksum() const {
+
+		double sum = 0.0;
+		for (const Enemy& enemy : enemies_) {
+			sum += enemy.transform.matWorld.m[3][0] + enemy.transform.matWorld.m[1][1];
+		}
+		for (const Particle& particle : particles_) {
+			sum += particle.transform.matWorld.m[0][0];
+		}
+		return sum;
+	}
+
+private:
+	size_t Index(uint32_t x, uint32_t y) const { return size_t(y) * kMapWidth + x; }
+
+	bool IsSolidAt(float x, float y) const {
+		const int32_t ix = static_cast<int32_t>(std::floor(x / kBlockSize + 0.5f));
+		const int32_t iy = static_cast<int32_t>(std::floor(y / kBlockSize + 0.5f));
+		if (ix < 0 || iy < 0 || ix >= static_cast<int32_t>(kMapWidth) || iy >= static_cast<int32_t>(kMapHeight)) {
+			return true;
+		}
+		return tiles_[Index(ix, iy)] != 0;
+	}
+
+	// Enemy::BehaviorWalkUpdate と同じ処理（胸と足の2点で壁を調べて折り返す）
+	void UpdateEnemy(Enemy& enemy) const {
+
+		Vector3& translation = enemy.transform.translation;
+		const float dir = enemy.velocityX > 0.0f ? 1.0f : -1.0f;
+		const float nextX = translation.x + enemy.velocityX;
+		const float probeX = nextX + dir * (kWidth * 0.5f + kEPS);
+
+		if (IsSolidAt(probeX, translation.y + kHeight * 0.25f) || IsSolidAt(probeX, translation.y - kHeight * 0.25f)) {
+			const float tile = std::floor(probeX / kBlockSize + 0.5f) * kBlockSize;
+			const float boundary = dir > 0.0f ? tile - kBlockSize * 0.5f : tile + kBlockSize * 0.5f;
+			translation.x = boundary - dir * (kWidth * 0.5f + kEPS);
+			enemy.velocityX = -enemy.velocityX;
+			enemy.transform.rotation.y = enemy.velocityX > 0.0f ? -std::numbers::pi_v<float> * 2.0f : std::numbers::pi_v<float>;
+		} else {
+			translation.x = nextX;
+		}
+
+		enemy.walkTimer += 1.0f / 60.0f;
+		const float param = std::sin(2.0f * std::numbers::pi_v<float> * enemy.walkTimer / kWalkMotionTime);
+		enemy.transform.rotation.x = (-10.0f + 20.0f * (param + 1.0f) / 2.0f) * (std::numbers::pi_v<float> / 180.0f);
+
+		UpdateTransform(enemy.transform);
+	}
+
+	static void UpdateTransform(Transform& transform) { transform.matWorld = MakeAffineMatrix(transform.scale, transform.rotation, transform.translation); }
+
+	std::vector<uint8_t> tiles_;
+	std::vector<std::vector<Transform>> blocks_;
+	std::vector<Enemy> enemies_;
+	std::vector<Particle> particles_;
+};
+
+/// <summary>
+/// 1つのカウンターを、前に積んだジョブが終わりかけている間に使い回す
+/// 数え直しと後続の待ちを閉じるのが前後すると、後続が早く走るか閉じた印をジョブとして積んで落ちる
+/// </summary>
+bool CheckCounterReuse(JobSystem* jobSystem) {
+
+	constexpr uint32_t kRoundCount = 20000;
+	constexpr uint32_t kJobsPerRound = 8;
+
+	JobCounter counter;
+	JobCounter dependentCounter;
+	std::atomic<uint32_t> finishedCount = 0;
+	std::atomic<uint32_t> earlyCount = 0;
+
+	for (uint32_t round = 0; round < kRoundCount; ++round) {
+		for (uint32_t i = 0; i < kJobsPerRound; ++i) {
+			jobSystem->Run([&finishedCount]() { finishedCount.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			// ワーカーが先に終えてカウンターが0に戻るよう、積む間を空ける
+			std::this_thread::yield();
+		}
+
+		// 後続はこの周回までに積んだジョブが全て終わってから走る
+		const uint32_t expected = (round + 1) * kJobsPerRound;
+		jobSystem->Run([&finishedCount, &earlyCount, expected]() {
+			if (finishedCount.load(std::memory_order_relaxed) < expected) {
+				earlyCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}, &dependentCounter, &counter);
+	}
+	jobSystem->Wait(&counter);
+	jobSystem->Wait(&dependentCounter);
+
+	return earlyCount == 0 && finishedCount == kRoundCount * kJobsPerRound;
+}
+
+} // namespace
+
+// 10000体の敵がいる合成シーンの更新を、1〜コア数のスレッドで回して伸び方を見る
+BENCHMARK(JobScaling) {
+
+	const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	double baseline = 0.0;
+	for (uint32_t threads = 1; threads <= maxThreads; ++threads) {
+		jobSystem->Initialize(threads);
+
+		// 同じ初期状態から回す
+		SyntheticScene scene;
+		scene.Update(jobSystem);
+
+		Benchmark::Timer timer;
+		for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+			Profiler::GetInstance()->BeginFrame();
+			MemoryTracker::GetInstance()->BeginFrame();
+			scene.Update(jobSystem);
+		}
+		const double milliseconds = timer.GetMilliseconds();
+		jobSystem->Finalize();
+
+		if (threads == 1) {
+			baseline = milliseconds;
+		}
+
+		char label[64];
+		std::snprintf(label, sizeof(label), "update %u enemies, %u threads", kEnemyCount, threads);
+		Benchmark::Report(label, kFrameCount, milliseconds);
+		std::printf("    -> %.3f ms/frame, x%.2f (checksum %.1f)\n", milliseconds / kFrameCount, baseline / milliseconds, scene.GetChecksum());
+	}
+
+	// 取り合いが起きるよう、コアが少なくてもワーカーは4つ以上にする
+	jobSystem->Initialize(std::max(4u, maxThreads));
+	const bool reuse = CheckCounterReuse(jobSystem);
+	jobSystem->Finalize();
+	std::printf("    -> counter reuse %s\n", reuse ? "ok" : "NG");
+}
@@ -0,0 +1,106 @@
+#include "AudioMixer.h"
+#include "Benchmark.h"
+#include "ImaAdpcm.h"
+#include <cmath>
+#include <random>
+
+namespace {
+
+// ミックスする長さ（出力のフレーム数）
+constexpr uint32_t kOutputRate = 48000;
+constexpr uint32_t kRenderFrames = kOutputRate * 2;
+constexpr uint32_t kBlockFrames = 512;
+
+AudioMixer::Sound MakeTone(uint32_t sampleRate, uint32_t channels, float frequency) {
+	AudioMixer::Sound sound;
+	sound.sampleRate = sampleRate;
+	sound.channels = channels;
+	sound.frameCount = sampleRate;
+	sound.samples.resize(size_t(sound.frameCount) * channels);
+	for (uint32_t i = 0; i < sound.frameCount; ++i) {
+		for (uint32_t channel = 0; channel < channels; ++channel) {
+			sound.samples[i * channels + channel] = 0.25f * std::sin(6.2831853f * frequency * static_cast<float>(i) / static_cast<float>(sampleRate));
+		}
+	}
+	return sound;
+}
+
+// サウンドバンクと同じく IMA-ADPCM のまま鳴らす音にする（blocks が持ち主）
+AudioMixer::Sound MakeAdpcm(const AudioMixer::Sound& source, std::vector<uint8_t>& blocks) {
+	AudioMixer::Sound sound;
+	sound.sampleRate = source.sampleRate;
+	sound.channels = source.channels;
+	sound.frameCount = source.frameCount;
+	sound.encoding = AudioMixer::Encoding::kImaAdpcm;
+	sound.blockAlign = ImaAdpcm::GetDefaultBlockAlign(source.channels);
+	blocks = ImaAdpcm::Encode(source.samples.data(), source.frameCount, source.channels, sound.blockAlign);
+	sound.blocks = blocks.data();
+	return sound;
+}
+
+void RenderVoices(const char* label, const AudioMixer::Sound& sound, uint32_t voiceCount, bool randomPitch) {
+
+	AudioMixer mixer(kOutputRate);
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> pitch(0.5f, 2.0f);
+	for (uint32_t i = 0; i < voiceCount; ++i) {
+		mixer.Play(&sound, 1.0f / static_cast<float>(voiceCount), randomPitch ? pitch(random) : 1.0f, true);
+	}
+
+	NullAudioSink sink;
+	Benchmark::Timer timer;
+	mixer.Render(&sink, kRenderFrames, kBlockFrames);
+	double milliseconds = timer.GetMilliseconds();
+
+	// 1ms の処理時間で何ボイス分の1msの音を作れるか
+	double audioMilliseconds = 1000.0 * kRenderFrames / kOutputRate;
+	Benchmark::Report(label, size_t(voiceCount) * kRenderFrames, milliseconds);
+	std::printf("    -> %.1f voice-ms per ms (peak %.3f)\n", voiceCount * audioMilliseconds / milliseconds, sink.GetPeak());
+}
+
+void PlayAndStop(const AudioMixer::Sound& sound) {
+
+	constexpr uint32_t kCount = 100000;
+	// ミックス1回の間に積む組の数（枠が尽きず、再生と停止の2つずつでも操作のキューに収まる数）
+	constexpr uint32_t kBatch = AudioMixer::kMaxVoices;
+	static_assert(kBatch * 2 <= AudioMixer::kCommandCapacity);
+
+	AudioMixer mixer(kOutputRate);
+	uint32_t failed = 0;
+
+	Benchmark::Timer timer;
+	for (uint32_t i = 0; i < kCount; i += kBatch) {
+		for (uint32_t j = 0; j < kBatch; ++j) {
+			uint32_t voice = mixer.Play(&sound);
+			failed += voice == AudioMixer::kInvalidVoice;
+			mixer.Stop(voice);
+		}
+		// 0フレームのミックスで溜まった操作だけ反映する
+		mixer.Mix(nullptr, 0);
+	}
+	Benchmark::Report("play + stop (queued, drained per batch)", kCount, timer.GetMilliseconds());
+
+	// 全て止めて操作も反映したら、StreamingAudio はミキサーのブロックを積むのをやめる
+	std::printf("    -> %u failed, idle after stop %s\n", failed, mixer.IsIdle() ? "ok" : "NG");
+}
+
+} // namespace
+
+BENCHMARK(MixerVoices) {
+
+	AudioMixer::Sound mono44 = MakeTone(44100, 1, 440.0f);
+	AudioMixer::Sound stereo44 = MakeTone(44100, 2, 440.0f);
+	AudioMixer::Sound mono48 = MakeTone(kOutputRate, 1, 440.0f);
+
+	RenderVoices("mono 48k, pitch 1 (no resample)", mono48, AudioMixer::kMaxVoices, false);
+	RenderVoices("mono 44.1k, random pitch", mono44, AudioMixer::kMaxVoices, true);
+	RenderVoices("stereo 44.1k, random pitch", stereo44, AudioMixer::kMaxVoices, true);
+
+	// ミックスの時に復号する分の重さ
+	std::vector<uint8_t> blocks;
+	AudioMixer::Sound adpcm44 = MakeAdpcm(stereo44, blocks);
+	RenderVoices("stereo 44.1k ADPCM, random pitch", adpcm44, AudioMixer::kMaxVoices, true);
+	std::printf("    -> %zu bytes (16bit PCM %zu bytes)\n", blocks.size(), stereo44.samples.size() * sizeof(int16_t));
+
+	PlayAndStop(mono44);
+}
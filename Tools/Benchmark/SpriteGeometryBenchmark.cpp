@@ -0,0 +1,142 @@
+#define NOMINMAX
+#include "Benchmark.h"
+#include "SpriteGeometry.h"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kQuadCount = 8192;
+constexpr uint32_t kRepeatCount = 200;
+// 座標の許容誤差（画素、回転の sin/cos と掛け算の順番の違いの分）
+constexpr float kPositionTolerance = 1.0e-3f;
+
+using Vertex = SpriteGeometry::Vertex;
+using Quad = SpriteGeometry::Quad;
+
+/// <summary>
+/// 1頂点ずつ計算した期待値（左上・右上・左下・右下）
+/// </summary>
+void ExpectVertices(const Quad& quad, Vertex out[4]) {
+
+	const float cornerX[4] = {0.0f, 1.0f, 0.0f, 1.0f};
+	const float cornerY[4] = {0.0f, 0.0f, 1.0f, 1.0f};
+	const float cosine = std::cos(quad.rotation);
+	const float sine = std::sin(quad.rotation);
+
+	for (int corner = 0; corner < 4; ++corner) {
+		const float localX = (cornerX[corner] - quad.anchor.x) * quad.size.x;
+		const float localY = (cornerY[corner] - quad.anchor.y) * quad.size.y;
+		out[corner].pos = {quad.position.x + localX * cosine - localY * sine, quad.position.y + localX * sine + localY * cosine};
+		out[corner].uv = {cornerX[corner] == 0.0f ? quad.uvMin.x : quad.uvMax.x, cornerY[corner] == 0.0f ? quad.uvMin.y : quad.uvMax.y};
+		out[corner].color = quad.color;
+	}
+}
+
+/// <summary>
+/// 頂点が期待値と同じか
+/// </summary>
+bool IsSame(const Vertex& actual, const Vertex& expected, float& maxPositionError) {
+
+	const float error = std::max(std::abs(actual.pos.x - expected.pos.x), std::abs(actual.pos.y - expected.pos.y));
+	maxPositionError = std::max(maxPositionError, error);
+	return error <= kPositionTolerance && std::abs(actual.uv.x - expected.uv.x) <= 1.0e-6f && std::abs(actual.uv.y - expected.uv.y) <= 1.0e-6f &&
+	       actual.color == expected.color;
+}
+
+/// <summary>
+/// 手で確かめられる形の矩形（角の順番とアンカー、回転、uvの向き）
+/// </summary>
+bool CheckKnownQuads() {
+
+	bool ok = true;
+	uint32_t order = 0;
+	Vertex vertices[4];
+
+	// 左上アンカー、回転なし: (10,20) から 30x40
+	Quad quad;
+	quad.position = {10.0f, 20.0f};
+	quad.size = {30.0f, 40.0f};
+	quad.anchor = {0.0f, 0.0f};
+	quad.uvMin = {0.25f, 0.5f};
+	quad.uvMax = {0.75f, 1.0f};
+	quad.color = 0x11223344;
+	SpriteGeometry::GenerateVertices(&quad, &order, 1, vertices);
+	ok &= vertices[0].pos.x == 10.0f && vertices[0].pos.y == 20.0f;
+	ok &= vertices[1].pos.x == 40.0f && vertices[1].pos.y == 20.0f;
+	ok &= vertices[2].pos.x == 10.0f && vertices[2].pos.y == 60.0f;
+	ok &= vertices[3].pos.x == 40.0f && vertices[3].pos.y == 60.0f;
+	ok &= vertices[0].uv.x == 0.25f && vertices[0].uv.y == 0.5f && vertices[3].uv.x == 0.75f && vertices[3].uv.y == 1.0f;
+	ok &= vertices[1].uv.x == 0.75f && vertices[1].uv.y == 0.5f && vertices[2].uv.x == 0.25f && vertices[2].uv.y == 1.0f;
+	ok &= vertices[0].color == 0x11223344 && vertices[3].color == 0x11223344;
+
+	// 中央アンカーで90度回転: 右上の角 (+w/2, -h/2) は (+h/2, +w/2) へ
+	quad.position = {100.0f, 100.0f};
+	quad.size = {20.0f, 10.0f};
+	quad.anchor = {0.5f, 0.5f};
+	quad.rotation = std::numbers::pi_v<float> * 0.5f;
+	SpriteGeometry::GenerateVertices(&quad, &order, 1, vertices);
+	ok &= std::abs(vertices[1].pos.x - 105.0f) < kPositionTolerance && std::abs(vertices[1].pos.y - 110.0f) < kPositionTolerance;
+	ok &= std::abs(vertices[2].pos.x - 95.0f) < kPositionTolerance && std::abs(vertices[2].pos.y - 90.0f) < kPositionTolerance;
+
+	// 反転（uvMin > uvMax）はuvがそのまま入れ替わる
+	quad.rotation = 0.0f;
+	quad.uvMin = {1.0f, 0.0f};
+	quad.uvMax = {0.0f, 1.0f};
+	SpriteGeometry::GenerateVertices(&quad, &order, 1, vertices);
+	ok &= vertices[0].uv.x == 1.0f && vertices[1].uv.x == 0.0f && vertices[2].uv.x == 1.0f && vertices[3].uv.x == 0.0f;
+
+	return ok;
+}
+
+} // namespace
+
+// SpriteBatch の頂点生成を1頂点ずつの計算と比べ、1フレーム分（8192矩形）の生成時間を測る
+BENCHMARK(SpriteGeometry) {
+
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> position(0.0f, 1280.0f);
+	std::uniform_real_distribution<float> size(1.0f, 256.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::uniform_real_distribution<float> angle(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
+
+	std::vector<Quad> quads(kQuadCount);
+	for (Quad& quad : quads) {
+		quad.position = {position(random), position(random)};
+		quad.size = {size(random), size(random)};
+		quad.anchor = {unit(random), unit(random)};
+		quad.uvMin = {unit(random), unit(random)};
+		quad.uvMax = {unit(random), unit(random)};
+		quad.rotation = angle(random);
+		quad.color = static_cast<uint32_t>(random());
+	}
+
+	// 描画順に並べ替えた後の添え字と同じく、飛び飛びの順番で引く
+	std::vector<uint32_t> order(kQuadCount);
+	for (uint32_t i = 0; i < kQuadCount; ++i) {
+		order[i] = (i * 7919) % kQuadCount;
+	}
+
+	std::vector<Vertex> vertices(size_t(kQuadCount) * 4);
+	Benchmark::Timer timer;
+	for (uint32_t repeat = 0; repeat < kRepeatCount; ++repeat) {
+		SpriteGeometry::GenerateVertices(quads.data(), order.data(), quads.size(), vertices.data());
+	}
+	const double milliseconds = timer.GetMilliseconds();
+
+	bool same = true;
+	float maxPositionError = 0.0f;
+	Vertex expected[4];
+	for (uint32_t i = 0; i < kQuadCount; ++i) {
+		ExpectVertices(quads[order[i]], expected);
+		for (int corner = 0; corner < 4; ++corner) {
+			same &= IsSame(vertices[size_t(i) * 4 + corner], expected[corner], maxPositionError);
+		}
+	}
+	const bool known = CheckKnownQuads();
+
+	Benchmark::Report("generate 8192 quads", kRepeatCount, milliseconds);
+	std::printf("    -> match %s (position error %.2e), known quads %s\n", same ? "ok" : "NG", maxPositionError, known ? "ok" : "NG");
+}
@@ -0,0 +1,59 @@
+#include "TextureSlotTable.h"
+#include <cassert>
+
+TextureSlotTable::TextureSlotTable(uint32_t maxPageCount) : allocator_(maxPageCount) { paths_.resize(allocator_.GetCapacity()); }
+
+uint32_t TextureSlotTable::Find(std::string_view path) const {
+
+	auto it = slots_.find(path);
+	if (it == slots_.end()) {
+		return kInvalidSlot;
+	}
+	return it->second;
+}
+
+std::pair<uint32_t, bool> TextureSlotTable::Insert(std::string_view path) {
+
+	auto it = slots_.find(path);
+	if (it != slots_.end()) {
+		return {it->second, false};
+	}
+
+	uint32_t slot = allocator_.Allocate();
+	if (slot == kInvalidSlot) {
+		return {kInvalidSlot, false};
+	}
+
+	// ページが増えていたら番号 → パスの表も伸ばす
+	if (paths_.size() < allocator_.GetCapacity()) {
+		paths_.resize(allocator_.GetCapacity());
+	}
+
+	auto [inserted, _] = slots_.emplace(std::string(path), slot);
+	paths_[slot] = inserted->first;
+	return {slot, true};
+}
+
+void TextureSlotTable::Erase(uint32_t slot) {
+
+	assert(allocator_.IsAllocated(slot));
+
+	slots_.erase(paths_[slot]);
+	paths_[slot].clear();
+	allocator_.Free(slot);
+}
+
+const std::string& TextureSlotTable::GetPath(uint32_t slot) const {
+
+	assert(slot < paths_.size());
+	return paths_[slot];
+}
+
+void TextureSlotTable::Clear() {
+
+	slots_.clear();
+	for (std::string& path : paths_) {
+		path.clear();
+	}
+	allocator_.Reset();
+}
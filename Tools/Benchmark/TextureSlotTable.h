@@ -0,0 +1,75 @@
+#pragma once
+#include "DescriptorAllocator.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// テクスチャのパス → ディスクリプタ番号の表
+/// 同じパスの読み込みはハッシュで O(1) に重複排除し、番号は DescriptorAllocator から取る
+/// （TextureManager の「名前を先頭から比較して探す＋ビット列を先頭から走査する」表の置き換え）
+/// TextureManager はエンジンのライブラリの中にあって表を差し替えられないので、ゲームには組み込まず、
+/// ベンチマークの中に置いて元の表と比べるためだけに使う
+/// </summary>
+class TextureSlotTable {
+public:
+	// 無効な番号
+	static constexpr uint32_t kInvalidSlot = DescriptorAllocator::kInvalidSlot;
+
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="maxPageCount">ページ数の上限（1ページ DescriptorAllocator::kPageSize 個）</param>
+	explicit TextureSlotTable(uint32_t maxPageCount = 64);
+
+	/// <summary>
+	/// パスから番号を探す
+	/// </summary>
+	/// <returns>番号（無ければkInvalidSlot）</returns>
+	uint32_t Find(std::string_view path) const;
+
+	/// <summary>
+	/// パスを登録する（登録済みなら同じ番号を返す）
+	/// </summary>
+	/// <returns>番号と新しく確保したかどうか（上限なら番号はkInvalidSlot）</returns>
+	std::pair<uint32_t, bool> Insert(std::string_view path);
+
+	/// <summary>
+	/// 番号を解放する
+	/// </summary>
+	void Erase(uint32_t slot);
+
+	/// <summary>
+	/// 番号のパス（未使用なら空）
+	/// </summary>
+	const std::string& GetPath(uint32_t slot) const;
+
+	/// <summary>
+	/// 全て解放する
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 登録数
+	/// </summary>
+	uint32_t GetCount() const { return allocator_.GetAllocatedCount(); }
+
+	/// <summary>
+	/// 番号の数（ページが増えると増える）
+	/// </summary>
+	uint32_t GetCapacity() const { return allocator_.GetCapacity(); }
+
+private:
+	// string_view のままで引けるようにする
+	struct PathHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view path) const { return std::hash<std::string_view>{}(path); }
+	};
+
+	DescriptorAllocator allocator_;
+	std::unordered_map<std::string, uint32_t, PathHash, std::equal_to<>> slots_;
+	// 番号 → パス
+	std::vector<std::string> paths_;
+};
@@ -0,0 +1,123 @@
+#define NOMINMAX
+#include "Benchmark.h"
+#include "VertexQuantization.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+// 読み込むモデルで一番多い頂点数（title の最適化後ではなく最適化前の数）
+constexpr uint32_t kVertexCount = 13836;
+constexpr uint32_t kRepeatCount = 100;
+
+using Vertex = VertexQuantization::Vertex;
+
+/// <summary>
+/// 単位ベクトルにする
+/// </summary>
+KamataEngine::Vector3 Normalize(float x, float y, float z) {
+	float length = std::sqrt(x * x + y * y + z * z);
+	return {x / length, y / length, z / length};
+}
+
+/// <summary>
+/// 量子化して、誤差が上限に収まっているか
+/// </summary>
+bool IsWithinBound(const std::vector<Vertex>& vertices, VertexQuantization::Error& error) {
+
+	VertexQuantization::CompactMesh mesh = VertexQuantization::Quantize(vertices);
+	VertexQuantization::Error bound = VertexQuantization::GetErrorBound(mesh.params);
+	error = VertexQuantization::Measure(vertices, mesh);
+	return mesh.vertices.size() == vertices.size() && error.position <= bound.position && error.normalDegrees <= bound.normalDegrees && error.uv <= bound.uv &&
+	       VertexQuantization::Validate(vertices, mesh);
+}
+
+/// <summary>
+/// 手で確かめられる形（軸方向の法線・AABBの角・平らなメッシュ・範囲外のuv）
+/// </summary>
+bool CheckKnownVertices() {
+
+	bool ok = true;
+
+	// 軸方向の法線は誤差なく戻る（八面体の頂点と折り返しの境目）
+	const KamataEngine::Vector3 axes[] = {
+	    {1.0f,  0.0f,  0.0f },
+	    {-1.0f, 0.0f,  0.0f },
+	    {0.0f,  1.0f,  0.0f },
+	    {0.0f,  -1.0f, 0.0f },
+	    {0.0f,  0.0f,  1.0f },
+	    {0.0f,  0.0f,  -1.0f},
+	};
+	for (const KamataEngine::Vector3& axis : axes) {
+		int16_t encoded[2];
+		VertexQuantization::EncodeOctahedral(axis, encoded);
+		KamataEngine::Vector3 decoded = VertexQuantization::DecodeOctahedral(encoded);
+		ok &= std::abs(decoded.x - axis.x) < 1.0e-6f && std::abs(decoded.y - axis.y) < 1.0e-6f && std::abs(decoded.z - axis.z) < 1.0e-6f;
+	}
+
+	// AABBの最小点と最大点はそのまま戻る
+	std::vector<Vertex> vertices(2);
+	vertices[0] = {{-3.0f, 0.5f, 10.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}};
+	vertices[1] = {{5.0f, 2.5f, 12.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}};
+	VertexQuantization::CompactMesh mesh = VertexQuantization::Quantize(vertices);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		Vertex decoded = VertexQuantization::Decode(mesh.vertices[i], mesh.params);
+		ok &= decoded.pos.x == vertices[i].pos.x && decoded.pos.y == vertices[i].pos.y && decoded.pos.z == vertices[i].pos.z;
+		ok &= decoded.uv.x == vertices[i].uv.x && decoded.uv.y == vertices[i].uv.y;
+	}
+
+	// 平らなメッシュ（AABBの大きさが0の軸がある）と繰り返しのuv
+	vertices = {
+	    {{0.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {-2.0f, 0.0f}},
+	    {{4.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {3.0f, 0.0f} },
+	    {{0.0f, 1.0f, 4.0f}, {0.0f, 1.0f, 0.0f}, {-2.0f, 5.0f}},
+	};
+	VertexQuantization::Error error;
+	ok &= IsWithinBound(vertices, error);
+	ok &= error.position == 0.0f;
+
+	return ok;
+}
+
+} // namespace
+
+// OptimizedModel が GPU に送る量子化頂点を元の頂点と比べ、誤差が上限に収まるかと量子化の時間を測る
+BENCHMARK(VertexQuantization) {
+
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> texcoord(0.0f, 1.0f);
+
+	std::vector<Vertex> vertices(kVertexCount);
+	for (Vertex& vertex : vertices) {
+		vertex.pos = {position(random), position(random), position(random)};
+		float x = 0.0f;
+		float y = 0.0f;
+		float z = 0.0f;
+		do {
+			x = direction(random);
+			y = direction(random);
+			z = direction(random);
+		} while (x * x + y * y + z * z < 1.0e-4f);
+		vertex.normal = Normalize(x, y, z);
+		vertex.uv = {texcoord(random), texcoord(random)};
+	}
+
+	Benchmark::Timer timer;
+	size_t compactBytes = 0;
+	for (uint32_t repeat = 0; repeat < kRepeatCount; ++repeat) {
+		VertexQuantization::CompactMesh mesh = VertexQuantization::Quantize(vertices);
+		compactBytes = sizeof(VertexQuantization::CompactVertex) * mesh.vertices.size();
+	}
+	const double milliseconds = timer.GetMilliseconds();
+
+	VertexQuantization::Error error;
+	const bool within = IsWithinBound(vertices, error);
+	const bool known = CheckKnownVertices();
+
+	Benchmark::Report("quantize 13836 vertices", kRepeatCount, milliseconds);
+	std::printf("    -> %zu -> %zu bytes, error pos %.2e normal %.4fdeg uv %.2e\n", sizeof(Vertex) * vertices.size(), compactBytes, error.position, error.normalDegrees, error.uv);
+	std::printf("    -> within bound %s, known vertices %s\n", within ? "ok" : "NG", known ? "ok" : "NG");
+}
@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include <cstring>
+#include <string>
+
+// 使い方: Benchmark [--trace ファイル] [--memory] [名前...]
+// 名前を省略すると全て実行する
+// --trace を付けると、計測した区間を終了時に Chrome のトレース形式で書き出す
+// --memory を付けると、各ベンチマークの後にタグごとのメモリ使用量を出す
+int main(int argc, char* argv[]) {
+
+	const std::vector<Benchmark::Entry>& entries = Benchmark::GetEntries();
+
+	if (argc > 1 && (std::strcmp(argv[1], "--list") == 0)) {
+		for (const Benchmark::Entry& entry : entries) {
+			std::printf("%s\n", entry.name);
+		}
+		return 0;
+	}
+
+	std::string tracePath;
+	bool memoryReport = false;
+	std::vector<const char*> names;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			tracePath = argv[++i];
+		} else if (std::strcmp(argv[i], "--memory") == 0) {
+			memoryReport = true;
+		} else {
+			names.push_back(argv[i]);
+		}
+	}
+	Profiler::GetInstance()->SetThreadName("Main");
+
+	int runCount = 0;
+	for (const Benchmark::Entry& entry : entries) {
+		bool selected = names.empty();
+		for (size_t i = 0; i < names.size() && !selected; ++i) {
+			selected = std::strcmp(names[i], entry.name) == 0;
+		}
+		if (!selected) {
+			continue;
+		}
+
+		std::printf("[%s]\n", entry.name);
+		entry.function();
+		++runCount;
+
+		if (memoryReport) {
+			MemoryTracker::GetInstance()->PrintReport(stdout);
+		}
+	}
+
+	if (runCount == 0) {
+		std::fprintf(stderr, "no benchmark matched (use --list)\n");
+		return 1;
+	}
+
+	if (!tracePath.empty() && !Profiler::GetInstance()->WriteChromeTrace(tracePath)) {
+		std::fprintf(stderr, "failed to write %s\n", tracePath.c_str());
+		return 1;
+	}
+	return 0;
+}
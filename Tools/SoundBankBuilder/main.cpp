@@ -0,0 +1,163 @@
+#include "AudioMixer.h"
+#include "SoundBank.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/// <summary>
+/// コマンドライン引数
+/// </summary>
+struct Options {
+	fs::path root = "Resources"; // 走査するディレクトリ
+	fs::path output;             // 出力先（空なら root/sfx.sbnk）
+	bool recursive = false;      // サブディレクトリも含める（BGMは sounds/ に置いてストリーミングするので既定では含めない）
+	bool force = false;          // 更新日時に関係なく作り直す
+};
+
+void PrintUsage() {
+	std::printf(
+	    "usage: SoundBankBuilder [root] [--output file] [--recursive] [--force]\n"
+	    "  Packs every .wav directly under root (default: Resources) into one IMA-ADPCM sound bank\n"
+	    "  (default: root/sfx.sbnk). Sounds are named by their path relative to root.\n");
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+
+	for (int i = 1; i < argc; ++i) {
+		const char* argument = argv[i];
+		const bool hasValue = i + 1 < argc;
+
+		if (std::strcmp(argument, "--output") == 0 && hasValue) {
+			options.output = argv[++i];
+		} else if (std::strcmp(argument, "--recursive") == 0) {
+			options.recursive = true;
+		} else if (std::strcmp(argument, "--force") == 0) {
+			options.force = true;
+		} else if (argument[0] != '-') {
+			options.root = argument;
+		} else {
+			return false;
+		}
+	}
+	if (options.output.empty()) {
+		options.output = options.root / "sfx.sbnk";
+	}
+	return true;
+}
+
+// 拡張子を小文字で取得
+std::string GetExtension(const fs::path& path) {
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return extension;
+}
+
+// 出力が全ての元ファイルより新しければ作り直さない
+bool IsUpToDate(const std::vector<fs::path>& sources, const fs::path& output) {
+	std::error_code error;
+	fs::file_time_type outputTime = fs::last_write_time(output, error);
+	if (error) {
+		return false;
+	}
+	for (const fs::path& source : sources) {
+		if (fs::last_write_time(source, error) > outputTime || error) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return 1;
+	}
+
+	std::error_code error;
+	if (!fs::is_directory(options.root, error)) {
+		std::fprintf(stderr, "SoundBankBuilder: %s is not a directory\n", options.root.string().c_str());
+		return 1;
+	}
+
+	// 対象ファイルを集める（名前で並べて、毎回同じ並びのバンクにする）
+	std::vector<fs::path> paths;
+	auto collect = [&](const fs::directory_entry& entry) {
+		if (entry.is_regular_file() && GetExtension(entry.path()) == ".wav") {
+			paths.push_back(entry.path());
+		}
+	};
+	if (options.recursive) {
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(options.root, error)) {
+			collect(entry);
+		}
+	} else {
+		for (const fs::directory_entry& entry : fs::directory_iterator(options.root, error)) {
+			collect(entry);
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+
+	if (paths.empty()) {
+		std::fprintf(stderr, "SoundBankBuilder: no .wav files under %s\n", options.root.string().c_str());
+		return 1;
+	}
+	if (!options.force && IsUpToDate(paths, options.output)) {
+		std::printf("SoundBankBuilder: %s is up to date\n", options.output.string().c_str());
+		return 0;
+	}
+
+	// 読み込んで float に揃える
+	std::vector<AudioMixer::Sound> sounds(paths.size());
+	std::vector<SoundBank::Source> sources;
+	size_t pcmBytes = 0;
+	size_t failedCount = 0;
+	for (size_t i = 0; i < paths.size(); ++i) {
+		if (!AudioMixer::LoadWave(paths[i].string(), sounds[i])) {
+			++failedCount;
+			std::fprintf(stderr, "  FAILED %s: unsupported wave format\n", paths[i].string().c_str());
+			continue;
+		}
+
+		SoundBank::Source source;
+		source.name = paths[i].lexically_relative(options.root).generic_string();
+		source.sound = &sounds[i];
+		sources.push_back(source);
+
+		// Audio::SoundData と同じく 16bit PCM で持った場合の大きさ
+		const size_t bytes = size_t(sounds[i].frameCount) * sounds[i].channels * sizeof(int16_t);
+		pcmBytes += bytes;
+		std::printf(
+		    "  %s: %u Hz, %u ch, %u frames, %.1f KB\n", source.name.c_str(), sounds[i].sampleRate, sounds[i].channels, sounds[i].frameCount, bytes / 1024.0);
+	}
+
+	if (!SoundBank::Write(options.output.string(), sources)) {
+		std::fprintf(stderr, "SoundBankBuilder: failed to write %s\n", options.output.string().c_str());
+		return 1;
+	}
+
+	// 書いたものを読み直して確かめる
+	SoundBank bank;
+	if (!bank.Load(options.output.string()) || bank.GetSoundCount() != sources.size()) {
+		std::fprintf(stderr, "SoundBankBuilder: %s could not be read back\n", options.output.string().c_str());
+		return 1;
+	}
+
+	std::printf(
+	    "SoundBankBuilder: packed %zu sounds, failed %zu -> %s\n  sound memory: %.2f MB (16bit PCM) -> %.2f MB (bank), %.1fx smaller\n", sources.size(), failedCount,
+	    options.output.string().c_str(), pcmBytes / (1024.0 * 1024.0), bank.GetMemorySize() / (1024.0 * 1024.0),
+	    static_cast<double>(pcmBytes) / static_cast<double>(bank.GetMemorySize()));
+
+	return failedCount > 0 ? 1 : 0;
+}
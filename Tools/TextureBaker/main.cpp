@@ -0,0 +1,407 @@
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <DirectXTex.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// ゲームが書き出すテクスチャアトラスのディレクトリ（TextureAtlas::kDirectoryPath と同じ、root からの相対パス）
+// ページは余白2画素で画像を詰めているので、4x4ブロックの圧縮やミップで隣の画像が混ざる。焼かずに元のPNGのまま読ませる
+constexpr const char* kAtlasDirectoryName = "atlas";
+
+/// <summary>
+/// 圧縮形式の指定
+/// </summary>
+enum class FormatMode {
+	kAuto, // 不透明ならBC1、半透明ならBC3
+	kBC1,
+	kBC3,
+	kBC7,
+};
+
+/// <summary>
+/// コマンドライン引数
+/// </summary>
+struct Options {
+	fs::path root = "Resources";      // 走査するディレクトリ
+	FormatMode format = FormatMode::kAuto;
+	size_t maxSize = 0;                // 長辺の上限（0なら縮小しない）
+	unsigned int jobs = 0;             // 同時に処理するファイル数（0ならコア数）
+	bool force = false;                // 更新日時に関係なく焼き直す
+	bool srgb = true;                  // sRGB形式で出力する（エンジンは色テクスチャをsRGBとして扱う）
+	bool parallelCompress = false;     // 画像内もブロック単位で並列に圧縮する（ファイル数がコア数より少ない時）
+};
+
+/// <summary>
+/// 1ファイル分の結果
+/// </summary>
+struct Result {
+	bool baked = false;
+	size_t sourceBytes = 0; // RGBA8・ミップ無しで置いた場合の大きさ
+	size_t bakedBytes = 0;  // 出力したDDSの画素データの大きさ
+};
+
+void PrintUsage() {
+	std::printf(
+	    "usage: TextureBaker [root] [--format auto|bc1|bc3|bc7] [--max-size N] [--jobs N] [--force] [--linear]\n"
+	    "  Bakes every png/jpg/bmp/tga under root (default: Resources) into a .dds next to it,\n"
+	    "  with a full mip chain and block compression. Up-to-date outputs are skipped.\n");
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+
+	for (int i = 1; i < argc; ++i) {
+		const char* argument = argv[i];
+		const bool hasValue = i + 1 < argc;
+
+		if (std::strcmp(argument, "--format") == 0 && hasValue) {
+			const char* value = argv[++i];
+			if (std::strcmp(value, "auto") == 0) {
+				options.format = FormatMode::kAuto;
+			} else if (std::strcmp(value, "bc1") == 0) {
+				options.format = FormatMode::kBC1;
+			} else if (std::strcmp(value, "bc3") == 0) {
+				options.format = FormatMode::kBC3;
+			} else if (std::strcmp(value, "bc7") == 0) {
+				options.format = FormatMode::kBC7;
+			} else {
+				return false;
+			}
+		} else if (std::strcmp(argument, "--max-size") == 0 && hasValue) {
+			options.maxSize = std::strtoul(argv[++i], nullptr, 10);
+		} else if (std::strcmp(argument, "--jobs") == 0 && hasValue) {
+			options.jobs = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (std::strcmp(argument, "--force") == 0) {
+			options.force = true;
+		} else if (std::strcmp(argument, "--linear") == 0) {
+			options.srgb = false;
+		} else if (argument[0] != '-') {
+			options.root = argument;
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+
+// 拡張子を小文字で取得
+std::string GetExtension(const fs::path& path) {
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return extension;
+}
+
+// 焼き込み対象の画像か
+bool IsSourceImage(const fs::path& path) {
+	std::string extension = GetExtension(path);
+#ifdef _WIN32
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") {
+		return true;
+	}
+#endif
+	// WICの無い環境ではDirectXTex自身のローダーで読めるものだけ
+	return extension == ".tga";
+}
+
+// 出力先（元画像と同じ場所で拡張子だけ .dds）
+fs::path MakeOutputPath(const fs::path& source) {
+	fs::path output = source;
+	output.replace_extension(".dds");
+	return output;
+}
+
+// 出力が元画像より新しければ焼き直さない
+bool IsUpToDate(const fs::path& source, const fs::path& output) {
+	std::error_code error;
+	fs::file_time_type outputTime = fs::last_write_time(output, error);
+	if (error) {
+		return false;
+	}
+	return fs::last_write_time(source, error) <= outputTime && !error;
+}
+
+// 縮小後の大きさ（ブロック圧縮のため4の倍数に揃える）
+void CalculateBakedSize(size_t width, size_t height, size_t maxSize, size_t& bakedWidth, size_t& bakedHeight) {
+
+	bakedWidth = width;
+	bakedHeight = height;
+
+	if (maxSize > 0 && std::max(width, height) > maxSize) {
+		const double scale = static_cast<double>(maxSize) / static_cast<double>(std::max(width, height));
+		bakedWidth = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(width) * scale + 0.5));
+		bakedHeight = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(height) * scale + 0.5));
+	}
+
+	bakedWidth = (bakedWidth + 3) & ~size_t(3);
+	bakedHeight = (bakedHeight + 3) & ~size_t(3);
+}
+
+DXGI_FORMAT ChooseFormat(FormatMode mode, bool opaque) {
+	switch (mode) {
+	case FormatMode::kBC1:
+		return DXGI_FORMAT_BC1_UNORM;
+	case FormatMode::kBC3:
+		return DXGI_FORMAT_BC3_UNORM;
+	case FormatMode::kBC7:
+		return DXGI_FORMAT_BC7_UNORM;
+	case FormatMode::kAuto:
+	default:
+		return opaque ? DXGI_FORMAT_BC1_UNORM : DXGI_FORMAT_BC3_UNORM;
+	}
+}
+
+const char* GetFormatName(DXGI_FORMAT format) {
+	switch (format) {
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+		return "BC1";
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+		return "BC3";
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return "BC7";
+	default:
+		return "?";
+	}
+}
+
+// 画素データの合計バイト数
+size_t GetPixelBytes(const DirectX::ScratchImage& image) {
+	size_t bytes = 0;
+	for (size_t i = 0; i < image.GetImageCount(); ++i) {
+		bytes += image.GetImages()[i].slicePitch;
+	}
+	return bytes;
+}
+
+/// <summary>
+/// 1ファイルを焼き込む
+/// 読み込み → RGBA8 → 縮小/4の倍数化 → ミップマップ生成 → ブロック圧縮 → DDS保存
+/// </summary>
+HRESULT Bake(const fs::path& source, const fs::path& output, const Options& options, Result& result, std::string& message) {
+
+	using namespace DirectX;
+
+	// 読み込み（sRGBの扱いはオプションで決めるので、ファイルのメタデータは無視する）
+	ScratchImage loaded;
+	HRESULT hr = E_FAIL;
+	if (GetExtension(source) == ".tga") {
+		hr = LoadFromTGAFile(source.wstring().c_str(), TGA_FLAGS_IGNORE_SRGB, nullptr, loaded);
+	}
+#ifdef _WIN32
+	else {
+		hr = LoadFromWICFile(source.wstring().c_str(), WIC_FLAGS_IGNORE_SRGB, nullptr, loaded);
+	}
+#endif
+	if (FAILED(hr)) {
+		message = "load failed";
+		return hr;
+	}
+
+	// RGBA8に揃える
+	ScratchImage rgba;
+	if (loaded.GetMetadata().format == DXGI_FORMAT_R8G8B8A8_UNORM) {
+		rgba = std::move(loaded);
+	} else {
+		hr = Convert(*loaded.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, TEX_FILTER_DEFAULT, TEX_THRESHOLD_DEFAULT, rgba);
+		if (FAILED(hr)) {
+			message = "convert failed";
+			return hr;
+		}
+	}
+
+	const TexMetadata sourceMetadata = rgba.GetMetadata();
+	result.sourceBytes = sourceMetadata.width * sourceMetadata.height * 4;
+
+	// 形式はsRGBのまま扱い、縮小やミップマップ生成をガンマを考慮して行う
+	if (options.srgb) {
+		rgba.OverrideFormat(MakeSRGB(DXGI_FORMAT_R8G8B8A8_UNORM));
+	}
+
+	// アルファを見て形式を決める（縮小前に調べる）
+	DXGI_FORMAT format = ChooseFormat(options.format, rgba.IsAlphaAllOpaque());
+	if (options.srgb) {
+		format = MakeSRGB(format);
+	}
+
+	// 縮小と4の倍数化
+	size_t width = 0;
+	size_t height = 0;
+	CalculateBakedSize(sourceMetadata.width, sourceMetadata.height, options.maxSize, width, height);
+
+	ScratchImage resized;
+	if (width != sourceMetadata.width || height != sourceMetadata.height) {
+		hr = Resize(*rgba.GetImage(0, 0, 0), width, height, TEX_FILTER_CUBIC | TEX_FILTER_FORCE_NON_WIC, resized);
+		if (FAILED(hr)) {
+			message = "resize failed";
+			return hr;
+		}
+	} else {
+		resized = std::move(rgba);
+	}
+
+	// ミップマップ（1x1まで）
+	ScratchImage mipChain;
+	hr = GenerateMipMaps(*resized.GetImage(0, 0, 0), TEX_FILTER_DEFAULT | TEX_FILTER_FORCE_NON_WIC, 0, mipChain);
+	if (FAILED(hr)) {
+		message = "mipmap generation failed";
+		return hr;
+	}
+
+	// ブロック圧縮
+	ScratchImage compressed;
+	const TEX_COMPRESS_FLAGS compressFlags = options.parallelCompress ? TEX_COMPRESS_PARALLEL : TEX_COMPRESS_DEFAULT;
+	hr = Compress(mipChain.GetImages(), mipChain.GetImageCount(), mipChain.GetMetadata(), format, compressFlags, TEX_THRESHOLD_DEFAULT, compressed);
+	if (FAILED(hr)) {
+		message = "compress failed";
+		return hr;
+	}
+
+	hr = SaveToDDSFile(compressed.GetImages(), compressed.GetImageCount(), compressed.GetMetadata(), DDS_FLAGS_NONE, output.wstring().c_str());
+	if (FAILED(hr)) {
+		message = "save failed";
+		return hr;
+	}
+
+	result.baked = true;
+	result.bakedBytes = GetPixelBytes(compressed);
+
+	char buffer[128];
+	std::snprintf(
+	    buffer, sizeof(buffer), "%zux%zu -> %zux%zu %s, %zu mips", sourceMetadata.width, sourceMetadata.height, width, height, GetFormatName(format),
+	    compressed.GetMetadata().mipLevels);
+	message = buffer;
+	return S_OK;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return 1;
+	}
+
+	std::error_code error;
+	if (!fs::is_directory(options.root, error)) {
+		std::fprintf(stderr, "TextureBaker: %s is not a directory\n", options.root.string().c_str());
+		return 1;
+	}
+
+	// 対象ファイルを集める（焼き直し不要なものは除く）
+	std::vector<fs::path> sources;
+	size_t skippedCount = 0;
+	const fs::path atlasDirectory = options.root / kAtlasDirectoryName;
+	for (fs::recursive_directory_iterator it(options.root, error), end; it != end; it.increment(error)) {
+		const fs::directory_entry& entry = *it;
+		if (entry.path() == atlasDirectory) {
+			it.disable_recursion_pending();
+			continue;
+		}
+		if (!entry.is_regular_file() || !IsSourceImage(entry.path())) {
+			continue;
+		}
+		if (!options.force && IsUpToDate(entry.path(), MakeOutputPath(entry.path()))) {
+			++skippedCount;
+			continue;
+		}
+		sources.push_back(entry.path());
+	}
+
+	// 大きい画像から処理して、最後に1枚だけ残って待つ時間を減らす
+	std::sort(sources.begin(), sources.end(), [](const fs::path& a, const fs::path& b) {
+		std::error_code sizeError;
+		return fs::file_size(a, sizeError) > fs::file_size(b, sizeError);
+	});
+
+	// ファイル単位で並列に処理し、ファイル数がコア数に満たない分は画像内の並列圧縮で埋める
+	const unsigned int coreCount = std::max(1u, std::thread::hardware_concurrency());
+	unsigned int jobCount = options.jobs > 0 ? options.jobs : coreCount;
+	jobCount = std::min(jobCount, static_cast<unsigned int>(std::max<size_t>(1, sources.size())));
+	options.parallelCompress = jobCount < coreCount;
+
+	std::vector<Result> results(sources.size());
+	std::atomic<size_t> nextIndex = 0;
+	std::atomic<size_t> failedCount = 0;
+	std::mutex printMutex;
+
+	const auto startTime = std::chrono::steady_clock::now();
+
+	// ファイル単位でワーカースレッドに割り振る
+	auto worker = [&]() {
+#ifdef _WIN32
+		// WICはスレッドごとにCOMの初期化が必要
+		HRESULT coResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+		for (size_t index = nextIndex++; index < sources.size(); index = nextIndex++) {
+			const fs::path& source = sources[index];
+			std::string message;
+			HRESULT hr = Bake(source, MakeOutputPath(source), options, results[index], message);
+
+			std::scoped_lock lock(printMutex);
+			if (FAILED(hr)) {
+				++failedCount;
+				std::fprintf(stderr, "  FAILED %s: %s (0x%08X)\n", source.string().c_str(), message.c_str(), static_cast<unsigned int>(hr));
+			} else {
+				std::printf("  %s: %s\n", source.string().c_str(), message.c_str());
+			}
+		}
+
+#ifdef _WIN32
+		if (SUCCEEDED(coResult)) {
+			CoUninitialize();
+		}
+#endif
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned int i = 0; i < jobCount; ++i) {
+		threads.emplace_back(worker);
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	size_t sourceBytes = 0;
+	size_t bakedBytes = 0;
+	size_t bakedCount = 0;
+	for (const Result& result : results) {
+		if (result.baked) {
+			sourceBytes += result.sourceBytes;
+			bakedBytes += result.bakedBytes;
+			++bakedCount;
+		}
+	}
+
+	std::printf(
+	    "TextureBaker: baked %zu, skipped %zu (up to date), failed %zu in %.2fs on %u threads\n", bakedCount, skippedCount, failedCount.load(), seconds, jobCount);
+	if (bakedBytes > 0) {
+		std::printf(
+		    "  texture memory: %.2f MB (RGBA8, no mips) -> %.2f MB (block compressed, full mips), %.1fx smaller\n", sourceBytes / (1024.0 * 1024.0), bakedBytes / (1024.0 * 1024.0),
+		    static_cast<double>(sourceBytes) / static_cast<double>(bakedBytes));
+	}
+
+	return failedCount > 0 ? 1 : 0;
+}